@@ -56,6 +56,8 @@ symbol_c::symbol_c(
   this->last_line    = last_line;
   this->last_column  = last_column;
   this->last_order   = last_order;
+  this->kind          = kind_symbol_c;
+  this->type_category = 0;
   this->datatype     = NULL;
   this->const_value._real64.status   = cs_undefined;
   this->const_value._int64.status    = cs_undefined;
@@ -69,6 +71,7 @@ token_c::token_c(const char *value,
                  int fl, int fc, const char *ffile, long int forder,
                  int ll, int lc, const char *lfile, long int lorder)
   :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {
+  this->kind  = kind_token_c;
   this->value = value;
 //  printf("New token: %s\n", value);
 }
@@ -83,6 +86,7 @@ list_c::list_c(
                int fl, int fc, const char *ffile, long int forder,
                int ll, int lc, const char *lfile, long int lorder)
   :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder),c(LIST_CAP_INIT) {
+  kind = kind_list_c;
   n = 0;
   elements = (symbol_c**)malloc(LIST_CAP_INIT*sizeof(symbol_c*));
   if (NULL == elements) ERROR_MSG("out of memory");
@@ -93,6 +97,7 @@ list_c::list_c(symbol_c *elem,
                int fl, int fc, const char *ffile, long int forder,
                int ll, int lc, const char *lfile, long int lorder)
   :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder),c(LIST_CAP_INIT) { 
+  kind = kind_list_c;
   n = 0;
   elements = (symbol_c**)malloc(LIST_CAP_INIT*sizeof(symbol_c*));
   if (NULL == elements) ERROR_MSG("out of memory");
@@ -166,29 +171,43 @@ void list_c::remove_element(int pos) {
   /* elements = (symbol_c **)realloc(elements, n * sizeof(symbol_c *)); */
 }
 
+
+/* initialise the symbol_c::kind and symbol_c::type_category of an object of class 'class_name_c' */
+#define SET_KIND(class_name_c)									\
+  this->kind          = kind_##class_name_c;							\
+  this->type_category = symbol_type_category_c<class_name_c>::value;
+
 #define SYM_LIST(class_name_c, ...)								\
 class_name_c::class_name_c(									\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
-                        :list_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {}		\
+                        :list_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
+}											\
 class_name_c::class_name_c(symbol_c *elem, 							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
-			:list_c(elem, fl, fc, ffile, forder, ll, lc, lfile, lorder) {}		\
+			:list_c(elem, fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
+}											\
 void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
 
 #define SYM_TOKEN(class_name_c, ...)								\
 class_name_c::class_name_c(const char *value, 							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
-			:token_c(value, fl, fc, ffile, forder, ll, lc, lfile, lorder) {}	\
+			:token_c(value, fl, fc, ffile, forder, ll, lc, lfile, lorder) {	\
+  SET_KIND(class_name_c);									\
+}											\
 void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
 
 #define SYM_REF0(class_name_c, ...)								\
 class_name_c::class_name_c(									\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
-			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {}		\
+			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
+}											\
 void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
 
 
@@ -197,6 +216,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
   this->ref1 = ref1;										\
 }												\
 void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
@@ -208,6 +228,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
   this->ref1 = ref1;										\
   this->ref2 = ref2;										\
 }												\
@@ -221,6 +242,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
   this->ref1 = ref1;										\
   this->ref2 = ref2;										\
   this->ref3 = ref3;										\
@@ -236,6 +258,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
   this->ref1 = ref1;										\
   this->ref2 = ref2;										\
   this->ref3 = ref3;										\
@@ -253,6 +276,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
   this->ref1 = ref1;										\
   this->ref2 = ref2;										\
   this->ref3 = ref3;										\
@@ -273,6 +297,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {		\
+  SET_KIND(class_name_c);									\
   this->ref1 = ref1;										\
   this->ref2 = ref2;										\
   this->ref3 = ref3;										\
@@ -299,6 +324,7 @@ void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
 #undef SYM_REF4
 #undef SYM_REF5
 #undef SYM_REF6
+#undef SET_KIND
 
 
 
@@ -70,6 +70,76 @@ class symbol_c; // forward declaration
 
 
 
+/* The kind of a symbol, i.e. the class of the object in the abstract syntax tree.
+ * There is one kind_xxx_c value for each xxx_c class declared in absyntax.def.
+ *
+ * Every symbol carries its kind in symbol_c::kind, so testing for the class of
+ * an object (i.e. symbol->kind == kind_bool_type_name_c) is a simple integer
+ * comparison, much cheaper than doing the same with typeid() or dynamic_cast<>.
+ */
+#define SYM_LIST(class_name_c, ...)                                                       kind_##class_name_c,
+#define SYM_TOKEN(class_name_c, ...)                                                      kind_##class_name_c,
+#define SYM_REF0(class_name_c, ...)                                                       kind_##class_name_c,
+#define SYM_REF1(class_name_c, ref1, ...)                                                 kind_##class_name_c,
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                           kind_##class_name_c,
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                                     kind_##class_name_c,
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                               kind_##class_name_c,
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)                         kind_##class_name_c,
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)                   kind_##class_name_c,
+
+typedef enum {
+  kind_symbol_c,  /* only the base classes are not declared in absyntax.def */
+  kind_token_c,
+  kind_list_c,
+  #include "absyntax.def"
+  symbol_kind_count
+} symbol_kind_t;
+
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+
+
+
+/* The categories of data types defined in IEC 61131-3 (ANY_INT, ANY_REAL, ...), plus
+ * those of the PLCopen safety extensions (ANY_SAFEINT, ANY_SAFEREAL, ...).
+ *
+ * Each elementary data type belongs to a single one of the tc_xxx categories below
+ * (e.g. int_type_name_c is tc_signed_INT, safeint_type_name_c is tc_signed_SAFEINT),
+ * and the generic data types (ANY_NUM, ANY_BIT, ...) are the union of some of these.
+ * The symbol_c::type_category of every object is set by the constructor, (see the
+ * symbol_type_category_c<> template below), so checking whether a symbol is (e.g.)
+ * an ANY_NUM data type becomes a single mask test.
+ */
+typedef enum {
+  tc_signed_INT        = 0x00000001,
+  tc_signed_SAFEINT    = 0x00000002,
+  tc_unsigned_INT      = 0x00000004,
+  tc_unsigned_SAFEINT  = 0x00000008,
+  tc_REAL              = 0x00000010,
+  tc_SAFEREAL          = 0x00000020,
+  tc_nBIT              = 0x00000040,
+  tc_SAFEnBIT          = 0x00000080,
+  tc_BOOL              = 0x00000100,
+  tc_SAFEBOOL          = 0x00000200,
+  tc_TIME              = 0x00000400,
+  tc_SAFETIME          = 0x00000800,
+  tc_DATE              = 0x00001000,
+  tc_SAFEDATE          = 0x00002000,
+  tc_STRING            = 0x00004000,
+  tc_SAFESTRING        = 0x00008000,
+  /* not really data types, but the literals whose data type has not yet been determined */
+  tc_INT_literal       = 0x00010000,
+  tc_REAL_literal      = 0x00020000
+} type_category_t;
+
+
 
 
 
@@ -106,6 +176,14 @@ class symbol_c {
     /* WARNING: only use this method for debugging purposes!! */
     virtual const char *absyntax_cname(void) {return "symbol_c";};
 
+    /*
+     * The class of this object, and the data type categories it belongs to (a
+     * bitmask of type_category_t values, or 0 if not an elementary data type).
+     * Both set by the constructor.
+     */
+    uint16_t kind;          /* a symbol_kind_t */
+    uint32_t type_category; /* a bitmask of type_category_t */
+
     /*
      * Line number for the purposes of error checking.
      * Annotated (inserted) by stage1_2
@@ -417,4 +495,75 @@ class class_name_c: public symbol_c {											\
 #undef SYM_REF5
 #undef SYM_REF6
 
+
+
+
+/* The data type categories (type_category_t) of each class of symbol.
+ * Used by the constructors to initialise symbol_c::type_category.
+ */
+template <class symbol_class_c> struct symbol_type_category_c {static const uint32_t value = 0;};
+
+#define TYPE_CATEGORY(class_name_c, category) \
+template <> struct symbol_type_category_c<class_name_c> {static const uint32_t value = category;};
+
+/***********************************/
+/* B 1.3.1 - Elementary Data Types */
+/***********************************/
+TYPE_CATEGORY(sint_type_name_c,        tc_signed_INT)
+TYPE_CATEGORY(int_type_name_c,         tc_signed_INT)
+TYPE_CATEGORY(dint_type_name_c,        tc_signed_INT)
+TYPE_CATEGORY(lint_type_name_c,        tc_signed_INT)
+TYPE_CATEGORY(usint_type_name_c,       tc_unsigned_INT)
+TYPE_CATEGORY(uint_type_name_c,        tc_unsigned_INT)
+TYPE_CATEGORY(udint_type_name_c,       tc_unsigned_INT)
+TYPE_CATEGORY(ulint_type_name_c,       tc_unsigned_INT)
+TYPE_CATEGORY(real_type_name_c,        tc_REAL)
+TYPE_CATEGORY(lreal_type_name_c,       tc_REAL)
+TYPE_CATEGORY(byte_type_name_c,        tc_nBIT)
+TYPE_CATEGORY(word_type_name_c,        tc_nBIT)
+TYPE_CATEGORY(dword_type_name_c,       tc_nBIT)
+TYPE_CATEGORY(lword_type_name_c,       tc_nBIT)
+TYPE_CATEGORY(bool_type_name_c,        tc_BOOL)
+TYPE_CATEGORY(time_type_name_c,        tc_TIME)
+TYPE_CATEGORY(date_type_name_c,        tc_DATE)
+TYPE_CATEGORY(tod_type_name_c,         tc_DATE)
+TYPE_CATEGORY(dt_type_name_c,          tc_DATE)
+TYPE_CATEGORY(string_type_name_c,      tc_STRING)
+TYPE_CATEGORY(wstring_type_name_c,     tc_STRING)
+
+TYPE_CATEGORY(safesint_type_name_c,    tc_signed_SAFEINT)
+TYPE_CATEGORY(safeint_type_name_c,     tc_signed_SAFEINT)
+TYPE_CATEGORY(safedint_type_name_c,    tc_signed_SAFEINT)
+TYPE_CATEGORY(safelint_type_name_c,    tc_signed_SAFEINT)
+TYPE_CATEGORY(safeusint_type_name_c,   tc_unsigned_SAFEINT)
+TYPE_CATEGORY(safeuint_type_name_c,    tc_unsigned_SAFEINT)
+TYPE_CATEGORY(safeudint_type_name_c,   tc_unsigned_SAFEINT)
+TYPE_CATEGORY(safeulint_type_name_c,   tc_unsigned_SAFEINT)
+TYPE_CATEGORY(safereal_type_name_c,    tc_SAFEREAL)
+TYPE_CATEGORY(safelreal_type_name_c,   tc_SAFEREAL)
+TYPE_CATEGORY(safebyte_type_name_c,    tc_SAFEnBIT)
+TYPE_CATEGORY(safeword_type_name_c,    tc_SAFEnBIT)
+TYPE_CATEGORY(safedword_type_name_c,   tc_SAFEnBIT)
+TYPE_CATEGORY(safelword_type_name_c,   tc_SAFEnBIT)
+TYPE_CATEGORY(safebool_type_name_c,    tc_SAFEBOOL)
+TYPE_CATEGORY(safetime_type_name_c,    tc_SAFETIME)
+TYPE_CATEGORY(safedate_type_name_c,    tc_SAFEDATE)
+TYPE_CATEGORY(safetod_type_name_c,     tc_SAFEDATE)
+TYPE_CATEGORY(safedt_type_name_c,      tc_SAFEDATE)
+TYPE_CATEGORY(safestring_type_name_c,  tc_SAFESTRING)
+TYPE_CATEGORY(safewstring_type_name_c, tc_SAFESTRING)
+
+/******************************/
+/* B 1.2.1 - Numeric Literals */
+/******************************/
+TYPE_CATEGORY(integer_c,               tc_INT_literal)
+TYPE_CATEGORY(neg_integer_c,           tc_INT_literal)
+TYPE_CATEGORY(binary_integer_c,        tc_INT_literal)
+TYPE_CATEGORY(octal_integer_c,         tc_INT_literal)
+TYPE_CATEGORY(hex_integer_c,           tc_INT_literal)
+TYPE_CATEGORY(real_c,                  tc_REAL_literal)
+TYPE_CATEGORY(neg_real_c,              tc_REAL_literal)
+
+#undef TYPE_CATEGORY
+
 #endif /*  _ABSYNTAX_HH */
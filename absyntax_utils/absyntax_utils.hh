@@ -99,9 +99,11 @@ extern symtable_c<symbol_c *, &null_symbol4> type_symtable;
 #include "add_en_eno_param_decl.hh"
 #include "get_sizeof_datatype.hh"
 #include "search_il_label.hh"
+#include "search_assigned_variables.hh"
 #include "get_var_name.hh"
 #include "get_datatype_info.hh"
 #include "debug_ast.hh"
+#include "build_cache.hh"
 
 /***********************************************************************/
 /***********************************************************************/
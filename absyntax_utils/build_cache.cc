@@ -0,0 +1,500 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Build cache, used for incremental compilation.
+ *  See build_cache.hh for a description of how it works.
+ */
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <set>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include "build_cache.hh"
+
+
+
+build_cache_c *build_cache = NULL;
+
+
+
+/************************************************/
+/* A 64 bit FNV-1a hash of an abstract syntax tree */
+/************************************************/
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME        1099511628211ULL
+
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t len) {
+  const unsigned char *p = (const unsigned char *)data;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= p[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+static uint64_t hash_int   (uint64_t hash, uint64_t value)       {return hash_bytes(hash, &value, sizeof(value));}
+static uint64_t hash_string(uint64_t hash, const std::string &s) {return hash_bytes(hash_int(hash, s.size()), s.data(), s.size());}
+
+static std::string hash_to_string(uint64_t hash) {
+  char buf[17];
+  snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)hash);
+  return buf;
+}
+
+
+
+/* Hashes the structure of the abstract syntax tree (the kind of each node, and
+ * the value of each token), ignoring the location of each symbol in the source code.
+ *
+ * While at it, collect the value of every token (identifiers, ...), which
+ * are later used to find the data types and POUs the tree references.
+ * (collecting a few tokens that are not references does no harm, it
+ *  merely makes the hash a little more conservative).
+ */
+typedef std::set<std::string, nocasecmp_c> name_set_t;
+
+#define NULL_MARKER 0xFFFFFFFFFFFFFFFFULL
+#define END_MARKER  0xFFFFFFFFFFFFFFFEULL
+
+class hash_ast_c: public visitor_c {
+  public:
+    uint64_t   hash;
+    name_set_t names;
+    bool       has_external; /* VAR_EXTERNAL declarations were found */
+
+  public:
+    hash_ast_c(void) {hash = FNV_OFFSET_BASIS; has_external = false;}
+    virtual ~hash_ast_c(void) {}
+
+    uint64_t get_hash(symbol_c *symbol) {
+      hash = FNV_OFFSET_BASIS;
+      names.clear();
+      has_external = false;
+      if (NULL != symbol) symbol->accept(*this);
+      return hash;
+    }
+
+  private:
+    void hash_ref(symbol_c *ref) {
+      if (NULL == ref) hash = hash_int(hash, NULL_MARKER);
+      else             ref->accept(*this);
+    }
+
+    void *hash_list(list_c *list) {
+      hash = hash_int(hash, list->kind);
+      hash = hash_int(hash, list->n);
+      for (int i = 0; i < list->n; i++) hash_ref(list->elements[i]);
+      hash = hash_int(hash, END_MARKER);
+      return NULL;
+    }
+
+    void *hash_token(token_c *token) {
+      hash = hash_int(hash, token->kind);
+      if (NULL == token->value) {hash = hash_int(hash, NULL_MARKER); return NULL;}
+      hash = hash_string(hash, token->value);
+      names.insert(token->value);
+      return NULL;
+    }
+
+  public:
+#define SYM_LIST(class_name_c, ...)                                             void *visit(class_name_c *symbol);
+#define SYM_TOKEN(class_name_c, ...)                                            void *visit(class_name_c *symbol);
+#define SYM_REF0(class_name_c, ...)                                             void *visit(class_name_c *symbol);
+#define SYM_REF1(class_name_c, ref1, ...)                                       void *visit(class_name_c *symbol);
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 void *visit(class_name_c *symbol);
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           void *visit(class_name_c *symbol);
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     void *visit(class_name_c *symbol);
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               void *visit(class_name_c *symbol);
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         void *visit(class_name_c *symbol);
+
+#include "../absyntax/absyntax.def"
+
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+}; // hash_ast_c
+
+
+
+#define REF_BEGIN(class_name_c)                                                 \
+void *hash_ast_c::visit(class_name_c *symbol) {                                 \
+  hash = hash_int(hash, symbol->kind);                                          \
+  if (kind_external_var_declarations_c == symbol->kind) has_external = true;
+
+#define REF_END                                                                 \
+  hash = hash_int(hash, END_MARKER);                                            \
+  return NULL;                                                                  \
+}
+
+#define SYM_LIST(class_name_c, ...)                                             void *hash_ast_c::visit(class_name_c *symbol) {return hash_list(symbol);}
+#define SYM_TOKEN(class_name_c, ...)                                            void *hash_ast_c::visit(class_name_c *symbol) {return hash_token(symbol);}
+#define SYM_REF0(class_name_c, ...)                                             REF_BEGIN(class_name_c) REF_END
+#define SYM_REF1(class_name_c, ref1, ...)                                       REF_BEGIN(class_name_c) hash_ref(symbol->ref1); REF_END
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 REF_BEGIN(class_name_c) hash_ref(symbol->ref1); hash_ref(symbol->ref2); REF_END
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           REF_BEGIN(class_name_c) hash_ref(symbol->ref1); hash_ref(symbol->ref2); hash_ref(symbol->ref3); REF_END
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     REF_BEGIN(class_name_c) hash_ref(symbol->ref1); hash_ref(symbol->ref2); hash_ref(symbol->ref3); hash_ref(symbol->ref4); REF_END
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               REF_BEGIN(class_name_c) hash_ref(symbol->ref1); hash_ref(symbol->ref2); hash_ref(symbol->ref3); hash_ref(symbol->ref4); hash_ref(symbol->ref5); REF_END
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         REF_BEGIN(class_name_c) hash_ref(symbol->ref1); hash_ref(symbol->ref2); hash_ref(symbol->ref3); hash_ref(symbol->ref4); hash_ref(symbol->ref5); hash_ref(symbol->ref6); REF_END
+
+#include "../absyntax/absyntax.def"
+
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+
+#undef REF_BEGIN
+#undef REF_END
+
+
+
+
+/* Collects the names of the values of an enumerated data type, so POUs that
+ * use these values (without the type name prefix) depend on the enumerated data type.
+ */
+class collect_enumerated_values_c: public iterator_visitor_c {
+  private:
+    name_set_t &values;
+
+  public:
+    collect_enumerated_values_c(name_set_t &values_): values(values_) {}
+    virtual ~collect_enumerated_values_c(void) {}
+
+    void *visit(enumerated_value_c *symbol) {
+      token_c *value = dynamic_cast<token_c *>(symbol->value);
+      if (NULL != value) values.insert(value->value);
+      return NULL;
+    }
+}; // collect_enumerated_values_c
+
+
+
+
+/**************************************************/
+/* The dependency graph of the library elements   */
+/**************************************************/
+
+/* A named element of the library (a data type or a POU) */
+typedef struct {
+  symbol_c  *symbol;
+  uint64_t   own_hash;     /* hash of the element itself */
+  name_set_t references;   /* names of (possibly) referenced elements */
+  bool       has_external;
+  int        state;        /* 0: full hash not yet computed; 1: being computed; 2: computed */
+  uint64_t   full_hash;    /* hash of the element, and all elements it references */
+} element_t;
+
+
+class dependency_graph_c {
+  private:
+    std::vector<element_t> elements;
+    std::map<std::string, std::vector<int>, nocasecmp_c> by_name;
+    uint64_t configurations_hash;
+    uint64_t salt_hash;
+    hash_ast_c hasher;
+
+  public:
+    dependency_graph_c(symbol_c *tree_root, const std::string &salt) {
+      salt_hash           = hash_string(FNV_OFFSET_BASIS, salt);
+      configurations_hash = FNV_OFFSET_BASIS;
+
+      list_c *library = dynamic_cast<list_c *>(tree_root);
+      if (NULL == library) ERROR;
+
+      for (int i = 0; i < library->n; i++) {
+        symbol_c *element = library->elements[i];
+        switch (element->kind) {
+          case kind_function_declaration_c:
+            add_element(element, ((function_declaration_c       *)element)->derived_function_name);
+            break;
+          case kind_function_block_declaration_c:
+            add_element(element, ((function_block_declaration_c *)element)->fblock_name);
+            break;
+          case kind_program_declaration_c:
+            add_element(element, ((program_declaration_c        *)element)->program_type_name);
+            break;
+          case kind_data_type_declaration_c: {
+            list_c *type_list = dynamic_cast<list_c *>(((data_type_declaration_c *)element)->type_declaration_list);
+            if (NULL == type_list) ERROR;
+            for (int j = 0; j < type_list->n; j++)
+              add_type(type_list->elements[j]);
+            break;
+          }
+          case kind_configuration_declaration_c:
+            configurations_hash = hash_int(configurations_hash, hasher.get_hash(element));
+            break;
+          default:
+            /* pragmas, ... do not change the code generated for the POUs */
+            break;
+        }
+      }
+    }
+
+    /* Returns the hash of a POU, or the empty string if the symbol is not a library element. */
+    std::string get_hash(symbol_c *symbol) {
+      for (unsigned int i = 0; i < elements.size(); i++)
+        if (elements[i].symbol == symbol) return hash_to_string(full_hash(i));
+      return "";
+    }
+
+  private:
+    void add_element(symbol_c *symbol, symbol_c *name) {
+      element_t element;
+      element.symbol       = symbol;
+      element.own_hash     = hasher.get_hash(symbol);
+      element.references   = hasher.names;
+      element.has_external = hasher.has_external;
+      element.state        = 0;
+      element.full_hash    = 0;
+      elements.push_back(element);
+      add_name(name);
+    }
+
+    void add_name(symbol_c *name) {
+      token_c *token = dynamic_cast<token_c *>(name);
+      if ((NULL != token) && (NULL != token->value))
+        by_name[token->value].push_back(elements.size() - 1);
+    }
+
+    void add_type(symbol_c *type_decl) {
+      add_element(type_decl, get_datatype_info_c::get_id(type_decl));
+      if (kind_enumerated_type_declaration_c == type_decl->kind) {
+        name_set_t values;
+        collect_enumerated_values_c collector(values);
+        type_decl->accept(collector);
+        for (name_set_t::iterator v = values.begin(); v != values.end(); v++)
+          by_name[*v].push_back(elements.size() - 1);
+      }
+    }
+
+    /* Note that recursive references (which are not legal IEC 61131-3 anyway) are simply
+     * ignored when the element that started the recursion is found a second time.
+     */
+    uint64_t full_hash(int index) {
+      element_t &element = elements[index];
+      if (2 == element.state) return element.full_hash;
+      if (1 == element.state) return element.own_hash;
+
+      element.state = 1;
+      /* the hashes of the referenced elements, in a deterministic order (the names are sorted) */
+      uint64_t hash = hash_int(salt_hash, element.own_hash);
+      for (name_set_t::iterator name = element.references.begin(); name != element.references.end(); name++) {
+        std::map<std::string, std::vector<int>, nocasecmp_c>::iterator found = by_name.find(*name);
+        if (found == by_name.end()) continue;
+        for (unsigned int j = 0; j < found->second.size(); j++) {
+          int ref = found->second[j];
+          if (ref == index) continue;
+          hash = hash_int(hash, full_hash(ref));
+        }
+      }
+      if (element.has_external)
+        hash = hash_int(hash, configurations_hash);
+
+      /* careful: the vector does not grow while computing hashes, so the reference is still valid */
+      element.full_hash = hash;
+      element.state     = 2;
+      return hash;
+    }
+}; // dependency_graph_c
+
+
+
+
+/*****************/
+/* build_cache_c */
+/*****************/
+
+#define CACHE_FILE_MAGIC "matiec-build-cache"
+
+static symbol_c *pou_name(symbol_c *pou) {
+  switch (pou->kind) {
+    case kind_function_declaration_c:       return ((function_declaration_c       *)pou)->derived_function_name;
+    case kind_function_block_declaration_c: return ((function_block_declaration_c *)pou)->fblock_name;
+    case kind_program_declaration_c:        return ((program_declaration_c        *)pou)->program_type_name;
+    default:                                return NULL;
+  }
+}
+
+
+build_cache_c::build_cache_c(const char *cache_dir_, symbol_c *tree_root_, std::string salt) {
+  cache_dir   = cache_dir_;
+  tree_root   = tree_root_;
+  stage3_root = NULL;
+  hits = misses = 0;
+
+  dependency_graph_c graph(tree_root, salt);
+  list_c *library = dynamic_cast<list_c *>(tree_root);
+  if (NULL == library) ERROR;
+
+  for (int i = 0; i < library->n; i++) {
+    symbol_c *pou = library->elements[i];
+    if (NULL == pou_name(pou)) continue;
+    pou_entry_t entry;
+    entry.hash = graph.get_hash(pou);
+    entry.hit  = read(pou, entry);
+    pous[pou]  = entry;
+  }
+}
+
+
+build_cache_c::~build_cache_c(void) {}
+
+
+std::string build_cache_c::filename(symbol_c *pou) {
+  token_c *name = dynamic_cast<token_c *>(pou_name(pou));
+  if ((NULL == name) || (NULL == name->value)) ERROR;
+  /* IEC 61131-3 identifiers are case insensitive */
+  std::string upper = name->value;
+  for (unsigned int i = 0; i < upper.size(); i++) upper[i] = toupper(upper[i]);
+  return cache_dir + "/" + upper + ".cache";
+}
+
+
+/* File format:
+ *   matiec-build-cache <hash>\n
+ *   <length of code> <length of header>\n
+ *   <code><header>
+ */
+bool build_cache_c::read(symbol_c *pou, pou_entry_t &entry) {
+  std::ifstream file(filename(pou).c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) return false;
+
+  std::string magic, hash;
+  unsigned long code_len, header_len;
+  file >> magic >> hash >> code_len >> header_len;
+  if (!file || (magic != CACHE_FILE_MAGIC) || (hash != entry.hash)) return false;
+  if (file.get() != '\n') return false;
+
+  std::string code(code_len, '\0'), header(header_len, '\0');
+  if (code_len   > 0) file.read(&code  [0], code_len);
+  if (header_len > 0) file.read(&header[0], header_len);
+  if (!file) return false;
+
+  entry.cached.code   = code;
+  entry.cached.header = header;
+  return true;
+}
+
+
+symbol_c *build_cache_c::stage3_tree(void) {
+  if (NULL != stage3_root) return stage3_root;
+
+  list_c *library = dynamic_cast<list_c *>(tree_root);
+  if (NULL == library) ERROR;
+  library_c *stage3_library = new library_c();
+
+  for (int i = 0; i < library->n; i++) {
+    symbol_c *element = library->elements[i];
+    std::map<symbol_c *, pou_entry_t>::iterator entry = pous.find(element);
+    if ((entry != pous.end()) && entry->second.hit) {
+      /* Replace the POU by a stub with an empty body */
+      switch (element->kind) {
+        case kind_function_declaration_c: {
+          function_declaration_c *f = (function_declaration_c *)element;
+          element = new function_declaration_c(f->derived_function_name, f->type_name, f->var_declarations_list, new statement_list_c());
+          break;
+        }
+        case kind_function_block_declaration_c: {
+          function_block_declaration_c *fb = (function_block_declaration_c *)element;
+          element = new function_block_declaration_c(fb->fblock_name, fb->var_declarations, new statement_list_c());
+          break;
+        }
+        case kind_program_declaration_c: {
+          program_declaration_c *p = (program_declaration_c *)element;
+          element = new program_declaration_c(p->program_type_name, p->var_declarations, new statement_list_c());
+          break;
+        }
+        default: ERROR;
+      }
+    }
+    stage3_library->add_element(element);
+  }
+
+  stage3_root = stage3_library;
+  return stage3_root;
+}
+
+
+bool build_cache_c::get(symbol_c *pou, generated_code_t &generated) {
+  std::map<symbol_c *, pou_entry_t>::iterator entry = pous.find(pou);
+  if ((entry == pous.end()) || !entry->second.hit) {misses++; return false;}
+  generated = entry->second.cached;
+  hits++;
+  return true;
+}
+
+
+void build_cache_c::put(symbol_c *pou, const generated_code_t &generated) {
+  std::map<symbol_c *, pou_entry_t>::iterator entry = pous.find(pou);
+  if (entry == pous.end()) return;
+
+  /* write to a temporary file first, so an interrupted compilation never leaves a truncated entry */
+  std::string name     = filename(pou);
+  std::string tmp_name = name + ".tmp";
+  std::ofstream file(tmp_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (file.is_open()) {
+    file << CACHE_FILE_MAGIC << " " << entry->second.hash << "\n"
+         << generated.code.size() << " " << generated.header.size() << "\n"
+         << generated.code << generated.header;
+    file.close();
+  }
+  if (!file || (rename(tmp_name.c_str(), name.c_str()) != 0)) {
+    fprintf(stderr, "Warning: could not write build cache file %s\n", name.c_str());
+    remove(tmp_name.c_str());
+    return;
+  }
+  entry->second.cached = generated;
+  entry->second.hit    = true;
+}
+
+
+void build_cache_c::print_statistics(void) {
+  fprintf(stdout, "Build cache: %d POU(s) re-used, %d POU(s) compiled\n", hits, misses);
+}
@@ -0,0 +1,120 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Build cache, used for incremental compilation.
+ *
+ *  The code generated for each POU (function, function block or program) is
+ *  stored in the cache directory, together with a hash of that POU. On the
+ *  next compilation, the POUs whose hash did not change are neither checked
+ *  by stage 3 nor handed to stage 4: the previously generated code is
+ *  re-used instead.
+ *
+ *  The hash of a POU is computed over its abstract syntax tree (so changes
+ *  to comments, white space or line numbers are ignored), and includes:
+ *     - the hash of every data type and POU it references (by name),
+ *       which in turn include the hashes of whatever they reference;
+ *     - the hash of all CONFIGURATIONs, if the POU has VAR_EXTERNAL declarations;
+ *     - a 'salt' string, that must identify the compiler version and any
+ *       command line option that may change the generated code.
+ *
+ *  Stage 3 must still see the declarations of the unchanged POUs, as the
+ *  changed POUs may use them (and stage 4 uses the annotations stage 3
+ *  leaves on the variable declarations). stage3_tree() therefore returns
+ *  a copy of the library where each unchanged POU is replaced by a POU with
+ *  the same name and variable declarations (the same objects, not copies!),
+ *  but with an empty body.
+ *
+ *  NOTE: Only the code that stage 4 generates for the POU itself is cached.
+ *        The data types, configurations and resources are always generated.
+ */
+
+
+#ifndef _BUILD_CACHE_HH
+#define _BUILD_CACHE_HH
+
+#include <map>
+#include <string>
+#include "../absyntax_utils/absyntax_utils.hh"
+
+
+class build_cache_c {
+  public:
+    typedef struct {
+      std::string code;    /* the code printed to the source file (POUS.c) */
+      std::string header;  /* the code printed to the header file (POUS.h) */
+    } generated_code_t;
+
+  private:
+    typedef struct {
+      std::string      hash;   /* hex string */
+      bool             hit;    /* the cache holds code generated for this same hash */
+      generated_code_t cached;
+    } pou_entry_t;
+
+    std::string cache_dir;
+    symbol_c   *tree_root;
+    symbol_c   *stage3_root;
+    std::map <symbol_c *, pou_entry_t> pous;
+    int hits, misses;
+
+  public:
+    build_cache_c(const char *cache_dir, symbol_c *tree_root, std::string salt);
+    ~build_cache_c(void);
+
+    /* the library to be checked by stage 3 (see note above) */
+    symbol_c *stage3_tree(void);
+
+    /* Get the code previously generated for a POU whose hash has not changed.
+     * Returns false if the code is not in the cache.
+     */
+    bool get(symbol_c *pou, generated_code_t &generated);
+    /* Store the code generated for a POU. Errors are not fatal, as the cache is
+     * merely an optimisation (a warning is printed instead).
+     */
+    void put(symbol_c *pou, const generated_code_t &generated);
+
+    void print_statistics(void);
+
+  private:
+    std::string filename(symbol_c *pou);
+    bool        read (symbol_c *pou, pou_entry_t &entry);
+}; // build_cache_c
+
+
+
+/* The build cache currently in use, or NULL if incremental compilation is not being used */
+extern build_cache_c *build_cache;
+
+
+#endif /* _BUILD_CACHE_HH */
@@ -201,6 +201,26 @@ void print_ast_c::suffix_fcall(symbol_c* symbol) {}
 
 
 
+/*********************************/
+/* Class to count the AST nodes  */
+/*********************************/
+
+class count_ast_c: public fcall_iterator_visitor_c { 
+  public:
+    count_ast_c(std::map<std::string, unsigned long> &count): count(count) {}
+    
+  protected:
+    void prefix_fcall(symbol_c *symbol) {count[symbol->absyntax_cname()]++;}
+
+  private:
+    std::map<std::string, unsigned long> &count;
+};
+
+
+
+
+
+
 /*********************************/
 /* The DEBUG class               */
 /*********************************/
@@ -220,6 +240,11 @@ void debug_c::print_ast(symbol_c *symbol) {
   print_ast_c::print(symbol);
 }
 
+void debug_c::count_ast(symbol_c *symbol, std::map<std::string, unsigned long> &count) {
+  count_ast_c count_ast(count);
+  symbol->accept(count_ast);
+}
+
 
 
 
@@ -41,6 +41,8 @@
 
 
 
+#include <map>
+#include <string>
 #include "../absyntax/absyntax.hh"
 
 
@@ -51,6 +53,9 @@ class debug_c {
 
     /* print the AST from this point downwards */
     static void print_ast(symbol_c *root_symbol);
+
+    /* count the symbols of the AST from this point downwards, by class (see absyntax_cname()) */
+    static void count_ast(symbol_c *root_symbol, std::map<std::string, unsigned long> &count);
 };
 
 
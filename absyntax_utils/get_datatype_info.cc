@@ -47,8 +47,6 @@
 
 
 
-#include <typeinfo>  // required for typeid
-
 
 /**********************************************************/
 /**********************************************************/
@@ -236,11 +234,11 @@ symbol_c *get_datatype_info_c::get_id(symbol_c *datatype) {
 
 bool get_datatype_info_c::is_type_equal(symbol_c *first_type, symbol_c *second_type) {
   if ((NULL == first_type) || (NULL == second_type))                 {return false;}
-  if (typeid(* first_type) == typeid(invalid_type_name_c))           {return false;}
-  if (typeid(*second_type) == typeid(invalid_type_name_c))           {return false;}
+  if (first_type->kind == kind_invalid_type_name_c)                  {return false;}
+  if (second_type->kind == kind_invalid_type_name_c)                 {return false;}
     
   if ((get_datatype_info_c::is_ANY_ELEMENTARY(first_type)) &&
-      (typeid(*first_type) == typeid(*second_type)))                 {return true;}
+      (first_type->kind == second_type->kind))                       {return true;}
   /* ANY_DERIVED */
   return (first_type == second_type);
 }
@@ -249,7 +247,7 @@ bool get_datatype_info_c::is_type_equal(symbol_c *first_type, symbol_c *second_t
 
 bool get_datatype_info_c::is_type_valid(symbol_c *type) {
   if (NULL == type)                                                  {return false;}
-  if (typeid(*type) == typeid(invalid_type_name_c))                  {return false;}
+  if (type->kind == kind_invalid_type_name_c)                        {return false;}
   return true;
 }
 
@@ -261,7 +259,7 @@ bool get_datatype_info_c::is_type_valid(symbol_c *type) {
 bool get_datatype_info_c::is_sfc_initstep(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); 
   if (NULL == type_decl)                                             {return false;}
-  if (typeid(*type_decl) == typeid(initial_step_c))                  {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
+  if (type_decl->kind == kind_initial_step_c)                        {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
   return false;
 }
 
@@ -272,8 +270,8 @@ bool get_datatype_info_c::is_sfc_initstep(symbol_c *type_symbol) {
 bool get_datatype_info_c::is_sfc_step(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); 
   if (NULL == type_decl)                                             {return false;}
-  if (typeid(*type_decl) == typeid(initial_step_c))                  {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
-  if (typeid(*type_decl) == typeid(        step_c))                  {return true;}   /*         STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
+  if (type_decl->kind == kind_initial_step_c)                        {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
+  if (type_decl->kind == kind_step_c)                                {return true;}   /*         STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
   return false;
 }
 
@@ -283,7 +281,7 @@ bool get_datatype_info_c::is_sfc_step(symbol_c *type_symbol) {
 bool get_datatype_info_c::is_function_block(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); 
   if (NULL == type_decl)                                             {return false;}
-  if (typeid(*type_decl) == typeid(function_block_declaration_c))    {return true;}   /*  FUNCTION_BLOCK derived_function_block_name io_OR_other_var_declarations function_block_body END_FUNCTION_BLOCK */
+  if (type_decl->kind == kind_function_block_declaration_c)          {return true;}   /*  FUNCTION_BLOCK derived_function_block_name io_OR_other_var_declarations function_block_body END_FUNCTION_BLOCK */
   return false;
 }
 
@@ -295,11 +293,11 @@ bool get_datatype_info_c::is_subrange(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); /* NOTE: will work correctly once we update the way search_base_type_c works, by adding a new search_effective_type:c */
   if (NULL == type_decl)                                             {return false;}
   
-  if (typeid(*type_decl) == typeid(subrange_type_declaration_c))     {return true;}   /*  subrange_type_name ':' subrange_spec_init */
-  if (typeid(*type_decl) == typeid(subrange_spec_init_c))            {return true;}   /* subrange_specification ASSIGN signed_integer */
-  if (typeid(*type_decl) == typeid(subrange_specification_c))        {return true;}   /*  integer_type_name '(' subrange')' */
+  if (type_decl->kind == kind_subrange_type_declaration_c)           {return true;}   /*  subrange_type_name ':' subrange_spec_init */
+  if (type_decl->kind == kind_subrange_spec_init_c)                  {return true;}   /* subrange_specification ASSIGN signed_integer */
+  if (type_decl->kind == kind_subrange_specification_c)              {return true;}   /*  integer_type_name '(' subrange')' */
     
-  if (typeid(*type_decl) == typeid(subrange_c))                      {ERROR;}         /*  signed_integer DOTDOT signed_integer */
+  if (type_decl->kind == kind_subrange_c)                            {ERROR;}         /*  signed_integer DOTDOT signed_integer */
   return false;
 }
 
@@ -311,11 +309,11 @@ bool get_datatype_info_c::is_enumerated(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                             {return false;}
   
-  if (typeid(*type_decl) == typeid(enumerated_type_declaration_c))   {return true;}   /*  enumerated_type_name ':' enumerated_spec_init */
-  if (typeid(*type_decl) == typeid(enumerated_spec_init_c))          {return true;}   /* enumerated_specification ASSIGN enumerated_value */
-  if (typeid(*type_decl) == typeid(enumerated_value_list_c))         {return true;}   /* enumerated_value_list ',' enumerated_value */        /* once we change the way we handle enums, this will probably become an ERROR! */
+  if (type_decl->kind == kind_enumerated_type_declaration_c)         {return true;}   /*  enumerated_type_name ':' enumerated_spec_init */
+  if (type_decl->kind == kind_enumerated_spec_init_c)                {return true;}   /* enumerated_specification ASSIGN enumerated_value */
+  if (type_decl->kind == kind_enumerated_value_list_c)               {return true;}   /* enumerated_value_list ',' enumerated_value */        /* once we change the way we handle enums, this will probably become an ERROR! */
   
-  if (typeid(*type_decl) == typeid(enumerated_value_c))              {ERROR;}         /* enumerated_type_name '#' identifier */
+  if (type_decl->kind == kind_enumerated_value_c)                    {ERROR;}         /* enumerated_type_name '#' identifier */
   return false;
 }
 
@@ -327,13 +325,13 @@ bool get_datatype_info_c::is_array(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                             {return false;}
   
-  if (typeid(*type_decl) == typeid(array_type_declaration_c))        {return true;}   /*  identifier ':' array_spec_init */
-  if (typeid(*type_decl) == typeid(array_spec_init_c))               {return true;}   /* array_specification [ASSIGN array_initialization} */
-  if (typeid(*type_decl) == typeid(array_specification_c))           {return true;}   /* ARRAY '[' array_subrange_list ']' OF non_generic_type_name */
+  if (type_decl->kind == kind_array_type_declaration_c)              {return true;}   /*  identifier ':' array_spec_init */
+  if (type_decl->kind == kind_array_spec_init_c)                     {return true;}   /* array_specification [ASSIGN array_initialization} */
+  if (type_decl->kind == kind_array_specification_c)                 {return true;}   /* ARRAY '[' array_subrange_list ']' OF non_generic_type_name */
   
-  if (typeid(*type_decl) == typeid(array_subrange_list_c))           {ERROR;}         /* array_subrange_list ',' subrange */
-  if (typeid(*type_decl) == typeid(array_initial_elements_list_c))   {ERROR;}         /* array_initialization:  '[' array_initial_elements_list ']' */  /* array_initial_elements_list ',' array_initial_elements */
-  if (typeid(*type_decl) == typeid(array_initial_elements_c))        {ERROR;}         /* integer '(' [array_initial_element] ')' */
+  if (type_decl->kind == kind_array_subrange_list_c)                 {ERROR;}         /* array_subrange_list ',' subrange */
+  if (type_decl->kind == kind_array_initial_elements_list_c)         {ERROR;}         /* array_initialization:  '[' array_initial_elements_list ']' */  /* array_initial_elements_list ',' array_initial_elements */
+  if (type_decl->kind == kind_array_initial_elements_c)              {ERROR;}         /* integer '(' [array_initial_element] ')' */
   return false;
 }
 
@@ -345,13 +343,13 @@ bool get_datatype_info_c::is_structure(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                                       {return false;}
   
-  if (typeid(*type_decl) == typeid(structure_type_declaration_c))              {return true;}   /*  structure_type_name ':' structure_specification */
-  if (typeid(*type_decl) == typeid(initialized_structure_c))                   {return true;}   /* structure_type_name ASSIGN structure_initialization */
-  if (typeid(*type_decl) == typeid(structure_element_declaration_list_c))      {return true;}   /* structure_declaration:  STRUCT structure_element_declaration_list END_STRUCT */ /* structure_element_declaration_list structure_element_declaration ';' */
+  if (type_decl->kind == kind_structure_type_declaration_c)                    {return true;}   /*  structure_type_name ':' structure_specification */
+  if (type_decl->kind == kind_initialized_structure_c)                         {return true;}   /* structure_type_name ASSIGN structure_initialization */
+  if (type_decl->kind == kind_structure_element_declaration_list_c)            {return true;}   /* structure_declaration:  STRUCT structure_element_declaration_list END_STRUCT */ /* structure_element_declaration_list structure_element_declaration ';' */
   
-  if (typeid(*type_decl) == typeid(structure_element_declaration_c))           {ERROR;}         /*  structure_element_name ':' *_spec_init */
-  if (typeid(*type_decl) == typeid(structure_element_initialization_list_c))   {ERROR;}         /* structure_initialization: '(' structure_element_initialization_list ')' */  /* structure_element_initialization_list ',' structure_element_initialization */
-  if (typeid(*type_decl) == typeid(structure_element_initialization_c))        {ERROR;}         /*  structure_element_name ASSIGN value */
+  if (type_decl->kind == kind_structure_element_declaration_c)                 {ERROR;}         /*  structure_element_name ':' *_spec_init */
+  if (type_decl->kind == kind_structure_element_initialization_list_c)         {ERROR;}         /* structure_initialization: '(' structure_element_initialization_list ')' */  /* structure_element_initialization_list ',' structure_element_initialization */
+  if (type_decl->kind == kind_structure_element_initialization_c)              {ERROR;}         /*  structure_element_name ASSIGN value */
   return false;
 }
 
@@ -365,484 +363,211 @@ bool get_datatype_info_c::is_structure(symbol_c *type_symbol) {
 
 
 bool get_datatype_info_c::is_ANY_ELEMENTARY(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_MAGNITUDE(type_symbol))                           {return true;}
-  if (is_ANY_BIT      (type_symbol))                           {return true;}
-  if (is_ANY_STRING   (type_symbol))                           {return true;}
-  if (is_ANY_DATE     (type_symbol))                           {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_ELEMENTARY);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEELEMENTARY(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_SAFEMAGNITUDE(type_symbol))                       {return true;}
-  if (is_ANY_SAFEBIT      (type_symbol))                       {return true;}
-  if (is_ANY_SAFESTRING   (type_symbol))                       {return true;}
-  if (is_ANY_SAFEDATE     (type_symbol))                       {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEELEMENTARY);
 }
 
-
 bool get_datatype_info_c::is_ANY_ELEMENTARY_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_ELEMENTARY    (type_symbol))                      {return true;}
-  if (is_ANY_SAFEELEMENTARY(type_symbol))                      {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_ELEMENTARY | tc_ANY_SAFEELEMENTARY);
 }
 
 
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_MAGNITUDE(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_TIME(type_symbol))                                    {return true;}
-  if (is_ANY_NUM(type_symbol))                                 {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_MAGNITUDE);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEMAGNITUDE(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_SAFETIME(type_symbol))                                {return true;}
-  if (is_ANY_SAFENUM(type_symbol))                             {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEMAGNITUDE);
 }
 
-
 bool get_datatype_info_c::is_ANY_MAGNITUDE_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_MAGNITUDE    (type_symbol))                       {return true;}
-  if (is_ANY_SAFEMAGNITUDE(type_symbol))                       {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_MAGNITUDE | tc_ANY_SAFEMAGNITUDE);
 }
 
 
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_signed_MAGNITUDE(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(time_type_name_c))        {return true;}
-  if (is_ANY_signed_NUM(type_symbol))                          {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_MAGNITUDE);
 }
 
-
 bool get_datatype_info_c::is_ANY_signed_SAFEMAGNITUDE(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safetime_type_name_c))    {return true;}
-  return is_ANY_signed_SAFENUM(type_symbol);
+  return is_type_category(type_symbol, tc_ANY_signed_SAFEMAGNITUDE);
 }
 
-
 bool get_datatype_info_c::is_ANY_signed_MAGNITUDE_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_signed_MAGNITUDE    (type_symbol))                {return true;}
-  if (is_ANY_signed_SAFEMAGNITUDE(type_symbol))                {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_MAGNITUDE | tc_ANY_signed_SAFEMAGNITUDE);
 }
 
 
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_NUM(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_REAL(type_symbol))                                {return true;}
-  if (is_ANY_INT (type_symbol))                                {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_NUM);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFENUM(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_SAFEREAL(type_symbol))                            {return true;}
-  if (is_ANY_SAFEINT (type_symbol))                            {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFENUM);
 }
 
-
 bool get_datatype_info_c::is_ANY_NUM_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_NUM    (type_symbol))                             {return true;}
-  if (is_ANY_SAFENUM(type_symbol))                             {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_NUM | tc_ANY_SAFENUM);
 }
 
 
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_signed_NUM(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_REAL      (type_symbol))                          {return true;}
-  if (is_ANY_signed_INT(type_symbol))                          {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_NUM);
 }
 
-
 bool get_datatype_info_c::is_ANY_signed_SAFENUM(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_SAFEREAL      (type_symbol))                      {return true;}
-  if (is_ANY_signed_SAFEINT(type_symbol))                      {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_SAFENUM);
 }
 
-
 bool get_datatype_info_c::is_ANY_signed_NUM_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_signed_NUM    (type_symbol))                      {return true;}
-  if (is_ANY_signed_SAFENUM(type_symbol))                      {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_NUM | tc_ANY_signed_SAFENUM);
 }
 
 
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_INT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_signed_INT  (type_symbol))                        {return true;}
-  if (is_ANY_unsigned_INT(type_symbol))                        {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_INT);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEINT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_signed_SAFEINT  (type_symbol))                    {return true;}
-  if (is_ANY_unsigned_SAFEINT(type_symbol))                    {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEINT);
 }
 
-
 bool get_datatype_info_c::is_ANY_INT_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_INT    (type_symbol))                             {return true;}
-  if (is_ANY_SAFEINT(type_symbol))                             {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_INT | tc_ANY_SAFEINT);
 }
 
 
-
-
-
-
 bool get_datatype_info_c::is_ANY_signed_INT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(sint_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(int_type_name_c))         {return true;}
-  if (typeid(*type_symbol) == typeid(dint_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(lint_type_name_c))        {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_INT);
 }
 
-
 bool get_datatype_info_c::is_ANY_signed_SAFEINT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safesint_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safeint_type_name_c))     {return true;}
-  if (typeid(*type_symbol) == typeid(safedint_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safelint_type_name_c))    {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_SAFEINT);
 }
 
-
 bool get_datatype_info_c::is_ANY_signed_INT_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_signed_INT    (type_symbol))                      {return true;}
-  if (is_ANY_signed_SAFEINT(type_symbol))                      {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_signed_INT | tc_ANY_signed_SAFEINT);
 }
 
 
-
-
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_unsigned_INT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(usint_type_name_c))       {return true;}
-  if (typeid(*type_symbol) == typeid(uint_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(udint_type_name_c))       {return true;}
-  if (typeid(*type_symbol) == typeid(ulint_type_name_c))       {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_unsigned_INT);
 }
 
-
 bool get_datatype_info_c::is_ANY_unsigned_SAFEINT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safeusint_type_name_c))   {return true;}
-  if (typeid(*type_symbol) == typeid(safeuint_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safeudint_type_name_c))   {return true;}
-  if (typeid(*type_symbol) == typeid(safeulint_type_name_c))   {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_unsigned_SAFEINT);
 }
 
-
 bool get_datatype_info_c::is_ANY_unsigned_INT_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_unsigned_INT    (type_symbol))                    {return true;}
-  if (is_ANY_unsigned_SAFEINT(type_symbol))                    {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_unsigned_INT | tc_ANY_unsigned_SAFEINT);
 }
 
 
-
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_REAL(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(real_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(lreal_type_name_c))       {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_REAL);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEREAL(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safereal_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safelreal_type_name_c))   {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEREAL);
 }
 
-
 bool get_datatype_info_c::is_ANY_REAL_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_REAL    (type_symbol))                            {return true;}
-  if (is_ANY_SAFEREAL(type_symbol))                            {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_REAL | tc_ANY_SAFEREAL);
 }
 
 
-
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_nBIT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(byte_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(word_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(dword_type_name_c))       {return true;}
-  if (typeid(*type_symbol) == typeid(lword_type_name_c))       {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_nBIT);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEnBIT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safebyte_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safeword_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safedword_type_name_c))   {return true;}
-  if (typeid(*type_symbol) == typeid(safelword_type_name_c))   {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEnBIT);
 }
 
-
 bool get_datatype_info_c::is_ANY_nBIT_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_nBIT    (type_symbol))                            {return true;}
-  if (is_ANY_SAFEnBIT(type_symbol))                            {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_nBIT | tc_ANY_SAFEnBIT);
 }
 
 
-
-
-
-
-
-
-
-
 bool get_datatype_info_c::is_BOOL(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(bool_type_name_c))        {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_BOOL);
 }
 
-
 bool get_datatype_info_c::is_SAFEBOOL(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safebool_type_name_c))    {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_SAFEBOOL);
 }
 
-
 bool get_datatype_info_c::is_BOOL_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_BOOL    (type_symbol))                                {return true;}
-  if (is_SAFEBOOL(type_symbol))                                {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_BOOL | tc_SAFEBOOL);
 }
 
 
-
-
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_BIT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_BOOL    (type_symbol))                                {return true;}
-  if (is_ANY_nBIT(type_symbol))                                {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_BIT);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEBIT(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_SAFEBOOL    (type_symbol))                            {return true;}
-  if (is_ANY_SAFEnBIT(type_symbol))                            {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEBIT);
 }
 
-
 bool get_datatype_info_c::is_ANY_BIT_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_BIT    (type_symbol))                             {return true;}
-  if (is_ANY_SAFEBIT(type_symbol))                             {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_BIT | tc_ANY_SAFEBIT);
 }
 
 
-
-
-
-
-
-
 bool get_datatype_info_c::is_TIME(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(time_type_name_c))        {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_TIME);
 }
 
-
 bool get_datatype_info_c::is_SAFETIME(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safetime_type_name_c))    {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_SAFETIME);
 }
 
-
 bool get_datatype_info_c::is_TIME_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_TIME    (type_symbol))                                {return true;}
-  if (is_SAFETIME(type_symbol))                                {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_TIME | tc_SAFETIME);
 }
 
 
-
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_DATE(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(date_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(tod_type_name_c))         {return true;}
-  if (typeid(*type_symbol) == typeid(dt_type_name_c))          {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_DATE);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFEDATE(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safedate_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safetod_type_name_c))     {return true;}
-  if (typeid(*type_symbol) == typeid(safedt_type_name_c))      {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFEDATE);
 }
 
-
 bool get_datatype_info_c::is_ANY_DATE_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_DATE    (type_symbol))                            {return true;}
-  if (is_ANY_SAFEDATE(type_symbol))                            {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_DATE | tc_ANY_SAFEDATE);
 }
 
 
-
-
-
-
-
-
-
-
-
 bool get_datatype_info_c::is_ANY_STRING(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(string_type_name_c))      {return true;}
-  if (typeid(*type_symbol) == typeid(wstring_type_name_c))     {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_STRING);
 }
 
-
 bool get_datatype_info_c::is_ANY_SAFESTRING(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safestring_type_name_c))  {return true;}
-  if (typeid(*type_symbol) == typeid(safewstring_type_name_c)) {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_SAFESTRING);
 }
 
-
 bool get_datatype_info_c::is_ANY_STRING_compatible(symbol_c *type_symbol) {
-  if (type_symbol == NULL)                                     {return false;}
-  if (is_ANY_STRING    (type_symbol))                          {return true;}
-  if (is_ANY_SAFESTRING(type_symbol))                          {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_ANY_STRING | tc_ANY_SAFESTRING);
 }
 
 
 
-
-
-
-
 /* Can't we do away with this?? */
 bool get_datatype_info_c::is_ANY_REAL_literal(symbol_c *type_symbol) {
   if (type_symbol == NULL)                              {return true;} /* Please make sure things will work correctly before changing this to false!! */
-  if (typeid(*type_symbol) == typeid(real_c))           {return true;}
-  if (typeid(*type_symbol) == typeid(neg_real_c))       {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_REAL_literal);
 }
 
 /* Can't we do away with this?? */
 bool get_datatype_info_c::is_ANY_INT_literal(symbol_c *type_symbol) {
   if (type_symbol == NULL)                              {return true;} /* Please make sure things will work correctly before changing this to false!! */
-  if (typeid(*type_symbol) == typeid(integer_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(neg_integer_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(binary_integer_c)) {return true;}
-  if (typeid(*type_symbol) == typeid(octal_integer_c))  {return true;}
-  if (typeid(*type_symbol) == typeid(hex_integer_c))    {return true;}
-  return false;
+  return is_type_category(type_symbol, tc_INT_literal);
 }
 
 
@@ -45,6 +45,40 @@
 
 
 
+/* The generic data types (ANY_NUM, ANY_BIT, ...), as the bitmask of the
+ * data type categories (see type_category_t in absyntax.hh) they include.
+ */
+typedef enum {
+  tc_ANY_signed_INT              = tc_signed_INT,
+  tc_ANY_signed_SAFEINT          = tc_signed_SAFEINT,
+  tc_ANY_unsigned_INT            = tc_unsigned_INT,
+  tc_ANY_unsigned_SAFEINT        = tc_unsigned_SAFEINT,
+  tc_ANY_INT                     = tc_signed_INT     | tc_unsigned_INT,
+  tc_ANY_SAFEINT                 = tc_signed_SAFEINT | tc_unsigned_SAFEINT,
+  tc_ANY_REAL                    = tc_REAL,
+  tc_ANY_SAFEREAL                = tc_SAFEREAL,
+  tc_ANY_NUM                     = tc_ANY_INT            | tc_ANY_REAL,
+  tc_ANY_SAFENUM                 = tc_ANY_SAFEINT        | tc_ANY_SAFEREAL,
+  tc_ANY_signed_NUM              = tc_ANY_signed_INT     | tc_ANY_REAL,
+  tc_ANY_signed_SAFENUM          = tc_ANY_signed_SAFEINT | tc_ANY_SAFEREAL,
+  tc_ANY_MAGNITUDE               = tc_ANY_NUM            | tc_TIME,
+  tc_ANY_SAFEMAGNITUDE           = tc_ANY_SAFENUM        | tc_SAFETIME,
+  tc_ANY_signed_MAGNITUDE        = tc_ANY_signed_NUM     | tc_TIME,
+  tc_ANY_signed_SAFEMAGNITUDE    = tc_ANY_signed_SAFENUM | tc_SAFETIME,
+  tc_ANY_nBIT                    = tc_nBIT,
+  tc_ANY_SAFEnBIT                = tc_SAFEnBIT,
+  tc_ANY_BIT                     = tc_BOOL     | tc_nBIT,
+  tc_ANY_SAFEBIT                 = tc_SAFEBOOL | tc_SAFEnBIT,
+  tc_ANY_DATE                    = tc_DATE,
+  tc_ANY_SAFEDATE                = tc_SAFEDATE,
+  tc_ANY_STRING                  = tc_STRING,
+  tc_ANY_SAFESTRING              = tc_SAFESTRING,
+  tc_ANY_ELEMENTARY              = tc_ANY_MAGNITUDE     | tc_ANY_BIT     | tc_ANY_STRING     | tc_ANY_DATE,
+  tc_ANY_SAFEELEMENTARY          = tc_ANY_SAFEMAGNITUDE | tc_ANY_SAFEBIT | tc_ANY_SAFESTRING | tc_ANY_SAFEDATE
+} generic_type_category_t;
+
+
+
 
 
 
@@ -55,6 +89,10 @@ class get_datatype_info_c {
      get_datatype_info_c(void) {};
     ~get_datatype_info_c(void) {};
 
+    /* does the (elementary) data type belong to any of the type categories in the bitmask? */
+    static bool is_type_category(symbol_c *type_symbol, uint32_t category)
+      {return (NULL != type_symbol) && (0 != (type_symbol->type_category & category));}
+
   
   public:
     static symbol_c   *get_id    (symbol_c *datatype); /* get the identifier (name) of the datatype); returns NULL if anonymous datatype! Does not work for elementary datatypes!*/
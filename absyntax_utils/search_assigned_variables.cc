@@ -0,0 +1,237 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Search for all the variables whose value may be changed by the code in the body of a POU.
+ *  (see search_assigned_variables.hh for details)
+ */
+
+
+#include "absyntax_utils.hh"
+
+
+
+/* set to 1 to see debug info during execution */
+static int debug = 0;
+
+
+/* Return the name of the variable that is changed when assigning to 'variable',
+ * or NULL if 'variable' is not a variable (e.g. it is an expression or a literal).
+ *
+ * NOTE: To follow the basic structure used throughout the compiler's code, we should really be
+ * writing this as a visitor_c (and do away with the dynamic casts!), but since we only have 3 distinct
+ * symbol class types to handle, it is probably easier to read if we write it as a standard function...
+ */
+static symbol_c *get_assigned_var_name(symbol_c *variable) {
+  symbolic_variable_c   *symbolic_variable;
+  array_variable_c      *array_variable;
+  structured_variable_c *structured_variable;
+
+  if ((symbolic_variable   = dynamic_cast<symbolic_variable_c   *>(variable)) != NULL) return symbolic_variable->var_name;
+  if ((array_variable      = dynamic_cast<array_variable_c      *>(variable)) != NULL) return get_assigned_var_name(array_variable->subscripted_variable);
+  if ((structured_variable = dynamic_cast<structured_variable_c *>(variable)) != NULL) return get_assigned_var_name(structured_variable->record_variable);
+  /* FB instance names in IL 'CAL fb_name' and ST 'fb_name(...)' are identifiers */
+  if (dynamic_cast<identifier_c *>(variable) != NULL) return variable;
+  return NULL;
+}
+
+
+
+search_assigned_variables_c::search_assigned_variables_c(symbol_c *search_scope) {
+  il_operand = NULL;
+  if (NULL != search_scope)
+    search_scope->accept(*this);
+  if (debug) printf("search_assigned_variables_c: %d assigned variables found\n", (int)assigned_variables.size());
+}
+
+search_assigned_variables_c::~search_assigned_variables_c(void) {
+}
+
+
+bool search_assigned_variables_c::is_assigned(symbol_c *variable_name) {
+  token_c *name = dynamic_cast<token_c *>(get_assigned_var_name(variable_name));
+  if (NULL == name) ERROR;
+  return (assigned_variables.count(name->value) > 0);
+}
+
+
+void search_assigned_variables_c::add_assigned(symbol_c *variable) {
+  if (NULL == variable) return;
+  token_c *name = dynamic_cast<token_c *>(get_assigned_var_name(variable));
+  if (NULL != name)
+    assigned_variables.insert(name->value);
+}
+
+
+void search_assigned_variables_c::add_assigned_list(symbol_c *param_list) {
+  list_c *list = dynamic_cast<list_c *>(param_list);
+  if (NULL == list) return;
+  for (int i = 0; i < list->n; i++)
+    add_assigned(list->elements[i]);
+}
+
+
+
+/***********************/
+/* B 1.5.1 - Functions */
+/***********************/
+void *search_assigned_variables_c::visit(function_declaration_c *symbol) {
+  symbol->function_body->accept(*this);
+  return NULL;
+}
+
+/*****************************/
+/* B 1.5.2 - Function Blocks */
+/*****************************/
+void *search_assigned_variables_c::visit(function_block_declaration_c *symbol) {
+  symbol->fblock_body->accept(*this);
+  return NULL;
+}
+
+/**********************/
+/* B 1.5.3 - Programs */
+/**********************/
+void *search_assigned_variables_c::visit(program_declaration_c *symbol) {
+  symbol->function_block_body->accept(*this);
+  return NULL;
+}
+
+
+
+/****************************************/
+/* B.2 - Language IL (Instruction List) */
+/****************************************/
+/***********************************/
+/* B 2.1 Instructions and Operands */
+/***********************************/
+// SYM_REF2(il_simple_operation_c, il_simple_operator, il_operand)
+void *search_assigned_variables_c::visit(il_simple_operation_c *symbol) {
+  il_operand = symbol->il_operand;
+  symbol->il_simple_operator->accept(*this);
+  il_operand = NULL;
+  if (NULL != symbol->il_operand)
+    symbol->il_operand->accept(*this);
+  return NULL;
+}
+
+// SYM_REF2(il_function_call_c, function_name, il_operand_list, ...)
+void *search_assigned_variables_c::visit(il_function_call_c *symbol) {
+  add_assigned_list(symbol->il_operand_list);
+  return iterator_visitor_c::visit(symbol);
+}
+
+// SYM_REF4(il_fb_call_c, il_call_operator, fb_name, il_operand_list, il_param_list, ...)
+void *search_assigned_variables_c::visit(il_fb_call_c *symbol) {
+  add_assigned(symbol->fb_name);
+  add_assigned_list(symbol->il_operand_list);
+  return iterator_visitor_c::visit(symbol);
+}
+
+// SYM_REF3(il_param_assignment_c, il_assign_operator, il_operand, simple_instr_list)
+void *search_assigned_variables_c::visit(il_param_assignment_c *symbol) {
+  add_assigned(symbol->il_operand);
+  return iterator_visitor_c::visit(symbol);
+}
+
+// SYM_REF2(il_param_out_assignment_c, il_assign_out_operator, variable)
+void *search_assigned_variables_c::visit(il_param_out_assignment_c *symbol) {
+  add_assigned(symbol->variable);
+  return iterator_visitor_c::visit(symbol);
+}
+
+
+/*******************/
+/* B 2.2 Operators */
+/*******************/
+void *search_assigned_variables_c::visit(   ST_operator_c *symbol) {add_assigned(il_operand); return NULL;}
+void *search_assigned_variables_c::visit(  STN_operator_c *symbol) {add_assigned(il_operand); return NULL;}
+void *search_assigned_variables_c::visit(    S_operator_c *symbol) {add_assigned(il_operand); return NULL;}
+void *search_assigned_variables_c::visit(    R_operator_c *symbol) {add_assigned(il_operand); return NULL;}
+
+
+
+/***************************************/
+/* B.3 - Language ST (Structured Text) */
+/***************************************/
+/***********************/
+/* B 3.1 - Expressions */
+/***********************/
+// SYM_REF3(function_invocation_c, function_name, formal_param_list, nonformal_param_list, ...)
+void *search_assigned_variables_c::visit(function_invocation_c *symbol) {
+  add_assigned_list(symbol->nonformal_param_list);
+  return iterator_visitor_c::visit(symbol);
+}
+
+
+/*********************************/
+/* B 3.2.1 Assignment Statements */
+/*********************************/
+// SYM_REF2(assignment_statement_c, l_exp, r_exp)
+void *search_assigned_variables_c::visit(assignment_statement_c *symbol) {
+  add_assigned(symbol->l_exp);
+  return iterator_visitor_c::visit(symbol);
+}
+
+
+/*****************************************/
+/* B 3.2.2 Subprogram Control Statements */
+/*****************************************/
+// SYM_REF3(fb_invocation_c, fb_name, formal_param_list, nonformal_param_list, ...)
+void *search_assigned_variables_c::visit(fb_invocation_c *symbol) {
+  add_assigned(symbol->fb_name);
+  add_assigned_list(symbol->nonformal_param_list);
+  return iterator_visitor_c::visit(symbol);
+}
+
+// SYM_REF2(input_variable_param_assignment_c, variable_name, expression)
+void *search_assigned_variables_c::visit(input_variable_param_assignment_c *symbol) {
+  add_assigned(symbol->expression);
+  return iterator_visitor_c::visit(symbol);
+}
+
+// SYM_REF3(output_variable_param_assignment_c, not_param, variable_name, variable)
+void *search_assigned_variables_c::visit(output_variable_param_assignment_c *symbol) {
+  add_assigned(symbol->variable);
+  return iterator_visitor_c::visit(symbol);
+}
+
+
+/********************************/
+/* B 3.2.4 Iteration Statements */
+/********************************/
+// SYM_REF5(for_statement_c, control_variable, beg_expression, end_expression, by_expression, statement_list)
+void *search_assigned_variables_c::visit(for_statement_c *symbol) {
+  add_assigned(symbol->control_variable);
+  return iterator_visitor_c::visit(symbol);
+}
+
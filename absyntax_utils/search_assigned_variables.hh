@@ -0,0 +1,143 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Search for all the variables whose value may be changed by the code in the body of a POU.
+ *
+ *  when instantiated, must be given a pointer to one of the following
+ *     - function_declaration_c
+ *     - function_block_declaration_c
+ *     - program_declaration_c
+ *
+ *  A variable is considered to be assigned in the following situations:
+ *     - left hand side of an ST assignment statement;
+ *     - control variable of a FOR loop;
+ *     - operand of the IL operators ST, STN, S and R;
+ *     - variable receiving the value of an output parameter ('=>') of a function or FB call;
+ *     - variable passed directly (i.e. not inside an expression) as a parameter
+ *       of a function or FB call, as it may be bound to a VAR_IN_OUT parameter;
+ *     - name of a FB instance that is invoked.
+ *  When only an element of an array or a field of a structure is assigned, the whole
+ *  variable is considered to be assigned (i.e. 'B[8] := 99' assigns 'B').
+ *
+ *  Note that the search is done only once, in the constructor. After that, is_assigned()
+ *  merely does a lookup in a set.
+ */
+
+
+#include <set>
+#include <string>
+#include "../absyntax_utils/absyntax_utils.hh"
+
+
+class search_assigned_variables_c: public iterator_visitor_c {
+
+  private:
+    std::set <std::string, nocasecmp_c> assigned_variables;
+
+  public:
+    search_assigned_variables_c(symbol_c *search_scope);
+    virtual ~search_assigned_variables_c(void);
+
+    bool is_assigned(symbol_c *variable_name);
+
+  private:
+    void add_assigned(symbol_c *variable);
+    void add_assigned_list(symbol_c *param_list);
+
+  private:
+    /* NOTE: the variable declarations are not of interest to us, only the POU bodies */
+    /***********************/
+    /* B 1.5.1 - Functions */
+    /***********************/
+    void *visit(function_declaration_c *symbol);
+    /*****************************/
+    /* B 1.5.2 - Function Blocks */
+    /*****************************/
+    void *visit(function_block_declaration_c *symbol);
+    /**********************/
+    /* B 1.5.3 - Programs */
+    /**********************/
+    void *visit(program_declaration_c *symbol);
+
+    /****************************************/
+    /* B.2 - Language IL (Instruction List) */
+    /****************************************/
+    /***********************************/
+    /* B 2.1 Instructions and Operands */
+    /***********************************/
+    void *visit(il_simple_operation_c *symbol);
+    void *visit(il_function_call_c *symbol);
+    void *visit(il_fb_call_c *symbol);
+    void *visit(il_param_assignment_c *symbol);
+    void *visit(il_param_out_assignment_c *symbol);
+
+    /*******************/
+    /* B 2.2 Operators */
+    /*******************/
+    void *visit(   ST_operator_c *symbol);
+    void *visit(  STN_operator_c *symbol);
+    void *visit(    S_operator_c *symbol);
+    void *visit(    R_operator_c *symbol);
+
+    /***************************************/
+    /* B.3 - Language ST (Structured Text) */
+    /***************************************/
+    /***********************/
+    /* B 3.1 - Expressions */
+    /***********************/
+    void *visit(function_invocation_c *symbol);
+
+    /*********************************/
+    /* B 3.2.1 Assignment Statements */
+    /*********************************/
+    void *visit(assignment_statement_c *symbol);
+
+    /*****************************************/
+    /* B 3.2.2 Subprogram Control Statements */
+    /*****************************************/
+    void *visit(fb_invocation_c *symbol);
+    void *visit(input_variable_param_assignment_c *symbol);
+    void *visit(output_variable_param_assignment_c *symbol);
+
+    /********************************/
+    /* B 3.2.4 Iteration Statements */
+    /********************************/
+    void *visit(for_statement_c *symbol);
+
+  private:
+    /* the operand of the IL instruction currently being visited */
+    symbol_c *il_operand;
+}; // search_assigned_variables_c
+
+
@@ -132,7 +132,6 @@ search_var_instance_decl_c::opt_t search_var_instance_decl_c::get_option(symbol_
 /* This is a temporary fix. Hopefully, once I clean up stage4 code, and I change the way
  * we generate C code, this function will no longer be needed!
  */
-#include <typeinfo>  /* required for typeid() */
 bool search_var_instance_decl_c::type_is_complex(symbol_c *symbol) {
   symbol_c *decl;
   
@@ -141,12 +140,12 @@ bool search_var_instance_decl_c::type_is_complex(symbol_c *symbol) {
   decl = search_base_type_c::get_basetype_decl(decl);
   if (NULL == decl) ERROR;
   
-  return ((typeid( *(decl) ) == typeid( array_specification_c                )) ||
-//        (typeid( *(decl) ) == typeid( array_spec_init_c                    )) ||  /* does not seem to be necessary */
-          (typeid( *(decl) ) == typeid( structure_type_declaration_c         )) ||  
-          (typeid( *(decl) ) == typeid( structure_element_declaration_list_c )) ||
-//        (typeid( *(decl) ) == typeid( structure_type_declaration_c         )) ||  /* does not seem to be necessary */
-          (typeid( *(decl) ) == typeid( initialized_structure_c              )) ||
+  return ((decl->kind == kind_array_specification_c                ) ||
+//        (decl->kind == kind_array_spec_init_c                    ) ||  /* does not seem to be necessary */
+          (decl->kind == kind_structure_type_declaration_c         ) ||  
+          (decl->kind == kind_structure_element_declaration_list_c ) ||
+//        (decl->kind == kind_structure_type_declaration_c         ) ||  /* does not seem to be necessary */
+          (decl->kind == kind_initialized_structure_c              ) ||
           (search_base_type_c::type_is_fb(decl) && current_vartype == external_vt)
          );
 }
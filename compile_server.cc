@@ -0,0 +1,194 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Compile server. See compile_server.hh for a description.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <string>
+#include <vector>
+
+#include "compile_server.hh"
+
+
+#define MAX_REQUEST_LEN 65536
+
+
+
+/* Read the request line. Returns false if the connection was closed before the end of the line. */
+static bool read_request(int fd, std::string &request) {
+  char c;
+  request.clear();
+  while (request.size() < MAX_REQUEST_LEN) {
+    ssize_t res = read(fd, &c, 1);
+    if ((res < 0) && (errno == EINTR)) continue;
+    if (res <= 0)   return false;
+    if (c == '\n')  return true;
+    if (c != '\r')  request += c;
+  }
+  return false;
+}
+
+
+static void write_all(int fd, const char *buf, size_t len) {
+  while (len > 0) {
+    ssize_t res = write(fd, buf, len);
+    if ((res < 0) && (errno == EINTR)) continue;
+    if (res <= 0) return;
+    buf += res;
+    len -= res;
+  }
+}
+
+
+
+/* Runs the compilation in its own process, with stdout and stderr redirected to the client. */
+static int run_request(int client_fd, std::string &request, compile_request_handler_t handler) {
+  /* split the request into arguments, separated by tabs */
+  std::vector<char *> argv;
+  argv.push_back((char *)"iec2c");
+  size_t start = 0;
+  while (start <= request.size()) {
+    size_t end = request.find('\t', start);
+    if (end == std::string::npos) end = request.size();
+    if (end > start)
+      argv.push_back(strdup(request.substr(start, end - start).c_str()));
+    start = end + 1;
+  }
+  argv.push_back(NULL);
+
+  fflush(stdout);
+  fflush(stderr);
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("fork()");
+    return EXIT_FAILURE;
+  }
+  if (pid == 0) {
+    /* child process */
+    dup2(client_fd, STDOUT_FILENO);
+    dup2(client_fd, STDERR_FILENO);
+    close(client_fd);
+    int status = handler(argv.size() - 1, &argv[0]);
+    fflush(stdout);
+    fflush(stderr);
+    /* NOTE: exit() and not _exit(), so the files being generated are closed (flushed) by the destructors. */
+    exit(status);
+  }
+
+  int status;
+  while (waitpid(pid, &status, 0) < 0)
+    if (errno != EINTR) return EXIT_FAILURE;
+  if (WIFEXITED(status))   return WEXITSTATUS(status);
+  if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+  return EXIT_FAILURE;
+}
+
+
+/* Handles one connection, in a process of its own (so several requests may be handled simultaneously). */
+static void handle_connection(int client_fd, compile_request_handler_t handler) {
+  std::string request;
+  int status = EXIT_FAILURE;
+
+  if (read_request(client_fd, request))
+    status = run_request(client_fd, request, handler);
+  else
+    write_all(client_fd, "Invalid request\n", strlen("Invalid request\n"));
+
+  char buf[64];
+  snprintf(buf, sizeof(buf), "\n%s %d\n", COMPILE_SERVER_STATUS_LINE, status);
+  write_all(client_fd, buf, strlen(buf));
+  close(client_fd);
+}
+
+
+
+int compile_server(const char *socket_path, compile_request_handler_t handler) {
+  struct sockaddr_un addr;
+
+  if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "Socket path too long: %s\n", socket_path);
+    return EXIT_FAILURE;
+  }
+
+  int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server_fd < 0) {perror("socket()"); return EXIT_FAILURE;}
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socket_path);
+  unlink(socket_path);  /* left behind by a previous server */
+  if (bind(server_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {perror("bind()");   return EXIT_FAILURE;}
+  if (listen(server_fd, 16) < 0)                                   {perror("listen()"); return EXIT_FAILURE;}
+
+  /* the connection handling processes are never waited for */
+  signal(SIGCHLD, SIG_IGN);
+  /* a client that closes the connection early must not kill the server */
+  signal(SIGPIPE, SIG_IGN);
+  fprintf(stdout, "Compile server listening on %s\n", socket_path);
+  fflush(stdout);
+
+  while (true) {
+    int client_fd = accept(server_fd, NULL, NULL);
+    if (client_fd < 0) {
+      if (errno == EINTR) continue;
+      perror("accept()");
+      return EXIT_FAILURE;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork()");
+    } else if (pid == 0) {
+      /* connection handling process */
+      close(server_fd);
+      signal(SIGCHLD, SIG_DFL);  /* so we may wait for the compilation process */
+      handle_connection(client_fd, handler);
+      _exit(0);
+    }
+    close(client_fd);
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,76 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Compile server.
+ *
+ *  Parsing the standard library is a large part of the time it takes to
+ *  compile a small program. The compile server parses the library once,
+ *  and then waits for compile requests on a local (unix domain) socket.
+ *
+ *  Each request is handled by a child process (created with fork()) that
+ *  already holds the parsed library, so it only needs to parse the input file.
+ *  Since the compiler keeps its state in global variables (the symbol tables,
+ *  the options, ...), and bails out with exit() on any error, running each
+ *  request in its own process is what guarantees that a request can never
+ *  change the state seen by the following requests.
+ *
+ *  Protocol (one request per connection):
+ *    - the client sends a single line, with the command line arguments of the
+ *      request (the same as would be given to the compiler) separated by tabs:
+ *          [-T <target_directory>] [-O <output_options>] [-C <cache_directory>] <input_file>
+ *    - the server replies with everything the compiler prints (the names
+ *      of the generated files, error messages, ...), followed by a last line
+ *          COMPILE_SERVER_STATUS_LINE <exit status>
+ *    - and closes the connection.
+ *  Relative paths are relative to the working directory of the server!
+ */
+
+
+#ifndef _COMPILE_SERVER_HH
+#define _COMPILE_SERVER_HH
+
+
+#define COMPILE_SERVER_STATUS_LINE "iec2c exit status:"
+
+
+/* Called (in the child process) to handle each request. Receives the request's
+ * arguments in argc/argv (argv[0] is the name of the compiler), and returns the exit status.
+ */
+typedef int (*compile_request_handler_t)(int argc, char **argv);
+
+/* Only returns on error (returning EXIT_FAILURE). */
+int compile_server(const char *socket_path, compile_request_handler_t handler);
+
+
+#endif /* _COMPILE_SERVER_HH */
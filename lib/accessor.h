@@ -3,9 +3,55 @@
 
 #define __INITIAL_VALUE(...) __VA_ARGS__
 
+/* Where the flags of the variables are kept.
+ *
+ * By default (array of structs layout) the flags of each variable are stored
+ * in the __IEC_<type>_t struct, right after its value.
+ *
+ * With the struct of arrays layout (__IEC_SOA_LAYOUT) the __IEC_<type>_t struct
+ * only holds the value, and:
+ *   - the flags of the variables of a POU instance are kept in its __flags member,
+ *     a struct with one byte per variable, having the same name as the variable
+ *     (e.g. the flags of data__->IN are in data__->__flags.IN);
+ *   - the flags of a global variable <domain>__<name> are kept in <domain>__<name>__flags.
+ * The flags of external and located variables (__IEC_<type>_p) are not affected.
+ */
+#ifdef __IEC_SOA_LAYOUT
+#define __FLAGS(prefix, name) prefix __flags.name
+#else
+#define __FLAGS(prefix, name) prefix name.flags
+#endif
+
 // variable declaration macros
 #define __DECLARE_VAR(type, name)\
 	__IEC_##type##_t name;
+#ifdef __IEC_SOA_LAYOUT
+#define __DECLARE_FLAGS_BEGIN\
+	struct {
+#define __DECLARE_VAR_FLAGS(name)\
+	IEC_BYTE name;
+#define __DECLARE_SFC_FLAGS(nb_steps, nb_actions, nb_transitions)\
+	struct {IEC_BYTE state;} __step_list[nb_steps];\
+	struct {IEC_BYTE state;} __action_list[nb_actions];\
+	IEC_BYTE __transition_list[nb_transitions];\
+	IEC_BYTE __debug_transition_list[nb_transitions];
+#define __DECLARE_FLAGS_END\
+	} __flags;
+#define __DECLARE_GLOBAL(type, domain, name)\
+	__IEC_##type##_t domain##__##name;\
+	IEC_BYTE domain##__##name##__flags;\
+	static __IEC_##type##_t *GLOBAL__##name = &(domain##__##name);\
+	static IEC_BYTE *GLOBAL__##name##__flags = &(domain##__##name##__flags);\
+	void __INIT_GLOBAL_##name(type value) {\
+		(*GLOBAL__##name).value = value;\
+	}\
+	IEC_BYTE __IS_GLOBAL_##name##_FORCED(void) {\
+		return (*GLOBAL__##name##__flags) & __IEC_FORCE_FLAG;\
+	}\
+	type* __GET_GLOBAL_##name(void) {\
+		return &((*GLOBAL__##name).value);\
+	}
+#else
 #define __DECLARE_GLOBAL(type, domain, name)\
 	__IEC_##type##_t domain##__##name;\
 	static __IEC_##type##_t *GLOBAL__##name = &(domain##__##name);\
@@ -18,6 +64,7 @@
 	type* __GET_GLOBAL_##name(void) {\
 		return &((*GLOBAL__##name).value);\
 	}
+#endif
 #define __DECLARE_GLOBAL_FB(type, domain, name)\
 	type domain##__##name;\
 	static type *GLOBAL__##name = &(domain##__##name);\
@@ -47,20 +94,40 @@
 	type* name;
 #define __DECLARE_LOCATED(type, name)\
 	__IEC_##type##_p name;
+/* Inputs of a FB passed by reference (see the 'inputs-by-ref' option of iec2c):
+ * the FB reads the input through name##__ref, pointing either to the variable
+ * the caller passed to the input, or to the value of the input itself.
+ * NOTE: while the input is bound to the caller's variable, its value in the FB
+ *       instance is not updated, so the debugger (and anything else reading the
+ *       instance, e.g. through VARIABLES.csv) shows a stale value for the input.
+ */
+#define __DECLARE_INPUT_REF(type, name)\
+	type *name##__ref;
 
 
 // variable initialization macros
+#define __INIT_RETAIN_FLAGS(flags, retained)\
+    flags |= retained?__IEC_RETAIN_FLAG:0;
 #define __INIT_RETAIN(name, retained)\
-    name.flags |= retained?__IEC_RETAIN_FLAG:0;
-#define __INIT_VAR(name, initial, retained)\
-	name.value = initial;\
-	__INIT_RETAIN(name, retained)
+    __INIT_RETAIN_FLAGS(name.flags, retained)
+#define __INIT_VAR(prefix, name, initial, retained)\
+	prefix name.value = initial;\
+	__INIT_RETAIN_FLAGS(__FLAGS(prefix, name), retained)
+#ifdef __IEC_SOA_LAYOUT
+#define __INIT_GLOBAL(type, name, initial, retained)\
+    {\
+	    static const type temp = initial;\
+	    __INIT_GLOBAL_##name(temp);\
+	    __INIT_RETAIN_FLAGS((*GLOBAL__##name##__flags), retained)\
+    }
+#else
 #define __INIT_GLOBAL(type, name, initial, retained)\
     {\
 	    static const type temp = initial;\
 	    __INIT_GLOBAL_##name(temp);\
 	    __INIT_RETAIN((*GLOBAL__##name), retained)\
     }
+#endif
 #define __INIT_GLOBAL_FB(type, name, retained)\
 	type##_init__(&(*GLOBAL__##name), retained);
 #define __INIT_GLOBAL_LOCATED(domain, name, location, retained)\
@@ -81,29 +148,38 @@
     }
 #define __INIT_LOCATED_VALUE(name, initial)\
 	*(name.value) = initial;
+#define __RESET_INPUT_REF(prefix, name)\
+	prefix name##__ref = &(prefix name.value)
 
 
 // variable getting macros
+/* NOTE: while an external or located variable is forced, its value pointer points
+ *       to the forced value (see iec_force.h), so it is read like any other.
+ */
 #define __GET_VAR(name, ...)\
 	name.value __VA_ARGS__
 #define __GET_EXTERNAL(name, ...)\
-	((name.flags & __IEC_FORCE_FLAG) ? name.fvalue __VA_ARGS__ : (*(name.value)) __VA_ARGS__)
+	((*(name.value)) __VA_ARGS__)
 #define __GET_EXTERNAL_FB(name, ...)\
 	__GET_VAR(((*name) __VA_ARGS__))
 #define __GET_LOCATED(name, ...)\
-	((name.flags & __IEC_FORCE_FLAG) ? name.fvalue __VA_ARGS__ : (*(name.value)) __VA_ARGS__)
+	((*(name.value)) __VA_ARGS__)
 #define __GET_VAR_BY_REF(name, ...)\
-	((name.flags & __IEC_FORCE_FLAG) ? &(name.fvalue __VA_ARGS__) : &(name.value __VA_ARGS__))
+	&(name.value __VA_ARGS__)
 #define __GET_EXTERNAL_BY_REF(name, ...)\
-	((name.flags & __IEC_FORCE_FLAG) ? &(name.fvalue __VA_ARGS__) : &((*(name.value)) __VA_ARGS__))
+	&((*(name.value)) __VA_ARGS__)
 #define __GET_EXTERNAL_FB_BY_REF(name, ...)\
 	__GET_EXTERNAL_BY_REF(((*name) __VA_ARGS__))
 #define __GET_LOCATED_BY_REF(name, ...)\
-	((name.flags & __IEC_FORCE_FLAG) ? &(name.fvalue __VA_ARGS__) : &((*(name.value)) __VA_ARGS__))
+	&((*(name.value)) __VA_ARGS__)
+#define __GET_INPUT_REF(name, ...)\
+	((*(name##__ref)) __VA_ARGS__)
+#define __GET_INPUT_REF_BY_REF(name, ...)\
+	&((*(name##__ref)) __VA_ARGS__)
 
 // variable setting macros
 #define __SET_VAR(prefix, name, new_value, ...)\
-	if (!(prefix name.flags & __IEC_FORCE_FLAG)) prefix name.value __VA_ARGS__ = new_value
+	if (!(__FLAGS(prefix, name) & __IEC_FORCE_FLAG)) prefix name.value __VA_ARGS__ = new_value
 #define __SET_EXTERNAL(prefix, name, new_value, ...)\
 	{extern IEC_BYTE __IS_GLOBAL_##name##_FORCED();\
     if (!(prefix name.flags & __IEC_FORCE_FLAG || __IS_GLOBAL_##name##_FORCED()))\
@@ -112,5 +188,8 @@
 	__SET_VAR((*(prefix name)), __VA_ARGS__, new_value)
 #define __SET_LOCATED(prefix, name, new_value, ...)\
 	if (!(prefix name.flags & __IEC_FORCE_FLAG)) *(prefix name.value) __VA_ARGS__ = new_value
+/* a forced input keeps being read from its own value */
+#define __SET_INPUT_REF(prefix, name, ref)\
+	prefix name##__ref = (__FLAGS(prefix, name) & __IEC_FORCE_FLAG)? &(prefix name.value) : (ref)
 
 #endif //__ACCESSOR_H
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_DEBUG_H
+#define __IEC_DEBUG_H
+
+/* Registry of the debuggable variables, and tracing of their values.
+ *
+ * With 'iec2c -O debug-registry' the compiler also generates VARIABLES.c, holding
+ * the table __IEC_debug_vars[], with one entry per variable:
+ *   - entry i (i < number of variables in VARIABLES.csv) describes the variable
+ *     numbered i in VARIABLES.csv. The entries of FB and program instances have no
+ *     value (ptr is NULL).
+ *   - the following entries describe the elements of the arrays and the members
+ *     of the structures (which are not listed in VARIABLES.csv). An array is a single
+ *     entry, whose elements (in row-major order, starting at the lower bounds) are
+ *     'stride' bytes apart. A member of a structure held in an array is an entry
+ *     with as many elements as the array.
+ * so a debugger finds the address of any value without parsing a path.
+ *
+ * Tracing copies the values of a set of variables into a ring buffer, once per
+ * scan cycle, with a single call from the PLC task:
+ *
+ *   static __IEC_trace_t trace;
+ *   ...
+ *   // debugger thread, while tracing is stopped
+ *   __IEC_trace_clear(&trace);
+ *   __IEC_trace_add(&trace, 12, 0);    // variable 12 of VARIABLES.csv
+ *   __IEC_trace_add(&trace, 40, 3);    // 4th element of entry 40 (an array)
+ *   __IEC_trace_start(&trace);
+ *   ...
+ *   // PLC task, at the end of each cycle
+ *   __IEC_trace_sample(&trace, tick);
+ *   ...
+ *   // debugger thread
+ *   n = __IEC_trace_read(&trace, buffer, max_samples);
+ *   ...
+ *   __IEC_trace_stop(&trace);
+ *
+ * Each sample holds the tick (an unsigned long), followed by the values of the
+ * traced variables in the order they were added, without any padding.
+ * The ring buffer has a single producer (the PLC task) and a single consumer
+ * (the debugger), so it does not need any lock: each side only writes its own
+ * index. When the debugger does not read fast enough, the new samples are
+ * dropped (and counted), the PLC task never waits.
+ * The set of traced variables may only change while the PLC task is not sampling:
+ * __IEC_trace_clear() and __IEC_trace_add() fail between __IEC_trace_start() and
+ * __IEC_trace_stop(), and after __IEC_trace_stop() until the PLC task has seen the
+ * tracing stopped (i.e. its next call to __IEC_trace_sample()).
+ */
+
+#include <string.h>
+#include "iec_types_all.h"
+
+/* Maximum number of variables traced at the same time. */
+#ifndef __IEC_TRACE_MAX_VARS
+#define __IEC_TRACE_MAX_VARS 256
+#endif
+
+/* Size of the ring buffer, in bytes. Must be a power of 2. */
+#ifndef __IEC_TRACE_BUFFER_SIZE
+#define __IEC_TRACE_BUFFER_SIZE 65536
+#endif
+
+/* The indexes are shared by the PLC task and the debugger thread. */
+#if defined(__GNUC__)
+#define __IEC_TRACE_LOAD(index)         __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define __IEC_TRACE_STORE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+#else
+/* good enough on a single core */
+#define __IEC_TRACE_LOAD(index)         (*(volatile unsigned int *)&(index))
+#define __IEC_TRACE_STORE(index, value) (*(volatile unsigned int *)&(index) = (value))
+#endif
+
+typedef struct {
+  const char *name;          /* IEC 61131-3 path, as in VARIABLES.csv */
+  void *ptr;                 /* first element, or the __IEC_<type>_p struct for the <type>_P_ENUM types */
+  __IEC_types_enum type;     /* UNKNOWN_ENUM for values that are not of an elementary type */
+  unsigned int size;         /* of each element */
+  unsigned int count;        /* number of elements */
+  unsigned int stride;       /* distance between the elements, in bytes */
+} __IEC_debug_var_t;
+
+/* Generated in VARIABLES.c */
+extern const __IEC_debug_var_t __IEC_debug_vars[];
+extern const unsigned int __IEC_debug_vars_count;
+
+typedef struct {
+  unsigned int running;      /* written by the debugger only */
+  unsigned int sampling;     /* running, as last seen by the PLC task (written by the PLC task only) */
+  /* set by the debugger, while tracing is stopped */
+  unsigned int count;
+  void *ptr[__IEC_TRACE_MAX_VARS];
+  unsigned int size[__IEC_TRACE_MAX_VARS];
+  unsigned char indirect[__IEC_TRACE_MAX_VARS];
+  unsigned int sample_size;
+  /* the ring buffer */
+  unsigned int head;         /* written by the PLC task only */
+  unsigned int tail;         /* written by the debugger only */
+  unsigned int dropped;      /* samples that did not fit in the buffer */
+  unsigned char buffer[__IEC_TRACE_BUFFER_SIZE];
+} __IEC_trace_t;
+
+
+/* Whether the entry points to a __IEC_<type>_p struct, and not to the value itself. */
+static inline int __IEC_debug_var_is_pointer(const __IEC_debug_var_t *var) {
+  switch (var->type) {
+#define __decl_pointer_case(TYPENAME) case TYPENAME##_P_ENUM:
+    __ANY(__decl_pointer_case)
+#undef __decl_pointer_case
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+/* Address of an element of a registry entry, or NULL. */
+static inline void *__IEC_debug_var_ptr(const __IEC_debug_var_t *var, unsigned int element) {
+  if (var->ptr == NULL || element >= var->count)
+    return NULL;
+  if (__IEC_debug_var_is_pointer(var))
+    /* follow the pointer of the __IEC_<type>_p struct (forcing may change it) */
+    return *(void **)var->ptr;
+  return (unsigned char *)var->ptr + element * var->stride;
+}
+
+
+/* Whether the PLC task may be sampling, so the traced variables may not change. */
+static inline int __IEC_trace_is_running(__IEC_trace_t *trace) {
+  return __IEC_TRACE_LOAD(trace->running) || __IEC_TRACE_LOAD(trace->sampling);
+}
+
+/* Called by the debugger: the PLC task samples the traced variables from its next cycle on. */
+static inline void __IEC_trace_start(__IEC_trace_t *trace) {
+  __IEC_TRACE_STORE(trace->running, 1);
+}
+
+/* Called by the debugger: the PLC task stops sampling from its next cycle on. */
+static inline void __IEC_trace_stop(__IEC_trace_t *trace) {
+  __IEC_TRACE_STORE(trace->running, 0);
+}
+
+/* Stops tracing all variables, and empties the ring buffer.
+ * Returns 0 (and does nothing) if tracing is running.
+ */
+static inline int __IEC_trace_clear(__IEC_trace_t *trace) {
+  if (__IEC_trace_is_running(trace))
+    return 0;
+  trace->count = 0;
+  trace->sample_size = sizeof(unsigned long);
+  trace->dropped = 0;
+  __IEC_TRACE_STORE(trace->tail, __IEC_TRACE_LOAD(trace->head));
+  return 1;
+}
+
+/* Adds an element of the registry entry 'index' to the traced variables.
+ * Returns 0 if tracing is running, the entry has no such element, or too many
+ * variables are traced.
+ */
+static inline int __IEC_trace_add(__IEC_trace_t *trace, unsigned int index, unsigned int element) {
+  const __IEC_debug_var_t *var;
+  unsigned int n = trace->count;
+
+  if (__IEC_trace_is_running(trace))
+    return 0;
+  if (index >= __IEC_debug_vars_count || n >= __IEC_TRACE_MAX_VARS)
+    return 0;
+  var = &__IEC_debug_vars[index];
+  if (__IEC_debug_var_ptr(var, element) == NULL)
+    return 0;
+  if (trace->sample_size + var->size > __IEC_TRACE_BUFFER_SIZE / 2)
+    return 0;
+  trace->indirect[n] = __IEC_debug_var_is_pointer(var);
+  trace->ptr[n] = trace->indirect[n]? var->ptr : __IEC_debug_var_ptr(var, element);
+  trace->size[n] = var->size;
+  trace->sample_size += var->size;
+  trace->count = n + 1;
+  return 1;
+}
+
+
+static inline void __IEC_trace_write(__IEC_trace_t *trace, unsigned int pos, const void *data, unsigned int size) {
+  unsigned int start = pos & (__IEC_TRACE_BUFFER_SIZE - 1);
+  unsigned int first = __IEC_TRACE_BUFFER_SIZE - start;
+  if (first > size) first = size;
+  memcpy(&trace->buffer[start], data, first);
+  memcpy(&trace->buffer[0], (const unsigned char *)data + first, size - first);
+}
+
+/* Called by the PLC task once per cycle: appends the current values of the traced
+ * variables to the ring buffer, if tracing is running.
+ */
+static inline void __IEC_trace_sample(__IEC_trace_t *trace, unsigned long tick) {
+  unsigned int head = trace->head;
+  unsigned int running = __IEC_TRACE_LOAD(trace->running);
+  unsigned int i;
+
+  /* tell the debugger we have seen the tracing started or stopped */
+  if (running != trace->sampling)
+    __IEC_TRACE_STORE(trace->sampling, running);
+  if (!running || trace->count == 0)
+    return;
+  if (head - __IEC_TRACE_LOAD(trace->tail) + trace->sample_size > __IEC_TRACE_BUFFER_SIZE) {
+    trace->dropped++;
+    return;
+  }
+  __IEC_trace_write(trace, head, &tick, sizeof(tick));
+  head += sizeof(tick);
+  for (i = 0; i < trace->count; i++) {
+    const void *value = trace->indirect[i]? *(void **)trace->ptr[i] : trace->ptr[i];
+    __IEC_trace_write(trace, head, value, trace->size[i]);
+    head += trace->size[i];
+  }
+  __IEC_TRACE_STORE(trace->head, head);
+}
+
+/* Called by the debugger: moves at most max_samples samples from the ring buffer
+ * to buf (which must hold max_samples * trace->sample_size bytes).
+ * Returns the number of samples read.
+ */
+static inline unsigned int __IEC_trace_read(__IEC_trace_t *trace, void *buf, unsigned int max_samples) {
+  unsigned int tail = trace->tail;
+  unsigned int available, size, start, first;
+
+  if (trace->count == 0)
+    return 0;
+  available = (__IEC_TRACE_LOAD(trace->head) - tail) / trace->sample_size;
+  if (available > max_samples)
+    available = max_samples;
+  size  = available * trace->sample_size;
+  start = tail & (__IEC_TRACE_BUFFER_SIZE - 1);
+  first = __IEC_TRACE_BUFFER_SIZE - start;
+  if (first > size) first = size;
+  memcpy(buf, &trace->buffer[start], first);
+  memcpy((unsigned char *)buf + first, &trace->buffer[0], size - first);
+  __IEC_TRACE_STORE(trace->tail, tail + size);
+  return available;
+}
+
+#endif //__IEC_DEBUG_H
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_FAST_MATH_H
+#define __IEC_FAST_MATH_H
+
+/* Fast single precision math functions, used by the REAL versions of the standard
+ * functions of Table 23 (SQRT, LN, LOG, EXP, SIN, COS, TAN, ASIN, ACOS, ATAN) when
+ * the generated code is compiled with __IEC_FAST_MATH defined (see iec_std_lib.h).
+ *
+ * They are short polynomial approximations, without calls nor loops, that the C
+ * compiler inlines instead of calling the libm functions, which must handle every
+ * corner case. Loops calling them are vectorised by gcc with
+ *     -O3 -fno-math-errno -fno-trapping-math
+ * (but do NOT use -ffast-math, or -fassociative-math, as it breaks the argument
+ * reductions and __fast_roundf()). In exchange:
+ *   - errno is never set;
+ *   - the results may be off by a few units in the last place (ulp) of the result.
+ *     The largest errors measured over the domains given below (see
+ *     tests/benchmarks/fast_math.sh) are:
+ *         __fast_sqrtf   0.5 ulp  (this is sqrtf(), a single instruction on most FPUs)
+ *         __fast_expf    3 ulp    x in [-87.3, 88.7]; below that 0 is returned (no subnormal results)
+ *         __fast_logf    3 ulp    x > 0 and not subnormal; 0 gives -inf, x < 0 gives NaN
+ *         __fast_log10f  4 ulp    as __fast_logf
+ *         __fast_sinf    1.5e-7   (absolute error) |x| <= 8192
+ *         __fast_cosf    1.5e-7   (absolute error) |x| <= 8192
+ *         __fast_tanf    4 ulp    |x| <= 1.55. Beyond that the error of the argument
+ *                                 reduction is amplified near the poles.
+ *         __fast_atanf   3 ulp
+ *         __fast_asinf   4 ulp    x in [-1, 1]
+ *         __fast_acosf   4 ulp    x in [-1, 1]
+ *     The trigonometric functions of larger arguments lose accuracy in the argument
+ *     reduction.
+ *   - NaN and infinite arguments give NaN or infinite results, as for libm,
+ *     except where noted above.
+ */
+
+#include <math.h>
+#include <stdint.h>
+
+
+typedef union {float f; uint32_t i;} __fast_math_bits_t;
+
+/* x rounded to the nearest integer, for |x| < 2**22 (unlike nearbyintf(), this does not
+ * need a call nor SSE4.1; it does however need the C compiler to keep the order of the
+ * operations, i.e. not to be called with -ffast-math or -fassociative-math)
+ */
+static inline float __fast_roundf(float x) {return (x + 12582912.0f) - 12582912.0f;}
+
+
+static inline float __fast_sqrtf(float x) {return sqrtf(x);}
+
+
+/* 2 ** k, for k in [-126, 127] */
+static inline float __fast_pow2i(int32_t k) {
+  __fast_math_bits_t u;
+  u.i = (uint32_t)(k + 127) << 23;
+  return u.f;
+}
+
+
+static inline float __fast_expf(float x) {
+  /* e ** x = 2 ** k * e ** r, with k = round(x / ln 2) and |r| <= ln(2)/2 */
+  float xc = (x > 88.7f)? 88.7f : ((x < -87.3f)? -87.3f : x);
+  float fk = __fast_roundf(xc * 1.44269504088896341f);
+  float r  = (xc - fk * 0.693145751953125f) - fk * 1.42860682030941723212e-6f;
+  float p  = 1.0f + r * (1.0f + r * (0.5f + r * (1.66666672e-1f + r * (4.16666679e-2f + r * (8.33333377e-3f + r * 1.38888892e-3f)))));
+  int32_t k = (int32_t)fk;
+  /* 2 ** 128 is not representable as a float: scale in two steps */
+  float res = p * __fast_pow2i(k - (k > 0)) * ((k > 0)? 2.0f : 1.0f);
+  if (x >  88.7f) res = HUGE_VALF;  /* overflow */
+  if (x < -87.3f) res = 0.0f;       /* underflow (or subnormal) */
+  if (x != x)     res = x;          /* NaN */
+  return res;
+}
+
+
+static inline float __fast_logf(float x) {
+  /* x = 2 ** e * m, with m in [sqrt(2)/2, sqrt(2)[
+   * ln(x) = e * ln(2) + ln(m), ln(m) = 2 * atanh(s), with s = (m - 1) / (m + 1) and |s| <= 0.172
+   */
+  __fast_math_bits_t u;
+  u.f = x;
+  int32_t e = (int32_t)((u.i >> 23) & 0xff) - 127;
+  u.i = (u.i & 0x007fffff) | 0x3f800000;        /* m in [1, 2[ */
+  float m = u.f;
+  if (m > 1.41421356f) {m *= 0.5f; e++;}
+  float s  = (m - 1.0f) / (m + 1.0f);
+  float s2 = s * s;
+  float p  = 2.0f * s * (1.0f + s2 * (3.33333343e-1f + s2 * (2.00000003e-1f + s2 * (1.42857149e-1f + s2 * 1.11111112e-1f))));
+  float res = (float)e * 0.693145751953125f + (p + (float)e * 1.42860682030941723212e-6f);
+  if (x == 0.0f)      res = -HUGE_VALF;
+  if (x <  0.0f)      res = NAN;
+  if (x == HUGE_VALF) res = x;
+  if (x != x)         res = x;
+  return res;
+}
+
+
+static inline float __fast_log10f(float x) {return __fast_logf(x) * 0.434294481903251828f;}
+
+
+/* sin(r) and cos(r), for |r| <= pi/4 */
+static inline float __fast_sin_poly(float r) {
+  float z = r * r;
+  return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+static inline float __fast_cos_poly(float r) {
+  float z = r * r;
+  return 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+}
+
+/* x = k * pi/2 + r, with |r| <= pi/4. pi/2 is split in 3 parts, so that k * pi/2 is exact for |k| < 2**13 */
+static inline float __fast_reduce(float x, int32_t *k) {
+  float fk = __fast_roundf(x * 0.636619772367581343f);
+  *k = (int32_t)fk;
+  return ((x - fk * 1.5703125f) - fk * 4.837512969970703125e-4f) - fk * 7.54978995489188216e-8f;
+}
+
+static inline float __fast_sinf(float x) {
+  int32_t k;
+  float r = __fast_reduce(x, &k);
+  float res = (k & 1)? __fast_cos_poly(r) : __fast_sin_poly(r);
+  return (k & 2)? -res : res;
+}
+
+static inline float __fast_cosf(float x) {
+  int32_t k;
+  float r = __fast_reduce(x, &k);
+  float res = (k & 1)? __fast_sin_poly(r) : __fast_cos_poly(r);
+  return ((k + 1) & 2)? -res : res;
+}
+
+static inline float __fast_tanf(float x) {
+  int32_t k;
+  float r = __fast_reduce(x, &k);
+  float s = __fast_sin_poly(r);
+  float c = __fast_cos_poly(r);
+  return (k & 1)? -c / s : s / c;
+}
+
+
+static inline float __fast_atanf(float x) {
+  /* atan(x) = pi/2 - atan(1/x)              for |x| > 1
+   * atan(a) = pi/4 + atan((a - 1)/(a + 1))  for a in ]tan(pi/8), 1]
+   */
+  float a = fabsf(x);
+  int big = (a > 1.0f);
+  if (big) a = 1.0f / a;
+  int mid = (a > 0.414213562f);
+  float t = mid? (a - 1.0f) / (a + 1.0f) : a;
+  float z = t * t;
+  float res = t + t * z * (-3.33329491539e-1f + z * (1.99777106478e-1f + z * (-1.38776856032e-1f + z * 8.05374449538e-2f)));
+  if (mid) res += 0.785398163397448310f;
+  if (big) res = 1.57079632679489662f - res;
+  return (x < 0.0f)? -res : res;
+}
+
+static inline float __fast_asinf(float x) {return __fast_atanf(x / sqrtf((1.0f - x) * (1.0f + x)));}
+static inline float __fast_acosf(float x) {return 2.0f * __fast_atanf(sqrtf((1.0f - x) / (1.0f + x)));}
+
+
+#endif /* __IEC_FAST_MATH_H */
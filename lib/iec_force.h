@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_FORCE_H
+#define __IEC_FORCE_H
+
+/* Forcing of external and located variables (__IEC_<type>_p).
+ *
+ * Only a handful of variables are ever forced at the same time, so the forced
+ * values are not kept in every __IEC_<type>_p struct, but in a table owned by
+ * the runtime (normally by its debugger):
+ *
+ *   static __IEC_force_table_t force_table;
+ *   ...
+ *   __IEC_force_pointer_var(&force_table, idx, &RES0__INST0.FB1.X, &new_value, sizeof(new_value));
+ *   ...
+ *   __IEC_release_pointer_var(&force_table, idx);
+ *
+ * where idx is the number of the variable in VARIABLES.csv.
+ *
+ * While forced, the value pointer of the variable points to the forced value in
+ * the table (so the generated code reads it without any further test), and the
+ * __IEC_FORCE_FLAG makes the generated code skip the writes to the variable.
+ * The pointer the variable had before being forced is kept in the table entry
+ * (in case the runtime also wants to write the forced value to an output),
+ * and is restored when the variable is released.
+ *
+ * Variables stored in a __IEC_<type>_t struct are forced as before, by writing
+ * the value in place and setting the __IEC_FORCE_FLAG.
+ */
+
+#include <string.h>
+#include "iec_types_all.h"
+
+/* Maximum number of variables forced at the same time. Must be a power of 2. */
+#ifndef __IEC_FORCE_TABLE_SIZE
+#define __IEC_FORCE_TABLE_SIZE 64
+#endif
+
+/* Maximum size of a forced value. */
+#ifndef __IEC_FORCED_VALUE_SIZE
+#define __IEC_FORCED_VALUE_SIZE sizeof(IEC_STRING)
+#endif
+
+/* The members common to every __IEC_<type>_p struct */
+typedef struct {
+  void *value;
+  IEC_BYTE flags;
+} __IEC_pointer_var_t;
+
+typedef enum {
+  __IEC_FORCE_ENTRY_FREE = 0,
+  __IEC_FORCE_ENTRY_USED,
+  __IEC_FORCE_ENTRY_DELETED   /* free, but the search for other entries must go on */
+} __IEC_force_entry_state_t;
+
+typedef struct {
+  __IEC_force_entry_state_t state;
+  unsigned int index;          /* number of the variable */
+  __IEC_pointer_var_t *var;
+  void *value;                 /* pointer of the variable before it was forced */
+  union {
+    IEC_LWORD lword;           /* just for the alignment */
+    IEC_LREAL lreal;
+    IEC_BYTE  bytes[__IEC_FORCED_VALUE_SIZE];
+  } fvalue;
+} __IEC_forced_var_t;
+
+/* A zero initialised table is empty. */
+typedef struct {
+  unsigned int count;
+  __IEC_forced_var_t entries[__IEC_FORCE_TABLE_SIZE];
+} __IEC_force_table_t;
+
+
+/* Returns the entry of the variable, or NULL if it is not forced. */
+static inline __IEC_forced_var_t *__IEC_find_forced_var(__IEC_force_table_t *table, unsigned int index) {
+  unsigned int i, slot;
+  for (i = 0; i < __IEC_FORCE_TABLE_SIZE; i++) {
+    slot = (index + i) & (__IEC_FORCE_TABLE_SIZE - 1);
+    if (table->entries[slot].state == __IEC_FORCE_ENTRY_FREE)
+      return NULL;
+    if (table->entries[slot].state == __IEC_FORCE_ENTRY_USED && table->entries[slot].index == index)
+      return &table->entries[slot];
+  }
+  return NULL;
+}
+
+/* Forces the variable (or changes the value it is forced to).
+ * Returns 0 if the value is too large, or too many variables are already forced.
+ */
+static inline int __IEC_force_pointer_var(__IEC_force_table_t *table, unsigned int index, void *var, const void *value, size_t size) {
+  __IEC_forced_var_t *entry = __IEC_find_forced_var(table, index);
+  unsigned int i;
+
+  if (size > __IEC_FORCED_VALUE_SIZE)
+    return 0;
+  for (i = 0; entry == NULL && i < __IEC_FORCE_TABLE_SIZE; i++) {
+    __IEC_forced_var_t *slot = &table->entries[(index + i) & (__IEC_FORCE_TABLE_SIZE - 1)];
+    if (slot->state != __IEC_FORCE_ENTRY_USED) {
+      entry = slot;
+      entry->state = __IEC_FORCE_ENTRY_USED;
+      entry->index = index;
+      entry->var = (__IEC_pointer_var_t *)var;
+      entry->value = entry->var->value;
+      table->count++;
+    }
+  }
+  if (entry == NULL)
+    return 0;
+
+  memcpy(entry->fvalue.bytes, value, size);
+  entry->var->value = entry->fvalue.bytes;
+  entry->var->flags |= __IEC_FORCE_FLAG;
+  return 1;
+}
+
+/* Releases a forced variable. Does nothing if the variable is not forced. */
+static inline void __IEC_release_pointer_var(__IEC_force_table_t *table, unsigned int index) {
+  __IEC_forced_var_t *entry = __IEC_find_forced_var(table, index);
+
+  if (entry == NULL)
+    return;
+  entry->var->flags &= ~__IEC_FORCE_FLAG;
+  entry->var->value = entry->value;
+  entry->state = __IEC_FORCE_ENTRY_DELETED;
+  /* once empty, get rid of the deleted entries, so the searches stay short */
+  if (--table->count == 0)
+    memset(table->entries, 0, sizeof(table->entries));
+}
+
+#endif //__IEC_FORCE_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_IO_EXCHANGE_H
+#define __IEC_IO_EXCHANGE_H
+
+/* Exchange of the process images (see iec_process_image.h) between the PLC and the
+ * I/O driver threads, without any lock.
+ *
+ * Each driver owns one channel per direction, covering a range of bytes of the input
+ * or output image (e.g. the fieldbus the first 100 bytes of the input image, the
+ * local GPIO the next 2). A channel is a triple buffer, with a single producer and
+ * a single consumer: the producer fills its own buffer and then publishes it by
+ * swapping it with the middle buffer; the consumer takes the middle buffer (if a new
+ * one was published since the last time) by swapping it with its own buffer. Neither
+ * side ever waits for the other: the consumer always gets the latest complete buffer
+ * published, and the buffers published in between are simply skipped.
+ *
+ * All the tasks of a configuration are run by config_run__() (each one when the tick
+ * is a multiple of its period), so the PLC side is a single thread:
+ *
+ *   // PLC thread, once per cycle
+ *   __IEC_io_read_inputs(input_channels, input_channels_count);
+ *   __IEC_unpack_input_image();
+ *   config_run__(tick);
+ *   __IEC_pack_output_image();
+ *   __IEC_io_write_outputs(output_channels, output_channels_count);
+ *
+ *   // driver thread
+ *   unsigned char *in = __IEC_io_write_buffer(&input_channels[0]);
+ *   ... read the inputs from the device into in[0 .. size-1] ...
+ *   __IEC_io_publish(&input_channels[0]);
+ *   ...
+ *   const unsigned char *out = __IEC_io_acquire(&output_channels[0]);
+ *   ... write out[0 .. size-1] to the device ...
+ *
+ * so every cycle sees a consistent snapshot of the inputs of each driver, taken when
+ * the cycle starts, and each driver sees the outputs of complete cycles only.
+ * The memory of the buffers (3 * size bytes) is given by the caller, so the channels
+ * may be allocated statically.
+ */
+
+#include <string.h>
+#include "iec_process_image.h"
+
+#if defined(__GNUC__)
+#define __IEC_IO_LOAD(state)            __atomic_load_n(&(state), __ATOMIC_ACQUIRE)
+#define __IEC_IO_EXCHANGE(state, value) __atomic_exchange_n(&(state), (value), __ATOMIC_ACQ_REL)
+#else
+#error "iec_io_exchange.h needs the __atomic builtins of gcc or clang"
+#endif
+
+/* the middle buffer holds a buffer not yet taken by the consumer */
+#define __IEC_IO_FRESH 4
+
+typedef struct {
+  unsigned int offset;          /* in the image */
+  unsigned int size;            /* in bytes */
+  unsigned char *buffers[3];
+  unsigned int state;           /* the index of the middle buffer, | __IEC_IO_FRESH */
+  unsigned int back;            /* owned by the producer */
+  unsigned int front;           /* owned by the consumer */
+  /* statistics */
+  unsigned long published;      /* written by the producer only */
+  unsigned long acquired;       /* written by the consumer only */
+} __IEC_io_channel_t;
+
+
+/* storage must hold 3 * size bytes. Call before the producer and consumer threads start. */
+static inline void __IEC_io_channel_init(__IEC_io_channel_t *channel, unsigned int offset, unsigned int size, void *storage) {
+  unsigned int i;
+  channel->offset = offset;
+  channel->size = size;
+  for (i = 0; i < 3; i++)
+    channel->buffers[i] = (unsigned char *)storage + i * size;
+  memset(storage, 0, 3 * size);
+  channel->back = 0;
+  channel->state = 1;
+  channel->front = 2;
+  channel->published = 0;
+  channel->acquired = 0;
+}
+
+/* Producer: the buffer to fill before calling __IEC_io_publish(). */
+static inline unsigned char *__IEC_io_write_buffer(__IEC_io_channel_t *channel) {
+  return channel->buffers[channel->back];
+}
+
+/* Producer: makes the buffer filled available to the consumer. */
+static inline void __IEC_io_publish(__IEC_io_channel_t *channel) {
+  channel->back = __IEC_IO_EXCHANGE(channel->state, channel->back | __IEC_IO_FRESH) & 3;
+  channel->published++;
+}
+
+/* Consumer: the latest buffer published, which stays unchanged until the next call. */
+static inline const unsigned char *__IEC_io_acquire(__IEC_io_channel_t *channel) {
+  if (__IEC_IO_LOAD(channel->state) & __IEC_IO_FRESH) {
+    channel->front = __IEC_IO_EXCHANGE(channel->state, channel->front) & 3;
+    channel->acquired++;
+  }
+  return channel->buffers[channel->front];
+}
+
+/* Consumer: whether a buffer was published since the last __IEC_io_acquire(). */
+static inline int __IEC_io_fresh(__IEC_io_channel_t *channel) {
+  return (__IEC_IO_LOAD(channel->state) & __IEC_IO_FRESH) != 0;
+}
+
+
+/* PLC: copies the latest inputs published by each driver into the input image. */
+static inline void __IEC_io_read_inputs(__IEC_io_channel_t *channels, unsigned int count) {
+  unsigned int i;
+  for (i = 0; i < count; i++)
+    if (__IEC_io_fresh(&channels[i]))
+      memcpy((unsigned char *)__IEC_input_image + channels[i].offset,
+             __IEC_io_acquire(&channels[i]), channels[i].size);
+}
+
+/* PLC: publishes the output image to each driver. */
+static inline void __IEC_io_write_outputs(__IEC_io_channel_t *channels, unsigned int count) {
+  unsigned int i;
+  for (i = 0; i < count; i++) {
+    memcpy(__IEC_io_write_buffer(&channels[i]),
+           (unsigned char *)__IEC_output_image + channels[i].offset, channels[i].size);
+    __IEC_io_publish(&channels[i]);
+  }
+}
+
+
+/* A stand-in driver, for tests and simulations: copies the outputs of the 'output'
+ * channel back to the inputs of the 'input' channel (i.e. %QX0.0 is read back
+ * in %IX0.0 when both channels have the same size). Call it from the driver thread.
+ * Returns 1 if new outputs were looped back.
+ */
+static inline int __IEC_io_loopback(__IEC_io_channel_t *input, __IEC_io_channel_t *output) {
+  unsigned int size = (input->size < output->size)? input->size : output->size;
+  if (!__IEC_io_fresh(output))
+    return 0;
+  memcpy(__IEC_io_write_buffer(input), __IEC_io_acquire(output), size);
+  __IEC_io_publish(input);
+  return 1;
+}
+
+#endif //__IEC_IO_EXCHANGE_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_PROCESS_IMAGE_H
+#define __IEC_PROCESS_IMAGE_H
+
+/* Process images of the located variables.
+ *
+ * With 'iec2c -O process-image' the compiler also generates PROCESS_IMAGE.c, which
+ * defines the located variables listed in LOCATED_VARIABLES.h (so the runtime must
+ * no longer define them itself). Instead of each having storage of its own, they are
+ * laid out in three contiguous images, one per kind of location:
+ *     __IEC_input_image    %I
+ *     __IEC_output_image   %Q
+ *     __IEC_memory_image   %M
+ * Each image holds, in this order and sorted by address within each group, the
+ * %xL, %xD, %xW and %xB locations (8, 4, 2 and 1 bytes, so each one is aligned to
+ * its size), followed by the %xX bits, packed 8 per byte: the bits whose addresses
+ * only differ by the last number (e.g. %IX2.0 to %IX2.15) share consecutive bytes,
+ * bit n being bit n%8 of the (n/8)th byte.
+ * The generated code keeps reading and writing the BOOL variables one byte each, so
+ * the bits of the input image are copied into them by __IEC_unpack_input_image(),
+ * and the bits of the output image are set from them by __IEC_pack_output_image().
+ * The %MX bits, which are not exchanged with any driver, are not packed: they are
+ * stored one byte each in the memory image, after the %MB locations.
+ * (The STRING and WSTRING located variables are not part of any image.)
+ *
+ * A scan cycle then becomes
+ *
+ *   memcpy(__IEC_input_image, inputs_from_driver, __IEC_input_image_size);
+ *   __IEC_unpack_input_image();
+ *   config_run__(tick);
+ *   __IEC_pack_output_image();
+ *   memcpy(outputs_to_driver, __IEC_output_image, __IEC_output_image_size);
+ *
+ * The position of each location in its image is listed in __IEC_input_locations[],
+ * __IEC_output_locations[] and __IEC_memory_locations[], sorted as in the image.
+ */
+
+#include "iec_types_all.h"
+
+/* The bit of a BOOL located variable */
+typedef struct {
+  unsigned int byte;            /* offset in the image */
+  unsigned char bit;            /* 0 (least significant) to 7 */
+} __IEC_image_bit_t;
+
+typedef struct {
+  const char *location;         /* e.g. "%IX2.3" */
+  unsigned int offset;          /* in the image, in bytes */
+  unsigned char bit;            /* for the %xX locations only */
+  unsigned char size;           /* in bytes, 0 for the packed %IX and %QX bits */
+} __IEC_image_location_t;
+
+/* Generated in PROCESS_IMAGE.c. The images are arrays of LWORD only for the alignment. */
+extern IEC_LWORD __IEC_input_image[];
+extern IEC_LWORD __IEC_output_image[];
+extern IEC_LWORD __IEC_memory_image[];
+extern const unsigned int __IEC_input_image_size;     /* in bytes */
+extern const unsigned int __IEC_output_image_size;
+extern const unsigned int __IEC_memory_image_size;
+extern const __IEC_image_location_t __IEC_input_locations[];
+extern const __IEC_image_location_t __IEC_output_locations[];
+extern const __IEC_image_location_t __IEC_memory_locations[];
+extern const unsigned int __IEC_input_locations_count;
+extern const unsigned int __IEC_output_locations_count;
+extern const unsigned int __IEC_memory_locations_count;
+
+void __IEC_unpack_input_image(void);
+void __IEC_pack_output_image(void);
+
+
+static inline void __IEC_unpack_bits(const IEC_LWORD *image, BOOL *bools, const __IEC_image_bit_t *bits, unsigned int count) {
+  const unsigned char *bytes = (const unsigned char *)image;
+  unsigned int i;
+  for (i = 0; i < count; i++)
+    bools[i] = (bytes[bits[i].byte] >> bits[i].bit) & 1;
+}
+
+static inline void __IEC_pack_bits(IEC_LWORD *image, const BOOL *bools, const __IEC_image_bit_t *bits, unsigned int count) {
+  unsigned char *bytes = (unsigned char *)image;
+  unsigned int i;
+  for (i = 0; i < count; i++)
+    bytes[bits[i].byte] = (bytes[bits[i].byte] & ~(1 << bits[i].bit)) | ((bools[i] != 0) << bits[i].bit);
+}
+
+#endif //__IEC_PROCESS_IMAGE_H
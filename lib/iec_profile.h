@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_PROFILE_H
+#define __IEC_PROFILE_H
+
+/* Profiling of the calls to the functions, function blocks and programs.
+ *
+ * With 'iec2c -O profile' the body of every POU generated in POUS.c starts with
+ * __IEC_PROFILE_ENTER("<POU name>") and ends with __IEC_PROFILE_EXIT(). These
+ * expand to nothing unless the generated code is compiled with __IEC_PROFILE
+ * defined, in which case each POU gets a static record counting its calls, and
+ * the time spent in its body, with and without the POUs it calls. The time is read
+ * from the time stamp counter on x86 (in cycles), and from the monotonic clock
+ * elsewhere (in ns), or from __IEC_PROFILE_NOW() when the runtime defines it.
+ *
+ * Every (caller, callee) pair is also counted, so the report holds both a flat
+ * profile and the call tree, from each program down. It may be printed at any time
+ * by the runtime (from the PLC thread, or while it does not run a cycle):
+ *
+ *   __IEC_profile_print(stdout);
+ *   __IEC_profile_reset();
+ *
+ * The standard functions and function blocks of iec_std_lib.h are not profiled: their
+ * time is counted as the time of the POU that calls them. As POUS.c is included by
+ * the C file of each resource, a POU used by several resources is listed once per
+ * resource.
+ */
+
+#ifdef __IEC_PROFILE
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Maximum number of (caller, callee) pairs. Must be a power of 2. */
+#ifndef __IEC_PROFILE_MAX_EDGES
+#define __IEC_PROFILE_MAX_EDGES 1024
+#endif
+
+#ifndef __IEC_PROFILE_NOW
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __IEC_PROFILE_NOW()  __builtin_ia32_rdtsc()
+#define __IEC_PROFILE_UNIT   "cycles"
+#else
+static inline unsigned long long __IEC_profile_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#define __IEC_PROFILE_NOW()  __IEC_profile_now()
+#define __IEC_PROFILE_UNIT   "ns"
+#endif
+#endif
+#ifndef __IEC_PROFILE_UNIT
+#define __IEC_PROFILE_UNIT   "ticks"
+#endif
+
+typedef struct __IEC_profile_s {
+  const char *name;
+  unsigned long long calls;
+  unsigned long long total;      /* time spent in the POU, and in the POUs it calls */
+  unsigned long long self;       /* time spent in the POU only */
+  struct __IEC_profile_s *next;  /* in the list of the POUs called at least once */
+  int registered;
+} __IEC_profile_t;
+
+typedef struct __IEC_profile_frame_s {
+  __IEC_profile_t *pou;
+  unsigned long long start;
+  unsigned long long children;   /* time spent in the POUs called */
+  struct __IEC_profile_frame_s *caller;
+} __IEC_profile_frame_t;
+
+typedef struct {
+  __IEC_profile_t *caller;       /* NULL for the calls from the runtime */
+  __IEC_profile_t *callee;
+  unsigned long long calls;
+  unsigned long long total;
+} __IEC_profile_edge_t;
+
+typedef struct {
+  __IEC_profile_t *pous;
+  __IEC_profile_frame_t *current;
+  unsigned int edges_count;
+  __IEC_profile_edge_t edges[__IEC_PROFILE_MAX_EDGES];
+} __IEC_profile_block_t;
+
+/* Defined in the generated config.c */
+extern __IEC_profile_block_t __IEC_profile;
+#define __IEC_PROFILE_DEFINE_BLOCK __IEC_profile_block_t __IEC_profile;
+
+
+static inline __IEC_profile_edge_t *__IEC_profile_edge(__IEC_profile_t *caller, __IEC_profile_t *callee) {
+  unsigned long hash = ((unsigned long)caller * 31 + (unsigned long)callee) / sizeof(__IEC_profile_t);
+  unsigned int i, slot;
+  for (i = 0; i < __IEC_PROFILE_MAX_EDGES; i++) {
+    slot = (hash + i) & (__IEC_PROFILE_MAX_EDGES - 1);
+    if (__IEC_profile.edges[slot].callee == callee && __IEC_profile.edges[slot].caller == caller)
+      return &__IEC_profile.edges[slot];
+    if (__IEC_profile.edges[slot].callee == NULL) {
+      __IEC_profile.edges[slot].caller = caller;
+      __IEC_profile.edges[slot].callee = callee;
+      __IEC_profile.edges_count++;
+      return &__IEC_profile.edges[slot];
+    }
+  }
+  return NULL;  /* the table is full: the call is only in the flat profile */
+}
+
+static inline void __IEC_profile_enter(__IEC_profile_t *pou, __IEC_profile_frame_t *frame) {
+  if (!pou->registered) {
+    pou->registered = 1;
+    pou->next = __IEC_profile.pous;
+    __IEC_profile.pous = pou;
+  }
+  frame->pou = pou;
+  frame->children = 0;
+  frame->caller = __IEC_profile.current;
+  __IEC_profile.current = frame;
+  frame->start = __IEC_PROFILE_NOW();
+}
+
+static inline void __IEC_profile_exit(__IEC_profile_frame_t *frame) {
+  unsigned long long elapsed = __IEC_PROFILE_NOW() - frame->start;
+  __IEC_profile_t *pou = frame->pou;
+  __IEC_profile_edge_t *edge = __IEC_profile_edge(frame->caller? frame->caller->pou : NULL, pou);
+  pou->calls++;
+  pou->total += elapsed;
+  pou->self += elapsed - frame->children;
+  if (edge != NULL) {
+    edge->calls++;
+    edge->total += elapsed;
+  }
+  if (frame->caller != NULL)
+    frame->caller->children += elapsed;
+  __IEC_profile.current = frame->caller;
+}
+
+#define __IEC_PROFILE_ENTER(name) \
+  static __IEC_profile_t __profile_pou = {name, 0, 0, 0, NULL, 0}; \
+  __IEC_profile_frame_t __profile_frame; \
+  __IEC_profile_enter(&__profile_pou, &__profile_frame);
+#define __IEC_PROFILE_EXIT() \
+  __IEC_profile_exit(&__profile_frame);
+
+
+static inline void __IEC_profile_reset(void) {
+  __IEC_profile_t *pou;
+  for (pou = __IEC_profile.pous; pou != NULL; pou = pou->next)
+    pou->calls = pou->total = pou->self = 0;
+  memset(__IEC_profile.edges, 0, sizeof(__IEC_profile.edges));
+  __IEC_profile.edges_count = 0;
+}
+
+static inline void __IEC_profile_print_tree(FILE *f, __IEC_profile_t *caller, unsigned long long calls, unsigned int depth) {
+  unsigned int i;
+  /* IEC 61131-3 does not allow recursion, but do not loop forever anyway */
+  if (depth > 32)
+    return;
+  for (i = 0; i < __IEC_PROFILE_MAX_EDGES; i++) {
+    __IEC_profile_edge_t *edge = &__IEC_profile.edges[i];
+    if (edge->callee == NULL || edge->caller != caller)
+      continue;
+    fprintf(f, "%*s%-*s %12llu %14llu", 2 * depth, "", 40 - 2 * depth, edge->callee->name, edge->calls, edge->total);
+    if (caller != NULL)
+      fprintf(f, " %10.2f", calls? (double)edge->calls / calls : 0.0);
+    fprintf(f, "\n");
+    __IEC_profile_print_tree(f, edge->callee, edge->calls, depth + 1);
+  }
+}
+
+/* Prints the flat profile (sorted by self time), and the call tree. */
+static inline void __IEC_profile_print(FILE *f) {
+  __IEC_profile_t *pou, *best, *printed = NULL;
+  unsigned long long grand_total = 0;
+
+  for (pou = __IEC_profile.pous; pou != NULL; pou = pou->next)
+    grand_total += pou->self;
+  fprintf(f, "%-40s %12s %14s %14s %7s %12s\n",
+          "POU", "calls", "total (" __IEC_PROFILE_UNIT ")", "self (" __IEC_PROFILE_UNIT ")", "self %", "self/call");
+  /* selection sort: there are few POUs, and this must not allocate any memory */
+  do {
+    best = NULL;
+    for (pou = __IEC_profile.pous; pou != NULL; pou = pou->next)
+      if ((printed == NULL || pou->self < printed->self || (pou->self == printed->self && pou < printed))
+          && (best == NULL || pou->self > best->self || (pou->self == best->self && pou > best)))
+        best = pou;
+    if (best != NULL && best->calls > 0)
+      fprintf(f, "%-40s %12llu %14llu %14llu %7.2f %12.1f\n", best->name, best->calls, best->total, best->self,
+              grand_total? 100.0 * best->self / grand_total : 0.0, (double)best->self / best->calls);
+    printed = best;
+  } while (best != NULL);
+
+  fprintf(f, "\n%-40s %12s %14s %10s\n", "call tree", "calls", "total (" __IEC_PROFILE_UNIT ")", "per caller");
+  __IEC_profile_print_tree(f, NULL, 0, 0);
+}
+
+#else /* __IEC_PROFILE */
+
+#define __IEC_PROFILE_DEFINE_BLOCK
+#define __IEC_PROFILE_ENTER(name)
+#define __IEC_PROFILE_EXIT()
+
+#endif /* __IEC_PROFILE */
+
+#endif //__IEC_PROFILE_H
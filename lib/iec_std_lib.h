@@ -751,6 +751,21 @@ __ANY(__move_)
   else if (ENO != NULL)\
     *ENO = __BOOL_LITERAL(TRUE);
 
+/* NOTE on the fast variants:
+ *   Most calls to the standard functions do not use EN nor ENO, so the generated
+ *   code calls them with EN = TRUE and ENO = NULL. Since the functions with a
+ *   fixed number of inputs are static inline, the C compiler already removes
+ *   the TEST_EN() code of those calls.
+ *   The extensible functions (ADD, MUL, AND, OR, XOR, MAX, MIN, GT, GE, EQ, LE, LT)
+ *   however take their inputs through a va_list, and are therefore never inlined.
+ *   For each of these there is also a <function_name>_fast__(op1, op2) function,
+ *   without EN/ENO and with exactly 2 inputs, that stage 4 calls instead (nesting
+ *   the calls if there are more inputs, except for the comparisons) when neither
+ *   EN nor ENO are used in the call.
+ *   NE also has a _fast__ variant, so that the comparison operators of ST and IL
+ *   (e.g. a <> b, with a and b of type TIME or STRING) are all printed the same way.
+ */
+
   
   
 /*****************************************/  
@@ -1007,11 +1022,24 @@ __ANY_NBIT(__to_anyuint_)
 #define VA_ARGS_DT DT
 
 
+/* The C math function computing FUNC in the precision of each ANY_REAL type:
+ *   REAL  -> the float version (e.g. sinf()), or with __IEC_FAST_MATH defined,
+ *            the fast approximations of iec_fast_math.h (e.g. __fast_sinf())
+ *   LREAL -> the double version (e.g. sin())
+ */
+#ifdef __IEC_FAST_MATH
+#include "iec_fast_math.h"
+#define __REAL_MATH(FUNC)  __fast_##FUNC##f
+#else
+#define __REAL_MATH(FUNC)  FUNC##f
+#endif
+#define __LREAL_MATH(FUNC) FUNC
+
 #define __numeric(fname,TYPENAME, FUNC) \
 /* explicitly typed function */\
 static inline TYPENAME fname##TYPENAME(EN_ENO_PARAMS, TYPENAME op){\
   TEST_EN(TYPENAME)\
-  return FUNC(op);\
+  return __##TYPENAME##_MATH(FUNC)(op);\
 }\
 /* overloaded function */\
 static inline TYPENAME fname##_##TYPENAME##__##TYPENAME(EN_ENO_PARAMS, TYPENAME op) {\
@@ -1140,6 +1168,10 @@ static inline TYPENAME fname(EN_ENO_PARAMS, UINT param_count, TYPENAME op1, ...)
   \
   va_end (ap);                  /* Clean up.  */\
   return op1;\
+}\
+/* EN/ENO-free variant, for calls without EN and ENO (see the note on the fast variants) */\
+static inline TYPENAME fname##_fast__(TYPENAME op1, TYPENAME op2){\
+  return op1 OP op2;\
 }
 
 #define __arith_static(fname,TYPENAME, OP)\
@@ -1213,7 +1245,38 @@ __ANY_INT(__mod)
   /**************/
   /*    EXPT    */
   /**************/
+/* Helper functions, called by the code stage 4 generates for the ** operator (with -O typed-expt).
+ *   __expt_<type>()     : REAL ** REAL is computed in single precision (powf()).
+ *   __expt_int_<type>() : the integer powers are computed by repeated squaring, which
+ *                         (when IN2 is a constant) the C compiler unrolls into a few multiplications.
+ *                         The result may differ from pow() in the last bits.
+ *   __expt_uint_<type>(): the same, for the unsigned exponents (a ULINT above the largest LINT
+ *                         must not become a negative exponent).
+ */
+static inline REAL  __expt_REAL (REAL  IN1, REAL  IN2) {return powf(IN1, IN2);}
+static inline LREAL __expt_LREAL(LREAL IN1, LREAL IN2) {return pow (IN1, IN2);}
+
+#define __iec_(TYPENAME) \
+static inline TYPENAME __expt_uint_##TYPENAME(TYPENAME IN1, ULINT IN2){\
+  TYPENAME res = 1;\
+  while (IN2 != 0) {\
+    if (IN2 & 1) res *= IN1;\
+    IN2 >>= 1;\
+    if (IN2 != 0) IN1 *= IN1;\
+  }\
+  return res;\
+}\
+static inline TYPENAME __expt_int_##TYPENAME(TYPENAME IN1, LINT IN2){\
+  TYPENAME res = __expt_uint_##TYPENAME(IN1, (IN2 < 0)? -(ULINT)IN2 : (ULINT)IN2);\
+  return (IN2 < 0)? 1 / res : res;\
+}
+__ANY_REAL(__iec_)
+#undef __iec_
+
 /* overloaded function */
+/* NOTE: EXPT() keeps using pow(), whatever the 'typed-expt' option of stage 4: the
+ *       helpers above are only called by the code generated for the ** operator.
+ */
 #define __iec_(in1_TYPENAME,in2_TYPENAME) \
 static inline in1_TYPENAME EXPT__##in1_TYPENAME##__##in1_TYPENAME##__##in2_TYPENAME\
   (EN_ENO_PARAMS, in1_TYPENAME IN1, in2_TYPENAME IN2){\
@@ -1222,6 +1285,7 @@ static inline in1_TYPENAME EXPT__##in1_TYPENAME##__##in1_TYPENAME##__##in2_TYPEN
 }
 #define __in1_anyreal_(in2_TYPENAME)   __ANY_REAL_1(__iec_,in2_TYPENAME)
 __ANY_NUM(__in1_anyreal_)
+#undef __in1_anyreal_
 #undef __iec_
 
   
@@ -1404,6 +1468,10 @@ static inline BOOL fname(EN_ENO_PARAMS, UINT param_count, BOOL op1, ...){ \
 \
   va_end (ap);                  /* Clean up.  */ \
   return op1; \
+} \
+/* EN/ENO-free variant, for calls without EN and ENO (see the note on the fast variants) */ \
+static inline BOOL fname##_fast__(BOOL op1, BOOL tmp){ \
+  return (op1 && !tmp) || (!op1 && tmp); \
 }
 
 __xorbool_expand(XOR_BOOL) /* The explicitly typed standard functions */
@@ -1507,6 +1575,10 @@ static inline TYPENAME fname(EN_ENO_PARAMS, UINT param_count, TYPENAME op1, ...)
   \
   va_end (ap);                  /* Clean up.  */\
   return op1;\
+}\
+/* EN/ENO-free variant, for calls without EN and ENO (see the note on the fast variants) */\
+static inline TYPENAME fname##_fast__(TYPENAME op1, TYPENAME tmp){\
+  return COND ? tmp : op1;\
 }
 
 /* Max for numerical data types */	
@@ -1674,6 +1746,10 @@ static inline BOOL fname(EN_ENO_PARAMS, UINT param_count, TYPENAME op1, ...){\
   \
   va_end (ap);                  /* Clean up.  */\
   return 1;\
+}\
+/* EN/ENO-free variant of the 2 input call, for calls without EN and ENO (see the note on the fast variants) */\
+static inline BOOL fname##_fast__(TYPENAME op1, TYPENAME tmp){\
+  return COND;\
 }
 
 #define __compare_num(fname, TYPENAME, TEST) __compare_(fname, TYPENAME, op1 TEST tmp )
@@ -1808,18 +1884,27 @@ __compare_string(LE__BOOL__STRING, <= ) /* Overloaded function */
 static inline BOOL fname(EN_ENO_PARAMS, TYPENAME op1, TYPENAME op2){\
   TEST_EN(BOOL)\
   return op1 != op2 ? 1 : 0;\
+}\
+static inline BOOL fname##_fast__(TYPENAME op1, TYPENAME op2){\
+  return op1 != op2 ? 1 : 0;\
 }
 
 #define __ne_time(fname, TYPENAME) \
 static inline BOOL fname(EN_ENO_PARAMS, TYPENAME op1, TYPENAME op2){\
   TEST_EN(BOOL)\
   return __time_cmp(op1, op2) != 0 ? 1 : 0;\
+}\
+static inline BOOL fname##_fast__(TYPENAME op1, TYPENAME op2){\
+  return __time_cmp(op1, op2) != 0 ? 1 : 0;\
 }
 
 #define __ne_string(fname, TYPENAME) \
 static inline BOOL fname(EN_ENO_PARAMS, TYPENAME op1, TYPENAME op2){\
   TEST_EN(BOOL)\
   return __STR_CMP(op1, op2) != 0 ? 1 : 0;\
+}\
+static inline BOOL fname##_fast__(TYPENAME op1, TYPENAME op2){\
+  return __STR_CMP(op1, op2) != 0 ? 1 : 0;\
 }
 
 /* Comparison for numerical data types */
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2007-2011: Edouard TISSERANT and Laurent BESSARD
+ *
+ * See COPYING and COPYING.LESSER files for copyright details.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __IEC_TASK_STATS_H
+#define __IEC_TASK_STATS_H
+
+/* Scan time statistics of the tasks.
+ *
+ * With 'iec2c -O task-stats' the <resource>_run__() functions time the programs of
+ * each task with a monotonic clock, and keep, per task:
+ *   - the number of times the task was released (i.e. its programs were run);
+ *   - the minimum, maximum and mean execution time: the time spent in the programs
+ *     of the task (not counting the programs of the other tasks run in between);
+ *   - a histogram of the execution times, with 4 buckets per power of 2 (so each
+ *     bucket is at most 25% wide, as in a HDR histogram with 2 significant bits);
+ *   - the largest deviation (jitter) of the time between two releases from the period;
+ *   - the number of overruns, i.e. of releases whose last program ended after the
+ *     next release was due (the task was still running when it should have started
+ *     again).
+ * Each clock reading takes a few tens of ns where clock_gettime() is in the vDSO, so
+ * the whole instrumentation costs well under a microsecond per task and cycle.
+ *
+ * The statistics of every task are kept in a single block, pointed to by
+ * __IEC_task_stats (defined in the generated config.c). A runtime that wants another
+ * process to read them sets it to a block in shared memory before calling
+ * config_init__(). With __IEC_TASK_STATS_SHM defined, this header provides the
+ * functions to do so on POSIX systems:
+ *
+ *   #define __IEC_TASK_STATS_SHM
+ *   #include "iec_task_stats.h"
+ *   ...
+ *   __IEC_task_stats = __IEC_task_stats_share("/matiec_task_stats");  // the PLC
+ *   ...
+ *   block = __IEC_task_stats_attach("/matiec_task_stats");             // a reader
+ *   __IEC_task_stats_print(stdout, block);
+ *
+ * (tests/task_stats_dump.c is such a reader).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* Maximum number of tasks of a configuration. */
+#ifndef __IEC_TASK_STATS_MAX_TASKS
+#define __IEC_TASK_STATS_MAX_TASKS 64
+#endif
+
+#define __IEC_TASK_STATS_MAGIC    0x49454354   /* "IECT" */
+#define __IEC_TASK_STATS_VERSION  1
+#define __IEC_TASK_STATS_NAME_LEN 64
+/* 4 buckets per power of 2, from 32 ns to 2**36 ns (68 s) */
+#define __IEC_TASK_STATS_BUCKETS  128
+
+/* The clock, in ns. Define __IEC_TASK_STATS_NOW() for targets without clock_gettime(). */
+#ifndef __IEC_TASK_STATS_NOW
+static inline unsigned long long __IEC_task_stats_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#define __IEC_TASK_STATS_NOW() __IEC_task_stats_now()
+#endif
+
+typedef struct {
+  char name[__IEC_TASK_STATS_NAME_LEN];   /* RESOURCE.TASK */
+  unsigned long long period;              /* ns, 0 for the SINGLE tasks */
+  unsigned long long releases;
+  unsigned long long overruns;
+  unsigned long long min, max, total;     /* execution time, ns */
+  unsigned long long jitter;              /* ns */
+  unsigned int histogram[__IEC_TASK_STATS_BUCKETS];
+  /* the current release */
+  unsigned long long release, last_release, exec, end;
+} __IEC_task_stats_t;
+
+typedef struct {
+  unsigned int magic;
+  unsigned int version;
+  unsigned int count;
+  __IEC_task_stats_t tasks[__IEC_TASK_STATS_MAX_TASKS];
+  __IEC_task_stats_t overflow;            /* shared by the tasks that do not fit */
+} __IEC_task_stats_block_t;
+
+/* Defined in the generated config.c */
+extern __IEC_task_stats_block_t *__IEC_task_stats;
+
+
+/* The histogram bucket of an execution time */
+static inline unsigned int __IEC_task_stats_bucket(unsigned long long ns) {
+  unsigned int msb = 0;
+  unsigned int bucket;
+  if (ns < 32)
+    return 0;
+#if defined(__GNUC__)
+  msb = 63 - __builtin_clzll(ns);
+#else
+  while (ns >> (msb + 1)) msb++;
+#endif
+  /* the power of 2, and the 2 bits that follow the most significant one */
+  bucket = (msb - 4) * 4 + (unsigned int)((ns >> (msb - 2)) & 3) - 4;
+  return (bucket < __IEC_TASK_STATS_BUCKETS)? bucket : __IEC_TASK_STATS_BUCKETS - 1;
+}
+
+/* The smallest execution time counted in a bucket */
+static inline unsigned long long __IEC_task_stats_bucket_min(unsigned int bucket) {
+  unsigned int msb = (bucket + 4) / 4 + 4;
+  if (bucket == 0)
+    return 0;
+  return (1ULL << msb) | ((unsigned long long)((bucket + 4) % 4) << (msb - 2));
+}
+
+
+/* Called by the generated <resource>_init__(). Returns the statistics of the task
+ * (the same ones when the configuration is initialised again).
+ */
+static inline __IEC_task_stats_t *__IEC_task_stats_register(const char *name, unsigned long long period) {
+  __IEC_task_stats_block_t *block = __IEC_task_stats;
+  __IEC_task_stats_t *task;
+  unsigned int i;
+
+  if (block->magic != __IEC_TASK_STATS_MAGIC) {
+    memset(block, 0, sizeof(*block));
+    block->magic = __IEC_TASK_STATS_MAGIC;
+    block->version = __IEC_TASK_STATS_VERSION;
+  }
+  for (i = 0; i < block->count; i++)
+    if (strncmp(block->tasks[i].name, name, __IEC_TASK_STATS_NAME_LEN - 1) == 0)
+      break;
+  if (i == __IEC_TASK_STATS_MAX_TASKS)
+    return &block->overflow;
+  task = &block->tasks[i];
+  memset(task, 0, sizeof(*task));
+  strncpy(task->name, name, __IEC_TASK_STATS_NAME_LEN - 1);
+  task->period = period;
+  task->min = (unsigned long long)-1;
+  if (i == block->count)
+    block->count++;
+  return task;
+}
+
+/* Called by the generated <resource>_run__(), when the task is released */
+static inline void __IEC_task_release(__IEC_task_stats_t *task, unsigned long long now) {
+  task->last_release = task->release;
+  task->release = now;
+  task->exec = 0;
+  task->end = now;
+}
+
+/* ... after each program of the task, which started at 'start' */
+static inline void __IEC_task_program_done(__IEC_task_stats_t *task, unsigned long long start) {
+  task->end = __IEC_TASK_STATS_NOW();
+  task->exec += task->end - start;
+}
+
+/* ... and at the end of <resource>_run__() */
+static inline void __IEC_task_done(__IEC_task_stats_t *task) {
+  unsigned long long exec = task->exec;
+  if (task->releases > 0 && task->period > 0) {
+    unsigned long long interval = task->release - task->last_release;
+    unsigned long long jitter = (interval > task->period)? interval - task->period : task->period - interval;
+    if (jitter > task->jitter) task->jitter = jitter;
+  }
+  if (task->period > 0 && task->end - task->release > task->period)
+    task->overruns++;
+  if (exec < task->min) task->min = exec;
+  if (exec > task->max) task->max = exec;
+  task->total += exec;
+  task->histogram[__IEC_task_stats_bucket(exec)]++;
+  task->releases++;
+}
+
+
+/* Prints the statistics of every task (times in us). */
+static inline void __IEC_task_stats_print(FILE *f, const __IEC_task_stats_block_t *block) {
+  unsigned int i, b;
+
+  if (block->magic != __IEC_TASK_STATS_MAGIC || block->version != __IEC_TASK_STATS_VERSION) {
+    fprintf(f, "no task statistics\n");
+    return;
+  }
+  fprintf(f, "%-24s %10s %12s %10s %10s %10s %10s %10s\n",
+          "task", "period", "releases", "min", "mean", "max", "jitter", "overruns");
+  for (i = 0; i < block->count; i++) {
+    const __IEC_task_stats_t *task = &block->tasks[i];
+    unsigned long long releases = task->releases;
+    fprintf(f, "%-24s %10.1f %12llu %10.3f %10.3f %10.3f %10.3f %10llu\n",
+            task->name, task->period * 1e-3, releases,
+            releases? task->min * 1e-3 : 0.0, releases? task->total * 1e-3 / releases : 0.0,
+            task->max * 1e-3, task->jitter * 1e-3, task->overruns);
+  }
+  for (i = 0; i < block->count; i++) {
+    const __IEC_task_stats_t *task = &block->tasks[i];
+    fprintf(f, "\n%s: execution time (us)      releases\n", task->name);
+    for (b = 0; b < __IEC_TASK_STATS_BUCKETS; b++)
+      if (task->histogram[b] != 0)
+        fprintf(f, "  %10.3f - %10.3f %12u\n", __IEC_task_stats_bucket_min(b) * 1e-3,
+                (b + 1 < __IEC_TASK_STATS_BUCKETS)? __IEC_task_stats_bucket_min(b + 1) * 1e-3 : HUGE_VAL,
+                task->histogram[b]);
+  }
+}
+
+
+#ifdef __IEC_TASK_STATS_SHM
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Creates (or reuses) the shared memory object, for the PLC. Returns NULL on failure. */
+static inline __IEC_task_stats_block_t *__IEC_task_stats_share(const char *shm_name) {
+  void *block;
+  int fd = shm_open(shm_name, O_CREAT | O_RDWR, 0644);
+  if (fd < 0)
+    return NULL;
+  if (ftruncate(fd, sizeof(__IEC_task_stats_block_t)) != 0) {
+    close(fd);
+    return NULL;
+  }
+  block = mmap(NULL, sizeof(__IEC_task_stats_block_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (block == MAP_FAILED)
+    return NULL;
+  memset(block, 0, sizeof(__IEC_task_stats_block_t));
+  return (__IEC_task_stats_block_t *)block;
+}
+
+/* Maps the shared memory object of a running PLC, read only. Returns NULL on failure. */
+static inline const __IEC_task_stats_block_t *__IEC_task_stats_attach(const char *shm_name) {
+  void *block;
+  int fd = shm_open(shm_name, O_RDONLY, 0);
+  if (fd < 0)
+    return NULL;
+  block = mmap(NULL, sizeof(__IEC_task_stats_block_t), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  return (block == MAP_FAILED)? NULL : (const __IEC_task_stats_block_t *)block;
+}
+#endif /* __IEC_TASK_STATS_SHM */
+
+#endif //__IEC_TASK_STATS_H
@@ -72,18 +72,39 @@
 #define __IEC_RETAIN_FLAG 0x04
 #define __IEC_OUTPUT_FLAG 0x08
 
+/* Variables of POU instances are stored in a __IEC_<type>_t struct.
+ * By default the struct holds the value and the flags of the variable. With the
+ * struct of arrays layout (__IEC_SOA_LAYOUT, set by 'iec2c -O soa-layout' in the
+ * generated code) it holds only the value, so the values of the variables of a POU
+ * instance are laid out one after the other, and their flags are kept together in a
+ * separate __flags member of the instance (see accessor.h).
+ */
+#ifdef __IEC_SOA_LAYOUT
+#define __DECLARE_VALUE_STRUCT(value_type, type)\
+typedef struct {\
+  value_type value;\
+} __IEC_##type##_t;
+#else
+#define __DECLARE_VALUE_STRUCT(value_type, type)\
+typedef struct {\
+  value_type value;\
+  IEC_BYTE flags;\
+} __IEC_##type##_t;
+#endif
+
+/* External and located variables are stored in a __IEC_<type>_p struct, pointing
+ * to the value of the global variable or the location. The value such a variable is
+ * forced to is not kept in the struct, but in a table of forced values managed by
+ * the runtime (see iec_force.h), and the pointer is redirected to it while forced.
+ */
 #define __DECLARE_IEC_TYPE(type)\
 typedef IEC_##type type;\
 \
-typedef struct {\
-  IEC_##type value;\
-  IEC_BYTE flags;\
-} __IEC_##type##_t;\
+__DECLARE_VALUE_STRUCT(IEC_##type, type)\
 \
 typedef struct {\
   IEC_##type *value;\
   IEC_BYTE flags;\
-  IEC_##type fvalue;\
 } __IEC_##type##_p;
 
 #define __DECLARE_DERIVED_TYPE(type, base)\
@@ -92,15 +113,11 @@ typedef __IEC_##base##_t __IEC_##type##_t;\
 typedef __IEC_##base##_p __IEC_##type##_p;
 
 #define __DECLARE_COMPLEX_STRUCT(type)\
-typedef struct {\
-  type value;\
-  IEC_BYTE flags;\
-} __IEC_##type##_t;\
+__DECLARE_VALUE_STRUCT(type, type)\
 \
 typedef struct {\
   type *value;\
   IEC_BYTE flags;\
-  type fvalue;\
 } __IEC_##type##_p;
 
 #define __DECLARE_ENUMERATED_TYPE(type, ...)\
@@ -81,6 +81,8 @@
 #include "stage1_2/stage1_2.hh"
 #include "stage3/stage3.hh"
 #include "stage4/stage4.hh"
+#include "compile_server.hh"
+#include "time_report.hh"
 #include "main.hh"
 
 
@@ -109,7 +111,7 @@ void error_exit(const char *file_name, int line_no, const char *errmsg, ...) {
 
 
 static void printusage(const char *cmd) {
-  printf("\nsyntax: %s [-h] [-v] [-f] [-s] [-c] [-I <include_directory>] [-T <target_directory>] <input_file>\n", cmd);
+  printf("\nsyntax: %s [-h] [-v] [-f] [-s] [-c] [-I <include_directory>] [-T <target_directory>] [-O <output_options>] [-C <cache_directory>] [-S <socket_path>] [--time-report[=json]] <input_file>\n", cmd);
   printf("  h : show this help message\n");
   printf("  v : print version number\n");  
   printf("  f : display full token location on error messages\n");
@@ -122,6 +124,12 @@ static void printusage(const char *cmd) {
       /******************************************************/
   printf("  s : allow use of safe extensions\n");
   printf("  c : create conversion functions\n");
+  printf("  O : options for the code generator (stage 4), separated by commas\n");
+  stage4_print_options();
+  printf("  C : build cache directory, used to re-use the code generated for unchanged POUs\n");
+  printf("  S : run as a compile server, listening for compile requests on a local socket (no input file)\n");
+  printf("  --time-report : print the time and memory used by each phase of the compiler, the number of\n"
+         "                  AST symbols and the size of the symbol tables (--time-report=json: as JSON)\n");
   printf("\n");
   printf("%s - Copyright (C) 2003-2011 \n"
          "This program comes with ABSOLUTELY NO WARRANTY!\n"
@@ -130,18 +138,144 @@ static void printusage(const char *cmd) {
 
 
 
+/* The options that apply to stages 3 and 4. When running as a compile server,
+ * these are the defaults, that each compile request may override.
+ */
+static char * builddir = NULL;
+static char * cachedir = NULL;
+/* the options that change the generated code; POUs compiled with other options are not re-used from the build cache */
+static std::string cache_salt = std::string(PACKAGE_VERSION) + " " + HGVERSION;
+
+
+
+/* Passes 2 and 3, on the tree returned by stage 1_2 */
+static int compile_passes(symbol_c *tree_root) {
+  /* 2nd Pass */
+    /* basically loads some symbol tables to speed up look ups later on */
+  time_report_begin("absyntax_utils_init");
+  absyntax_utils_init(tree_root);  
+  time_report_end();
+    /* moved to bison, although it could perfectly well still be here instead of in bison code. */
+  //add_en_eno_param_decl_c::add_to(tree_root);
+
+  /* Find out which POUs have not changed since the last compilation */
+  if (cachedir != NULL) {
+    time_report_begin("build_cache");
+    build_cache = new build_cache_c(cachedir, tree_root, cache_salt);
+    time_report_end();
+  }
+
+  /* Do semantic verification of code (data type and lvalue checking currently implemented) */
+  /* NOTE: the POUs that have not changed do not need to be verified again (see absyntax_utils/build_cache.hh) */
+  time_report_begin("stage3");
+  if (stage3((build_cache != NULL)? build_cache->stage3_tree() : tree_root) < 0)
+    return EXIT_FAILURE;
+  time_report_end();
+  
+  /* 3rd Pass */
+  time_report_begin("stage4");
+  if (stage4(tree_root, builddir) < 0)
+    return EXIT_FAILURE;
+  time_report_end();
+
+  if (build_cache != NULL)
+    build_cache->print_statistics();
+
+  /* 4th Pass */
+  /* Call gcc, g++, or whatever... */
+  /* Currently implemented in the Makefile! */
+
+  return 0;
+}
+
+
+static int compile(symbol_c *tree_root) {
+  int result = compile_passes(tree_root);
+  /* also when the compilation failed (the phases left open end here) */
+  time_report_print(tree_root);
+  return result;
+}
+
+
+
+/* Handles a request sent to the compile server (see compile_server.hh).
+ * Runs in a child process of the server, that has already parsed the standard library.
+ */
+static int compile_request(int argc, char **argv) {
+  symbol_c *tree_root;
+  int optres, errflg = 0;
+  int path_len;
+
+  optind = 1; /* restart getopt() */
+  while ((optres = getopt(argc, argv, ":T:O:C:")) != -1) {
+    switch(optres) {
+    case 'T':
+    case 'C':
+      /* NOTE: see note in main() */
+      path_len = strlen(optarg) - 1;
+      if (optarg[path_len] == '\\') optarg[path_len]= '\0';
+      if (optres == 'T') builddir = optarg;
+      else               cachedir = optarg;
+      break;
+
+    case 'O':
+      if (stage4_parse_options(optarg) < 0) errflg++;
+      cache_salt += " -O ";
+      cache_salt += optarg;
+      break;
+
+    case ':':
+      fprintf(stderr, "Option -%c requires an operand\n", optopt);
+      errflg++;
+      break;
+
+    default:
+      fprintf(stderr, "Option -%c not allowed in a compile request\n", optopt);
+      errflg++;
+      break;
+    }
+  }
+
+  if (optind != argc - 1) {
+    fprintf(stderr, "A compile request must have exactly one input file\n");
+    errflg++;
+  }
+
+  if (errflg)
+    return EXIT_FAILURE;
+
+  time_report_begin("stage1_2");
+  if (stage1_2_main(argv[optind], &tree_root) < 0) {
+    time_report_print(NULL);
+    return EXIT_FAILURE;
+  }
+  time_report_end();
+
+  return compile(tree_root);
+}
+
+
+
+/* the options without a single letter equivalent */
+#define TIME_REPORT_OPTION 256
+static const struct option long_options[] = {
+  {"time-report", optional_argument, NULL, TIME_REPORT_OPTION},
+  {NULL, 0, NULL, 0}
+};
+
+
 int main(int argc, char **argv) {
   symbol_c *tree_root;
-  char * builddir = NULL;
   stage1_2_options_t stage1_2_options = {false, false, NULL};
   int optres, errflg = 0;
   int path_len;
+  char * socket_path = NULL;
 
 
   /******************************************/
   /*   Parse command line options...        */
   /******************************************/
-  while ((optres = getopt(argc, argv, ":hvfscI:T:")) != -1) {
+  while ((optres = getopt_long(argc, argv, ":hvfscI:T:O:C:S:", long_options, NULL)) != -1) {
     switch(optres) {
     case 'h':
       printusage(argv[0]);
@@ -158,10 +292,12 @@ int main(int argc, char **argv) {
 
     case 's':
       stage1_2_options.safe_extensions = true;
+      cache_salt += " -s";
       break;
 
     case 'c':
       stage1_2_options.conversion_functions = true;
+      cache_salt += " -c";
       break;
 
     case 'I':
@@ -182,7 +318,31 @@ int main(int argc, char **argv) {
       builddir = optarg;
       break;
 
-    case ':':       /* -I or -T without operand */
+    case 'O':
+      if (stage4_parse_options(optarg) < 0) errflg++;
+      cache_salt += " -O ";
+      cache_salt += optarg;
+      break;
+
+    case 'C':
+      /* NOTE: see note above */
+      path_len = strlen(optarg) - 1;
+      if (optarg[path_len] == '\\') optarg[path_len]= '\0';
+      cachedir = optarg;
+      break;
+
+    case 'S':
+      socket_path = optarg;
+      break;
+
+    case TIME_REPORT_OPTION:
+      if (time_report_enable(optarg) < 0) {
+        fprintf(stderr, "Unknown time report format: %s\n", optarg);
+        errflg++;
+      }
+      break;
+
+    case ':':       /* -I, -T, -O, -C or -S without operand */
       fprintf(stderr, "Option -%c requires an operand\n", optopt);
       errflg++;
       break;
@@ -199,7 +359,7 @@ int main(int argc, char **argv) {
     }
   }
 
-  if (optind == argc) {
+  if ((optind == argc) && (socket_path == NULL)) {
     fprintf(stderr, "Missing input file\n");
     errflg++;
   }
@@ -218,29 +378,24 @@ int main(int argc, char **argv) {
   /***************************/
   /*   Run the compiler...   */
   /***************************/
-  /* 1st Pass */
-  if (stage1_2(argv[optind], &tree_root, stage1_2_options) < 0)
-    return EXIT_FAILURE;
-
-  /* 2nd Pass */
-    /* basically loads some symbol tables to speed up look ups later on */
-  absyntax_utils_init(tree_root);  
-    /* moved to bison, although it could perfectly well still be here instead of in bison code. */
-  //add_en_eno_param_decl_c::add_to(tree_root);
+  if (socket_path != NULL) {
+    /* 1st Pass, for the standard library only. The input files are parsed by compile_request() */
+    time_report_begin("stage1_2_library");
+    if (stage1_2_library(stage1_2_options) < 0) {
+      time_report_print(NULL);
+      return EXIT_FAILURE;
+    }
+    time_report_end();
+    return compile_server(socket_path, compile_request);
+  }
 
-  /* Do semantic verification of code (data type and lvalue checking currently implemented) */
-  if (stage3(tree_root) < 0)
-    return EXIT_FAILURE;
-  
-  /* 3rd Pass */
-  if (stage4(tree_root, builddir) < 0)
+  /* 1st Pass */
+  time_report_begin("stage1_2");
+  if (stage1_2(argv[optind], &tree_root, stage1_2_options) < 0) {
+    time_report_print(NULL);
     return EXIT_FAILURE;
+  }
+  time_report_end();
 
-  /* 4th Pass */
-  /* Call gcc, g++, or whatever... */
-  /* Currently implemented in the Makefile! */
-
-  return 0;
+  return compile(tree_root);
 }
-
-
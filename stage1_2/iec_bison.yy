@@ -8241,11 +8241,14 @@ extern const char *INCLUDE_DIRECTORIES[];
 
 
 
-int stage2__(const char *filename, 
-             const char *includedir,     /* Include directory, where included files will be searched for... */
-             symbol_c **tree_root_ref,
-             bool full_token_loc_        /* error messages specify full token location */
-            ) {
+/* Parse the standard library file.
+ * NOTE: this is split from the parsing of the input file so that the compile server
+ *       (see compile_server.hh) may parse the library only once, and then parse each
+ *       input file on top of it (in a separate process).
+ */
+int stage2_library__(const char *includedir,     /* Include directory, where included files will be searched for... */
+                     bool full_token_loc_        /* error messages specify full token location */
+                    ) {
   char *libfilename = NULL;
 
   if (includedir != NULL) {
@@ -8295,6 +8298,15 @@ int stage2__(const char *filename,
         library_element_symtable.end_value())
       library_element_symtable.insert(standard_function_block_names[i], standard_function_block_name_token);
 
+  return 0;
+}
+
+
+/* Parse the input file, after the standard library has been parsed by stage2_library__() */
+int stage2_main__(const char *filename, 
+                  symbol_c **tree_root_ref,
+                  bool full_token_loc_        /* error messages specify full token location */
+                 ) {
   /* now parse the input file... */
   #if YYDEBUG
     yydebug = 1;
@@ -8329,6 +8341,17 @@ int stage2__(const char *filename,
 }
 
 
+int stage2__(const char *filename, 
+             const char *includedir,     /* Include directory, where included files will be searched for... */
+             symbol_c **tree_root_ref,
+             bool full_token_loc_        /* error messages specify full token location */
+            ) {
+  if (stage2_library__(includedir, full_token_loc_) < 0)
+    return -1;
+  return stage2_main__(filename, tree_root_ref, full_token_loc_);
+}
+
+
 
 
 
@@ -227,6 +227,8 @@ int stage2__(const char *filename,
              symbol_c **tree_root_ref,
              bool full_token_loc         /* error messages specify full token location */
             );
+int stage2_library__(const char *includedir, bool full_token_loc);
+int stage2_main__   (const char *filename, symbol_c **tree_root_ref, bool full_token_loc);
 
 
 int stage1_2(const char *filename, symbol_c **tree_root_ref, stage1_2_options_t options) {
@@ -246,3 +248,20 @@ int stage1_2(const char *filename, symbol_c **tree_root_ref, stage1_2_options_t
   return stage2__(filename, options.includedir, tree_root_ref, options.full_token_loc);
 }
 
+
+
+/* options used when parsing the library, that must also be used for the input file */
+static bool library_full_token_loc = false;
+
+int stage1_2_library(stage1_2_options_t options) {
+  safe_extensions_ = options.safe_extensions;
+  conversion_functions_ = options.conversion_functions;
+  library_full_token_loc = options.full_token_loc;
+  return stage2_library__(options.includedir, options.full_token_loc);
+}
+
+
+int stage1_2_main(const char *filename, symbol_c **tree_root_ref) {
+  return stage2_main__(filename, tree_root_ref, library_full_token_loc);
+}
+
@@ -68,6 +68,14 @@ typedef struct {
 
 int stage1_2(const char *filename, symbol_c **tree_root, stage1_2_options_t options);
 
+/* The same as stage1_2(), but in two steps: first parse the standard library, and
+ * then the input file. Used by the compile server (see compile_server.hh), that parses
+ * the library once, and then each input file in a separate (forked) process.
+ * stage1_2_main() must not be called more than once in the same process.
+ */
+int stage1_2_library(stage1_2_options_t options);
+int stage1_2_main   (const char *filename, symbol_c **tree_root);
+
 
 
 
@@ -126,14 +126,19 @@
  *    actually printing of errors for the print_datatype_errors_c class!
  *
  * NOTE 3
- *    Constant Folding class is extended with a implementation constant propagation algorithm
- *    by Mario de Sousa.
- *    Main idea is not to implement a general constant propagation algorithm but to reinterpret it
- *    for visitor classes.
- *    We declared a hash map, it contains a variables list linked with current constant values.
- *    During expression evaluation we can retrieve a constant value to symbolic variables getting it from the map.
- *    Also at join source points we use a meet semilattice rules to merge current values between a block
- *    and adjacent block.
+ *    Constant Folding class is extended with a constant propagation algorithm.
+ *    We do not implement a general (flow sensitive) constant propagation algorithm, but only handle
+ *    variables whose value is known to be constant for the whole body of the POU, i.e.:
+ *      - variables declared CONSTANT (including VAR_GLOBAL CONSTANT accessed through VAR_EXTERNAL);
+ *      - variables local to a function, with an explicit initial value, that are never changed
+ *        in the function body (see visit(symbolic_variable_c *)).
+ *    The values of the VAR_GLOBAL are stored in a map (global_values), where a meet semilattice
+ *    rule is used to merge the values of variables declared in more than one configuration/resource.
+ *
+ *    In IL code the cvalue of the accumulator flows from one IL instruction to the next. When an IL
+ *    instruction has more than one prev_il_instruction (i.e. it is the target of a JMP), the
+ *    cvalues of all the prev_il_instructions are merged. The instruction list is analysed using the
+ *    data flow framework in il_dataflow.hh, so loops (backward JMPs) are correctly handled.
  *
  */
 
@@ -144,6 +149,7 @@
 // #include <stdlib.h>  /* required for atoi() */
 #include <errno.h>   /* required for errno */
 
+#include "il_dataflow.hh"
 #include "../main.hh" // required for uint8_t, real_64_t, ..., and the macros NAN, INFINITY, INT8_MAX, REAL32_MAX, ... */
 
 
@@ -223,22 +229,31 @@
  * - any * non_const = non_const
  * - constant * constant = constant  (if equal)
  * - constant * constant = non_const (if not equal)
+ * We additionally consider that
+ * - overflow * (overflow | constant) = overflow
  */
-#define COMPUTE_MEET_SEMILATTICE(dtype, c1, c2, resValue) {\
-		if (( c1._##dtype.value  != c2._##dtype.value && c2._##dtype.status == symbol_c::cs_const_value &&\
-              c1._##dtype.status == symbol_c::cs_const_value) ||\
-		    ( c1._##dtype.status == symbol_c::cs_non_const && c2._##dtype.status == symbol_c::cs_const_value ) ||\
-		    ( c2._##dtype.status == symbol_c::cs_non_const && c1._##dtype.status == symbol_c::cs_const_value  )) {\
-			resValue._##dtype.status = symbol_c::cs_non_const;\
-		} else {\
-			resValue._##dtype.status = symbol_c::cs_const_value;\
-			resValue._##dtype.value  = c1._##dtype.value;\
-		}\
+#define COMPUTE_MEET_SEMILATTICE(dtype, c1, c2, resValue) {                                                               \
+	if      (c1._##dtype.status == symbol_c::cs_undefined)                                                            \
+		resValue._##dtype = c2._##dtype;                                                                          \
+	else if (c2._##dtype.status == symbol_c::cs_undefined)                                                            \
+		resValue._##dtype = c1._##dtype;                                                                          \
+	else if ((c1._##dtype.status == symbol_c::cs_non_const) || (c2._##dtype.status == symbol_c::cs_non_const))        \
+		resValue._##dtype.status = symbol_c::cs_non_const;                                                        \
+	else if ((c1._##dtype.status == symbol_c::cs_overflow)  || (c2._##dtype.status == symbol_c::cs_overflow))         \
+		resValue._##dtype.status = symbol_c::cs_overflow;                                                         \
+	else if  (c1._##dtype.value  != c2._##dtype.value)                                                                \
+		resValue._##dtype.status = symbol_c::cs_non_const;                                                        \
+	else                                                                                                              \
+		resValue._##dtype = c1._##dtype;                                                                          \
 }
 
-typedef std::map <std::string, symbol_c::const_value_t> map_values_t;
+#define ISEQUAL_CONST_VALUE_(dtype, c1, c2) \
+	((c1._##dtype.status == c2._##dtype.status) && ((c1._##dtype.status != symbol_c::cs_const_value) || (c1._##dtype.value == c2._##dtype.value)))
 
-static map_values_t values;
+static bool is_equal_const_value(const symbol_c::const_value_t &c1, const symbol_c::const_value_t &c2) {
+	return ISEQUAL_CONST_VALUE_(real64, c1, c2) && ISEQUAL_CONST_VALUE_(uint64, c1, c2) &&
+	       ISEQUAL_CONST_VALUE_( int64, c1, c2) && ISEQUAL_CONST_VALUE_(  bool, c1, c2);
+}
 
 
 
@@ -727,30 +742,6 @@ static void *handle_pow(symbol_c *symbol, symbol_c *oper1, symbol_c *oper2) {
 	return NULL;
 }
 
-static map_values_t inner_left_join_values(map_values_t m1, map_values_t m2) {
-	map_values_t::const_iterator itr;
-	map_values_t ret;
-
-	itr = m1.begin();
-	for ( ; itr != m1.end(); ++itr) {
-		std::string name = itr->first;
-		symbol_c::const_value_t value;
-
-		if (m2.count(name) > 0) {
-			symbol_c::const_value_t c1 = itr->second;
-			symbol_c::const_value_t c2 = m2[name];
-			COMPUTE_MEET_SEMILATTICE (real64, c1, c2, value);
-			COMPUTE_MEET_SEMILATTICE (uint64, c1, c2, value);
-			COMPUTE_MEET_SEMILATTICE ( int64, c1, c2, value);
-			COMPUTE_MEET_SEMILATTICE (  bool, c1, c2, value);
-		} else
-			value = m1[name];
-		ret[name] = value;
-	}
-
-	return ret;
-}
-
 /***********************************************************************/
 /***********************************************************************/
 /***********************************************************************/
@@ -760,26 +751,68 @@ static map_values_t inner_left_join_values(map_values_t m1, map_values_t m2) {
 /***********************************************************************/
 
 
-/* If the cvalues of all the prev_il_intructions have the same VALID value, then set the local cvalue to that value, otherwise, set it to NONCONST! */
-#define intersect_prev_CVALUE_(dtype, symbol) {                                                                   \
-	symbol->const_value._##dtype = symbol->prev_il_instruction[0]->const_value._##dtype;                      \
-	for (unsigned int i = 1; i < symbol->prev_il_instruction.size(); i++) {                                   \
+/* If the cvalues of all the prev_il_intructions have the same VALID value, then set the local cvalue to that value, otherwise, set it to NONCONST! 
+ *
+ * NOTE: The prev_il_instructions that have not yet been evaluated are ignored. Since instruction lists are analysed
+ *       with a data flow solver (see visit(instruction_list_c *)), these will be the ones that are reached through
+ *       a backward JMP (i.e. loops). The solver will later re-evaluate this IL instruction once the cvalue of those
+ *       prev_il_instructions is known, so the final result will take all of them into account.
+ */
+#define intersect_prev_CVALUE_(dtype, symbol, first, evaluated) {                                                 \
+	symbol->const_value._##dtype = first->const_value._##dtype;                                               \
+	for (unsigned int i = 0; i < symbol->prev_il_instruction.size(); i++) {                                   \
+		if ((first == symbol->prev_il_instruction[i]) || (evaluated.count(symbol->prev_il_instruction[i]) == 0)) \
+			continue;                                                                                 \
 		if (!ISEQUAL_CVALUE(dtype, symbol, symbol->prev_il_instruction[i]))                               \
 			{SET_NONCONST(dtype, symbol); break;}                                                     \
 	}                                                                                                         \
 }
 
-static void intersect_prev_cvalues(il_instruction_c *symbol) {
-	if (symbol->prev_il_instruction.empty())
+static void intersect_prev_cvalues(il_instruction_c *symbol, const std::set <symbol_c *> &evaluated) {
+	symbol_c *first = NULL;
+	for (unsigned int i = 0; (i < symbol->prev_il_instruction.size()) && (NULL == first); i++)
+		if (evaluated.count(symbol->prev_il_instruction[i]) > 0)
+			first = symbol->prev_il_instruction[i];
+	if (NULL == first)
 		return;
-	intersect_prev_CVALUE_(real64, symbol);
-	intersect_prev_CVALUE_(uint64, symbol);
-	intersect_prev_CVALUE_( int64, symbol);
-	intersect_prev_CVALUE_(  bool, symbol);
+	intersect_prev_CVALUE_(real64, symbol, first, evaluated);
+	intersect_prev_CVALUE_(uint64, symbol, first, evaluated);
+	intersect_prev_CVALUE_( int64, symbol, first, evaluated);
+	intersect_prev_CVALUE_(  bool, symbol, first, evaluated);
 }
 
 
 
+/* The data flow problem solved when determining the cvalues of an IL instruction_list.
+ * The cvalue flowing out of a basic block is the cvalue of its last IL instruction.
+ */
+class constant_folding_il_problem_c: public il_dataflow_problem_c {
+  private:
+    visitor_c             &visitor;
+    std::set <symbol_c *> &evaluated;
+
+  public:
+    constant_folding_il_problem_c(visitor_c &visitor, std::set <symbol_c *> &evaluated)
+      : visitor(visitor), evaluated(evaluated) {}
+
+    direction_t direction(void) {return forward;}
+
+    bool transfer(il_basic_block_c *block) {
+      /* The first time a block is evaluated we must always report a change, since the successors
+       * may have ignored this block's cvalue while it was not yet evaluated (see intersect_prev_cvalues())
+       */
+      bool first_time = (evaluated.count(block->last()) == 0);
+      symbol_c::const_value_t prev_cvalue = block->last()->const_value;
+      for (unsigned int i = 0; i < block->instructions.size(); i++) {
+        block->instructions[i]->accept(visitor);
+        evaluated.insert(block->instructions[i]);
+      }
+      return first_time || !is_equal_const_value(prev_cvalue, block->last()->const_value);
+    }
+};
+
+
+
 /***********************************************************************/
 /***********************************************************************/
 /***********************************************************************/
@@ -799,6 +832,8 @@ constant_folding_c::constant_folding_c(symbol_c *symbol) {
     current_display_error_level = 0;
     il_operand = NULL;
     search_varfb_instance_type = NULL;
+    search_var_instance_decl = NULL;
+    search_assigned_variables = NULL;
     prev_il_instruction = NULL;
     
     /* check whether the platform on which the compiler is being run implements IEC 559 floating point data types. */
@@ -820,6 +855,35 @@ int constant_folding_c::get_error_count() {
 }
 
 
+
+/* Return the initial value explicitly given to a variable in its declaration, or NULL if none was given */
+/* NOTE: we only handle variables of elementary data types (i.e. simple_spec_init_c) */
+static symbol_c *get_initial_value(symbol_c *spec_init) {
+	simple_spec_init_c *simple_spec_init = dynamic_cast<simple_spec_init_c *>(spec_init);
+	if (NULL == simple_spec_init) return NULL;
+	return simple_spec_init->constant;
+}
+
+
+
+/***************************/
+/* B 0 - Programming Model */
+/***************************/
+void *constant_folding_c::visit(library_c *symbol) {
+	/* The VAR_GLOBAL are declared inside the configurations, which usually come after the POUs that
+	 * access them through VAR_EXTERNAL. We therefore determine the values of the VAR_GLOBAL first...
+	 */
+	global_values.clear();
+	for (int i = 0; i < symbol->n; i++)
+		if (NULL != dynamic_cast<configuration_declaration_c *>(symbol->elements[i]))
+			symbol->elements[i]->accept(*this);
+	for (int i = 0; i < symbol->n; i++)
+		if (NULL == dynamic_cast<configuration_declaration_c *>(symbol->elements[i]))
+			symbol->elements[i]->accept(*this);
+	return NULL;
+}
+
+
 /*********************/
 /* B 1.2 - Constants */
 /*********************/
@@ -977,40 +1041,129 @@ void *constant_folding_c::visit(fixed_point_c *symbol) {
 /*********************/
 /* B 1.4 - Variables */
 /*********************/
-#if DO_CONSTANT_PROPAGATION__
+/* Constant propagation. The value of a variable is known (at compile time) to be constant if it is:
+ *  - declared CONSTANT (VAR CONSTANT, VAR_GLOBAL CONSTANT, VAR_EXTERNAL CONSTANT) with an explicit initial value;
+ *  - declared inside a function (VAR or VAR_TEMP, without RETAIN) with an explicit initial value,
+ *    and never changed inside the function body. Since function variables are re-initialised on every
+ *    invocation, these are loop invariants, whose value is always the initial value.
+ * Note that we cannot do the same for the variables of FBs and programs, as these keep their
+ * values between invocations, and may be changed by the debugger (forced).
+ */
 void *constant_folding_c::visit(symbolic_variable_c *symbol) {
-	std::string varName;
+	if (NULL == search_var_instance_decl) return NULL;
 
-	varName = get_var_name_c::get_name(symbol->var_name)->value;
-	if (values.count(varName) > 0) {
-		symbol->const_value = values[varName];
+	search_var_instance_decl_c::vt_t  vartype = search_var_instance_decl->get_vartype(symbol);
+	search_var_instance_decl_c::opt_t option  = search_var_instance_decl->get_option (symbol);
+
+	if ((vartype == search_var_instance_decl_c::external_vt) && (option == search_var_instance_decl_c::constant_opt)) {
+		map_values_t::iterator iter = global_values.find(get_var_name_c::get_name(symbol)->value);
+		if (iter != global_values.end())
+			symbol->const_value = iter->second;
+		return NULL;
 	}
+
+	bool is_constant = (option == search_var_instance_decl_c::constant_opt) && (vartype != search_var_instance_decl_c::located_vt);
+	bool is_invariant = (NULL != search_assigned_variables)
+	                 && (option  == search_var_instance_decl_c::none_opt)
+	                 && ((vartype == search_var_instance_decl_c::private_vt) || (vartype == search_var_instance_decl_c::temp_vt))
+	                 && !search_assigned_variables->is_assigned(symbol);
+	if (!is_constant && !is_invariant) return NULL;
+
+	symbol_c *initial_value = get_initial_value(search_var_instance_decl->get_decl(symbol));
+	if (NULL != initial_value)
+		symbol->const_value = initial_value->const_value;
+	return NULL;
+}
+
+
+/**************************************/
+/* B.1.5 - Program organization units */
+/**************************************/
+void *constant_folding_c::visit(function_declaration_c *symbol) {
+	symbol->var_declarations_list->accept(*this);  /* determine the cvalues of the initial values */
+	search_var_instance_decl  = new search_var_instance_decl_c (symbol);
+	search_assigned_variables = new search_assigned_variables_c(symbol);
+	symbol->function_body->accept(*this);
+	delete search_assigned_variables;
+	delete search_var_instance_decl;
+	search_assigned_variables = NULL;
+	search_var_instance_decl  = NULL;
+	return NULL;
+}
+
+
+void *constant_folding_c::visit(function_block_declaration_c *symbol) {
+	symbol->var_declarations->accept(*this);  /* determine the cvalues of the initial values */
+	search_var_instance_decl = new search_var_instance_decl_c(symbol);
+	symbol->fblock_body->accept(*this);
+	delete search_var_instance_decl;
+	search_var_instance_decl = NULL;
 	return NULL;
 }
-#endif  // DO_CONSTANT_PROPAGATION__
 
 
-/**********************/
-/* B 1.5.3 - Programs */
-/**********************/
-#if DO_CONSTANT_PROPAGATION__
 void *constant_folding_c::visit(program_declaration_c *symbol) {
-	symbol_c *var_name;
-
-	symbol->var_declarations->accept(*this);
-	values.clear(); /* Clear global map */
-	search_var_instance_decl_c search_var_instance_decl(symbol);
-	function_param_iterator_c fpi(symbol);
-	while((var_name = fpi.next()) != NULL) {
-		std::string varName = get_var_name_c::get_name(var_name)->value;
-		symbol_c   *varDecl = search_var_instance_decl.get_decl(var_name);
-		values[varName] = varDecl->const_value;
-	}
-	/* Add all variables declared into Values map and put them to initial value */
+	symbol->var_declarations->accept(*this);  /* determine the cvalues of the initial values */
+	search_var_instance_decl = new search_var_instance_decl_c(symbol);
 	symbol->function_block_body->accept(*this);
+	delete search_var_instance_decl;
+	search_var_instance_decl = NULL;
+	return NULL;
+}
+
+
+/********************************/
+/* B 1.7 Configuration elements */
+/********************************/
+/*| VAR_GLOBAL [CONSTANT|RETAIN] global_var_decl_list END_VAR */
+/* option -> may be NULL ! */
+// SYM_REF2(global_var_declarations_c, option, global_var_decl_list)
+/* NOTE: The same variable name may be declared in more than one configuration/resource. Since a VAR_EXTERNAL
+ *       is only resolved at the point the program is instantiated, we use the meet of all these values.
+ */
+void *constant_folding_c::visit(global_var_declarations_c *symbol) {
+	symbol->global_var_decl_list->accept(*this);  /* determine the cvalues of the initial values */
+
+	bool    is_constant = (NULL != dynamic_cast<constant_option_c *>(symbol->option));
+	list_c *list        = dynamic_cast<list_c *>(symbol->global_var_decl_list);
+	if (NULL == list) ERROR;
+
+	for (int i = 0; i < list->n; i++) {
+		global_var_decl_c *global_var_decl = dynamic_cast<global_var_decl_c *>(list->elements[i]);
+		if (NULL == global_var_decl) ERROR;
+
+		std::vector <token_c *> names;
+		symbol_c          *location        = NULL;
+		global_var_spec_c *global_var_spec = dynamic_cast<global_var_spec_c *>(global_var_decl->global_var_spec);
+		global_var_list_c *global_var_list = dynamic_cast<global_var_list_c *>(global_var_decl->global_var_spec);
+		if (NULL != global_var_spec) {
+			location = global_var_spec->location;
+			if (NULL != global_var_spec->global_var_name)
+				names.push_back(dynamic_cast<token_c *>(global_var_spec->global_var_name));
+		}
+		if (NULL != global_var_list)
+			for (int j = 0; j < global_var_list->n; j++)
+				names.push_back(dynamic_cast<token_c *>(global_var_list->elements[j]));
+
+		symbol_c::const_value_t value;
+		symbol_c *initial_value = get_initial_value(global_var_decl->type_specification);
+		if (is_constant && (NULL == location) && (NULL != initial_value)) {
+			value = initial_value->const_value;
+		} else {
+			value._real64.status = value._int64.status = value._uint64.status = value._bool.status = symbol_c::cs_non_const;
+		}
+
+		for (unsigned int j = 0; j < names.size(); j++) {
+			if (NULL == names[j]) ERROR;
+			symbol_c::const_value_t prev_value = global_values[names[j]->value];  /* cs_undefined, if it does not yet exist */
+			COMPUTE_MEET_SEMILATTICE (real64, prev_value, value, global_values[names[j]->value]);
+			COMPUTE_MEET_SEMILATTICE (uint64, prev_value, value, global_values[names[j]->value]);
+			COMPUTE_MEET_SEMILATTICE ( int64, prev_value, value, global_values[names[j]->value]);
+			COMPUTE_MEET_SEMILATTICE (  bool, prev_value, value, global_values[names[j]->value]);
+		}
+	}
 	return NULL;
 }
-#endif  // DO_CONSTANT_PROPAGATION__
 
 
 /****************************************/
@@ -1019,10 +1172,20 @@ void *constant_folding_c::visit(program_declaration_c *symbol) {
 /***********************************/
 /* B 2.1 Instructions and Operands */
 /***********************************/
-/* Not needed, since we inherit from iterator_visitor_c */
 /*| instruction_list il_instruction */
 // SYM_LIST(instruction_list_c)
-// void *constant_folding_c::visit(instruction_list_c *symbol) {}
+/* The cvalue of the accumulator (i.e. the IL default variable) at each il_instruction depends on the cvalues
+ * of all its prev_il_instructions, which, in the presence of backward JMPs, are only known after the il_instructions
+ * that follow it have been analysed. We therefore iterate (using a worklist over the basic blocks) until a fixpoint
+ * is reached.
+ */
+void *constant_folding_c::visit(instruction_list_c *symbol) {
+	evaluated_il_instructions.clear();
+	constant_folding_il_problem_c problem(*this, evaluated_il_instructions);
+	il_dataflow_solver_c::solve(symbol, &problem);
+	evaluated_il_instructions.clear();
+	return NULL;
+}
 
 /* | label ':' [il_incomplete_instruction] eol_list */
 // SYM_REF2(il_instruction_c, label, il_instruction)
@@ -1032,10 +1195,10 @@ void *constant_folding_c::visit(il_instruction_c *symbol) {
 		/* This empty/null il_instruction does not change the value of the current/default IL variable.
 		 * So it inherits the candidate_datatypes from it's previous IL instructions!
 		 */
-		intersect_prev_cvalues(symbol);
+		intersect_prev_cvalues(symbol, evaluated_il_instructions);
 	} else {
 		il_instruction_c fake_prev_il_instruction = *symbol;
-		intersect_prev_cvalues(&fake_prev_il_instruction);
+		intersect_prev_cvalues(&fake_prev_il_instruction, evaluated_il_instructions);
 
 		if (symbol->prev_il_instruction.size() == 0)  prev_il_instruction = NULL;
 		else                                          prev_il_instruction = &fake_prev_il_instruction;
@@ -1281,128 +1444,3 @@ void *constant_folding_c::visit(   not_expression_c *symbol) {symbol->  exp->acc
 /* TODO: handle function invocations... */
 // void *fill_candidate_datatypes_c::visit(function_invocation_c *symbol) {}
 
-
-
-#if DO_CONSTANT_PROPAGATION__
-/*********************************/
-/* B 3.2.1 Assignment Statements */
-/*********************************/
-void *constant_folding_c::visit(assignment_statement_c *symbol) {
-	std::string varName;
-
-	symbol->r_exp->accept(*this);
-	symbol->l_exp->const_value = symbol->r_exp->const_value;
-	varName = get_var_name_c::get_name(symbol->l_exp)->value;
-	values[varName] = symbol->l_exp->const_value;
-
-	return NULL;
-}
-
-/********************************/
-/* B 3.2.3 Selection Statements */
-/********************************/
-void *constant_folding_c::visit(if_statement_c *symbol) {
-	map_values_t values_incoming;
-	map_values_t values_statement_result;
-	map_values_t values_elsestatement_result;
-	map_values_t::iterator itr;
-
-	/* Optimize dead code */
-	symbol->expression->accept(*this);
-	if (VALID_CVALUE(bool, symbol->expression) && GET_CVALUE(bool, symbol->expression) == false)
-		return NULL;
-
-	values_incoming = values; /* save incoming status */
-	symbol->statement_list->accept(*this);
-	values_statement_result = values;
-	if (NULL != symbol->else_statement_list) {
-		values = values_incoming;
-		symbol->else_statement_list->accept(*this);
-		values_elsestatement_result = values;
-	} else
-		values_elsestatement_result = values_incoming;
-	values = inner_left_join_values(values_statement_result, values_elsestatement_result);
-
-	return NULL;
-}
-
-/********************************/
-/* B 3.2.4 Iteration Statements */
-/********************************/
-void *constant_folding_c::visit(for_statement_c *symbol) {
-	map_values_t values_incoming;
-	map_values_t values_statement_result;
-	std::string varName;
-
-	values_incoming = values; /* save incoming status */
-	symbol->beg_expression->accept(*this);
-	symbol->end_expression->accept(*this);
-	varName =  get_var_name_c::get_name(symbol->control_variable)->value;
-	values[varName]._int64.status = symbol_c::cs_non_const;
-
-	/* Optimize dead code */
-	if (NULL != symbol->by_expression) {
-		symbol->by_expression->accept(*this);
-		if (VALID_CVALUE(int64, symbol->by_expression ) &&   GET_CVALUE(int64, symbol->by_expression ) > 0 &&
-			VALID_CVALUE(int64, symbol->beg_expression) && VALID_CVALUE(int64, symbol->end_expression)     &&
-			  GET_CVALUE(int64, symbol->beg_expression) >    GET_CVALUE(int64, symbol->end_expression))
-			return NULL;
-
-		if (VALID_CVALUE(int64, symbol->by_expression ) &&   GET_CVALUE(int64, symbol->by_expression ) < 0 &&
-			VALID_CVALUE(int64, symbol->beg_expression) && VALID_CVALUE(int64, symbol->end_expression)    &&
-			  GET_CVALUE(int64, symbol->beg_expression) <    GET_CVALUE(int64, symbol->end_expression))
-			return NULL;
-
-	} else {
-		if (VALID_CVALUE(int64, symbol->beg_expression) && VALID_CVALUE(int64, symbol->end_expression)     &&
-			  GET_CVALUE(int64, symbol->beg_expression) >    GET_CVALUE(int64, symbol->end_expression))
-			return NULL;
-
-	}
-
-
-	symbol->statement_list->accept(*this);
-	values_statement_result = values;
-	values = inner_left_join_values(values_statement_result, values_incoming);
-
-	return NULL;
-}
-
-void *constant_folding_c::visit(while_statement_c *symbol) {
-	map_values_t values_incoming;
-	map_values_t values_statement_result;
-
-	/* Optimize dead code */
-	symbol->expression->accept(*this);
-	if (VALID_CVALUE(bool, symbol->expression) && GET_CVALUE(bool, symbol->expression) == false)
-		return NULL;
-
-	values_incoming = values; /* save incoming status */
-	symbol->statement_list->accept(*this);
-	values_statement_result = values;
-	values = inner_left_join_values(values_statement_result, values_incoming);
-
-	return NULL;
-}
-
-void *constant_folding_c::visit(repeat_statement_c *symbol) {
-	map_values_t values_incoming;
-	map_values_t values_statement_result;
-
-	values_incoming = values; /* save incoming status */
-	symbol->statement_list->accept(*this);
-
-	/* Optimize dead code */
-	symbol->expression->accept(*this);
-	if (VALID_CVALUE(bool, symbol->expression) && GET_CVALUE(bool, symbol->expression) == true)
-		return NULL;
-
-	values_statement_result = values;
-	values = inner_left_join_values(values_statement_result, values_incoming);
-
-	return NULL;
-}
-
-#endif  // DO_CONSTANT_PROPAGATION__
-
-
@@ -40,19 +40,24 @@
  */
 
 #include <vector>
+#include <map>
+#include <set>
+#include <string>
 #include "../absyntax_utils/absyntax_utils.hh"
 
 
 
-/* For the moment we disable constant propagation algorithm as it is not yet complete, 
- * and due to this is currently brocken and producing incorrect results!
- */
-#define DO_CONSTANT_PROPAGATION__ 0
-
-
-
 class constant_folding_c : public iterator_visitor_c {
+    typedef std::map <std::string, symbol_c::const_value_t, nocasecmp_c> map_values_t;
+
     search_varfb_instance_type_c *search_varfb_instance_type;
+    /* Used for constant propagation (i.e. determining the value of variables that are known to be constant)... */
+    search_var_instance_decl_c  *search_var_instance_decl;
+    search_assigned_variables_c *search_assigned_variables;  /* only used inside functions. Otherwise NULL. */
+    /* The values of all the VAR_GLOBAL, as they may be accessed through a VAR_EXTERNAL in any POU. */
+    map_values_t global_values;
+    /* The IL instructions whose cvalues have already been determined while analysing the current instruction_list */
+    std::set <symbol_c *> evaluated_il_instructions;
     int error_count;
     bool warning_found;
     int current_display_error_level;
@@ -67,6 +72,11 @@ class constant_folding_c : public iterator_visitor_c {
 	int get_error_count();
 
   private:
+    /***************************/
+    /* B 0 - Programming Model */
+    /***************************/
+    void *visit(library_c *symbol);
+
     /*********************/
     /* B 1.2 - Constants */
     /*********************/
@@ -95,16 +105,19 @@ class constant_folding_c : public iterator_visitor_c {
     /*********************/
     /* B 1.4 - Variables */
     /*********************/
-    #if DO_CONSTANT_PROPAGATION__
     void *visit(symbolic_variable_c *symbol);
-    #endif
 
-    /**********************/
-    /* B 1.5.3 - Programs */
-    /**********************/
-    #if DO_CONSTANT_PROPAGATION__
+    /**************************************/
+    /* B.1.5 - Program organization units */
+    /**************************************/
+    void *visit(function_declaration_c *symbol);
+    void *visit(function_block_declaration_c *symbol);
     void *visit(program_declaration_c *symbol);
-    #endif
+
+    /********************************/
+    /* B 1.7 Configuration elements */
+    /********************************/
+    void *visit(global_var_declarations_c *symbol);
 
     /****************************************/
     /* B.2 - Language IL (Instruction List) */
@@ -112,7 +125,7 @@ class constant_folding_c : public iterator_visitor_c {
     /***********************************/
     /* B 2.1 Instructions and Operands */
     /***********************************/
-    // void *visit(instruction_list_c *symbol); /* Not needed, since we inherit from iterator_visitor_c */
+    void *visit(instruction_list_c *symbol);
     void *visit(il_instruction_c *symbol);
     void *visit(il_simple_operation_c *symbol);
     //void *visit(il_function_call_c *symbol);  /* TODO */
@@ -199,24 +212,5 @@ class constant_folding_c : public iterator_visitor_c {
     void *visit(   not_expression_c *symbol);
     //void *visit(function_invocation_c *symbol); /* TODO */
 
-    
-    #if DO_CONSTANT_PROPAGATION__
-    /*********************************/
-    /* B 3.2.1 Assignment Statements */
-    /*********************************/
-    void *visit(assignment_statement_c *symbol);
-
-    /********************************/
-    /* B 3.2.3 Selection Statements */
-    /********************************/
-    void *visit(if_statement_c *symbol);
-
-    /********************************/
-    /* B 3.2.4 Iteration Statements */
-    /********************************/
-    void *visit(for_statement_c *symbol);
-    void *visit(while_statement_c *symbol);
-    void *visit(repeat_statement_c *symbol);
-    #endif // DO_CONSTANT_PROPAGATION__
 };
 
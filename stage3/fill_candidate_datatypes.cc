@@ -62,6 +62,7 @@
 #include <../main.hh>         /* required for UINT64_MAX, INT64_MAX, INT64_MIN, ... */
 #include "fill_candidate_datatypes.hh"
 #include "datatype_functions.hh"
+#include "il_dataflow.hh"
 #include <typeinfo>
 #include <list>
 #include <string>
@@ -288,7 +289,7 @@ symbol_c *fill_candidate_datatypes_c::widening_conversion(symbol_c *left_type, s
 	int k;
 	/* find a widening table entry compatible */
 	for (k = 0; NULL != widen_table[k].left;  k++)
-		if ((typeid(*left_type) == typeid(*widen_table[k].left)) && (typeid(*right_type) == typeid(*widen_table[k].right)))
+		if ((left_type->kind == widen_table[k].left->kind) && (right_type->kind == widen_table[k].right->kind))
                       return widen_table[k].result;
 	return NULL;
 }
@@ -1432,25 +1433,36 @@ void *fill_candidate_datatypes_c::visit(configuration_declaration_c *symbol) {
 
 /*| instruction_list il_instruction */
 // SYM_LIST(instruction_list_c)
+/* Filling the candidate datatypes of an IL instruction list is a forward data flow problem:
+ * the candidate datatypes of an il_instruction depend on those of all the il_instructions that
+ * may be executed immediately before it. Since IL instruction lists may contain JMPs to labels that
+ * come before the JMP instruction itself, e.g.:  ...
+ *          ld 23
+ *   label1:st byte_var
+ *          ld 34
+ *          JMP label1     
+ *
+ * we must iterate until a fixpoint is reached. The re-evaluation of a basic block only affects
+ * the following basic blocks if the candidate datatypes of its last il_instruction have changed.
+ */
+class fill_candidate_datatypes_il_problem_c: public il_dataflow_problem_c {
+  private:
+    visitor_c &fill_visitor;
+  public:
+    fill_candidate_datatypes_il_problem_c(visitor_c &visitor): fill_visitor(visitor) {}
+    direction_t direction(void) {return forward;}
+    bool transfer(il_basic_block_c *block) {
+      std::vector <symbol_c *> prev_candidates = block->last()->candidate_datatypes;
+      for (unsigned int i = 0; i < block->instructions.size(); i++)
+        block->instructions[i]->accept(fill_visitor);
+      return (prev_candidates != block->last()->candidate_datatypes);
+    }
+};
+
+
 void *fill_candidate_datatypes_c::visit(instruction_list_c *symbol) {
-	/* In order to fill the data type candidates correctly
-	 * in IL instruction lists containing JMPs to labels that come before the JMP instruction
-	 * itself, we need to run the fill candidate datatypes algorithm twice on the Instruction List.
-	 * e.g.:  ...
-	 *          ld 23
-	 *   label1:st byte_var
-	 *          ld 34
-	 *          JMP label1     
-	 *
-	 * Note that the second time we run the algorithm, most of the candidate datatypes are already filled
-	 * in, so it will be able to produce tha correct candidate datatypes for the IL instruction referenced
-	 * by the label, as in the 2nd pass we already know the candidate datatypes of the JMP instruction!
-	 */
-	for(int j = 0; j < 2; j++) {
-		for(int i = 0; i < symbol->n; i++) {
-			symbol->elements[i]->accept(*this);
-		}
-	}
+	fill_candidate_datatypes_il_problem_c fill_problem(*this);
+	il_dataflow_solver_c::solve(symbol, &fill_problem);
 	return NULL;
 }
 
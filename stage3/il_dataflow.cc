@@ -0,0 +1,207 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Data flow analysis framework for IL code.
+ *  (see il_dataflow.hh for details)
+ */
+
+
+#include "il_dataflow.hh"
+#include <map>
+#include <set>
+
+
+
+/* set to 1 to see debug info during execution */
+static int debug = 0;
+
+
+
+/***********************************************************************/
+/***********************************************************************/
+/***        The il_cfg_c                                             ***/
+/***********************************************************************/
+/***********************************************************************/
+
+
+/* Does the il_instruction at position 'i' start a new basic block? */
+static bool is_block_leader(instruction_list_c *list, int i) {
+	if (i == 0) return true;
+	il_instruction_c *curr = dynamic_cast<il_instruction_c *>(list->elements[i  ]);
+	il_instruction_c *prev = dynamic_cast<il_instruction_c *>(list->elements[i-1]);
+	if ((NULL == curr) || (NULL == prev)) ERROR;
+
+	/* target of a JMP, or first instruction following a JMP or RET (i.e. unreachable code) */
+	if (curr->prev_il_instruction.size() != 1)    return true;
+	if (curr->prev_il_instruction[0]     != prev) return true;
+	/* instruction following a JMPC/JMPCN/RETC/RETCN/... */
+	if (prev->next_il_instruction.size() != 1)    return true;
+	if (prev->next_il_instruction[0]     != curr) return true;
+	return false;
+}
+
+
+il_cfg_c::il_cfg_c(instruction_list_c *instruction_list) {
+	std::vector <il_basic_block_c *> src_order;
+	std::map <symbol_c *, il_basic_block_c *> block_of;
+	reachable = 0;
+
+	if (NULL == instruction_list) ERROR;
+
+	/* 1st: split the instruction list into basic blocks */
+	for (int i = 0; i < instruction_list->n; i++) {
+		il_instruction_c *instruction = dynamic_cast<il_instruction_c *>(instruction_list->elements[i]);
+		if (NULL == instruction) ERROR;
+		if (is_block_leader(instruction_list, i))
+			src_order.push_back(new il_basic_block_c());
+		src_order.back()->instructions.push_back(instruction);
+		block_of[instruction] = src_order.back();
+	}
+
+	/* 2nd: link the basic blocks, using the edges found by flow_control_analysis_c */
+	for (unsigned int b = 0; b < src_order.size(); b++) {
+		il_instruction_c *last = src_order[b]->last();
+		for (unsigned int j = 0; j < last->next_il_instruction.size(); j++) {
+			std::map <symbol_c *, il_basic_block_c *>::iterator iter = block_of.find(last->next_il_instruction[j]);
+			if (iter == block_of.end()) ERROR;  /* JMP to an il_instruction in another instruction list?? */
+			il_basic_block_c *next = iter->second;
+			if (next->first() != last->next_il_instruction[j]) ERROR;  /* JMP into the middle of a basic block?? */
+			src_order[b]->succ.push_back(next);
+			next->pred.push_back(src_order[b]);
+		}
+	}
+
+	/* 3rd: number the blocks in reverse post order */
+	if (src_order.empty())
+		return;
+	std::vector <il_basic_block_c *> postorder;
+	dfs(src_order[0], postorder);
+	reachable = postorder.size();
+	for (int i = postorder.size() - 1; i >= 0; i--) {
+		postorder[i]->rpo = blocks.size();
+		blocks.push_back(postorder[i]);
+	}
+	/* unreachable code goes at the end */
+	for (unsigned int b = 0; b < src_order.size(); b++) {
+		if (src_order[b]->rpo >= 0) continue;
+		src_order[b]->rpo = blocks.size();
+		blocks.push_back(src_order[b]);
+	}
+
+	if (debug) printf("il_cfg_c: %d instructions in %d basic blocks (%d reachable)\n", instruction_list->n, (int)blocks.size(), reachable);
+}
+
+
+il_cfg_c::~il_cfg_c(void) {
+	for (unsigned int b = 0; b < blocks.size(); b++)
+		delete blocks[b];
+}
+
+
+/* Depth first search of the graph. We do not use recursion, as machine generated IL
+ * code may very well contain a few hundred thousand basic blocks!
+ * While visiting we use rpo == -2 to mark the blocks that have already been reached.
+ */
+void il_cfg_c::dfs(il_basic_block_c *entry, std::vector <il_basic_block_c *> &postorder) {
+	std::vector <std::pair <il_basic_block_c *, unsigned int> > stack;
+
+	entry->rpo = -2;
+	stack.push_back(std::make_pair(entry, 0u));
+	while (!stack.empty()) {
+		il_basic_block_c *block = stack.back().first;
+		unsigned int     &edge  = stack.back().second;
+		if (edge < block->succ.size()) {
+			il_basic_block_c *next = block->succ[edge++];
+			if (next->rpo == -1) {
+				next->rpo = -2;
+				stack.push_back(std::make_pair(next, 0u));
+			}
+		} else {
+			postorder.push_back(block);
+			stack.pop_back();
+		}
+	}
+	/* reset the marks. The caller will set the correct value. */
+	for (unsigned int i = 0; i < postorder.size(); i++)
+		postorder[i]->rpo = -1;
+}
+
+
+
+/***********************************************************************/
+/***********************************************************************/
+/***        The il_dataflow_solver_c                                 ***/
+/***********************************************************************/
+/***********************************************************************/
+
+
+int il_dataflow_solver_c::solve(il_cfg_c *cfg, il_dataflow_problem_c *problem) {
+	int  n        = cfg->blocks.size();
+	bool forward  = (problem->direction() == il_dataflow_problem_c::forward);
+	int  evaluations = 0;
+	/* the worklist is ordered by RPO for forward problems, and by inverse RPO for backward problems. */
+	std::set <int>     worklist;
+	std::vector <bool> in_worklist(n, true);
+
+	#define BLOCK_KEY(block) (forward? (block)->rpo : n - 1 - (block)->rpo)
+	for (int i = 0; i < n; i++)
+		worklist.insert(i);
+
+	while (!worklist.empty()) {
+		int key = *worklist.begin();
+		worklist.erase(worklist.begin());
+		il_basic_block_c *block = cfg->blocks[forward? key : n - 1 - key];
+		in_worklist[block->rpo] = false;
+
+		evaluations++;
+		if (!problem->transfer(block))
+			continue;
+
+		std::vector <il_basic_block_c *> &affected = forward? block->succ : block->pred;
+		for (unsigned int j = 0; j < affected.size(); j++) {
+			if (in_worklist[affected[j]->rpo]) continue;
+			in_worklist[affected[j]->rpo] = true;
+			worklist.insert(BLOCK_KEY(affected[j]));
+		}
+	}
+	#undef BLOCK_KEY
+
+	if (debug) printf("il_dataflow_solver_c: %d basic blocks, %d evaluations\n", n, evaluations);
+	return evaluations;
+}
+
+
+int il_dataflow_solver_c::solve(instruction_list_c *instruction_list, il_dataflow_problem_c *problem) {
+	il_cfg_c cfg(instruction_list);
+	return solve(&cfg, problem);
+}
@@ -0,0 +1,130 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Data flow analysis framework for IL code.
+ *
+ *  The flow_control_analysis_c visitor links every il_instruction_c to all the
+ *  il_instructions that may be executed immediately before/after it (the
+ *  prev_il_instruction and next_il_instruction vectors).
+ *
+ *  il_cfg_c groups the il_instruction_c objects of an instruction_list_c into
+ *  basic blocks (maximal sequences of instructions with a single entry and a
+ *  single exit), linked to each other by the JMP/fall-through edges found by
+ *  the flow control analysis. The blocks are numbered in reverse post order
+ *  (RPO) of a depth first search starting at the first instruction. Blocks
+ *  that cannot be reached from the first instruction are numbered after the
+ *  reachable ones, in source code order.
+ *
+ *  il_dataflow_solver_c runs a worklist algorithm over the basic blocks until
+ *  a fixpoint is reached. The analysis itself is described by an object that
+ *  inherits from il_dataflow_problem_c, which will re-evaluate a basic block
+ *  (transfer function) and tell the solver whether the data that is flowing
+ *  out of that block has changed. The worklist is kept ordered by RPO (or by
+ *  inverse RPO for backward problems), so for monotone analyses on reducible
+ *  graphs (i.e. IL code whose loops are only entered at the loop label) the
+ *  solver converges in a number of passes bounded by the loop nesting depth,
+ *  with each pass only touching the blocks that really need re-evaluating.
+ *
+ *  NOTE: This framework assumes that flow control analysis has already been
+ *        completed, so be sure to run flow_control_analysis_c first!
+ */
+
+
+#ifndef _IL_DATAFLOW_HH
+#define _IL_DATAFLOW_HH
+
+#include <vector>
+#include "../absyntax_utils/absyntax_utils.hh"
+
+
+
+class il_basic_block_c {
+  public:
+    int rpo;  /* position of this block in il_cfg_c::blocks, i.e. its reverse post order number */
+    std::vector <il_instruction_c *> instructions;  /* in source code order */
+    std::vector <il_basic_block_c *> pred;
+    std::vector <il_basic_block_c *> succ;
+
+  public:
+    il_basic_block_c(void) {rpo = -1;}
+    il_instruction_c *first(void) {return instructions.front();}
+    il_instruction_c *last (void) {return instructions.back ();}
+};
+
+
+
+class il_cfg_c {
+  public:
+    /* blocks[i]->rpo == i, and blocks[0] (if it exists) is the entry block. */
+    std::vector <il_basic_block_c *> blocks;
+
+  public:
+    il_cfg_c(instruction_list_c *instruction_list);
+    ~il_cfg_c(void);
+
+    /* the number of the blocks that can be reached from the entry block. */
+    int reachable_count(void) {return reachable;}
+
+  private:
+    int reachable;
+    void dfs(il_basic_block_c *block, std::vector <il_basic_block_c *> &postorder);
+};
+
+
+
+class il_dataflow_problem_c {
+  public:
+    typedef enum {forward, backward} direction_t;
+
+    virtual ~il_dataflow_problem_c(void) {}
+    virtual direction_t direction(void) = 0;
+    /* (Re-)evaluate the basic block. Must return true if the data that the
+     * block passes on to its successors (forward problems) or to its
+     * predecessors (backward problems) has changed.
+     */
+    virtual bool transfer(il_basic_block_c *block) = 0;
+};
+
+
+
+class il_dataflow_solver_c {
+  public:
+    /* Every block is evaluated at least once, even if it is unreachable.
+     * Returns the number of calls made to problem->transfer().
+     */
+    static int solve(il_cfg_c *cfg, il_dataflow_problem_c *problem);
+    static int solve(instruction_list_c *instruction_list, il_dataflow_problem_c *problem);
+};
+
+
+#endif /* _IL_DATAFLOW_HH */
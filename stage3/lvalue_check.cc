@@ -173,63 +173,63 @@ void lvalue_check_c::check_assignment_to_expression(symbol_c *lvalue) {
 	     /******************************/
 	     /* B 1.2.1 - Numeric Literals */
 	     /******************************/
-	     (typeid( *lvalue ) == typeid( real_c                         )) ||
-	     (typeid( *lvalue ) == typeid( integer_c                      )) ||
-	     (typeid( *lvalue ) == typeid( binary_integer_c               )) ||
-	     (typeid( *lvalue ) == typeid( octal_integer_c                )) ||
-	     (typeid( *lvalue ) == typeid( hex_integer_c                  )) ||
-	     (typeid( *lvalue ) == typeid( neg_real_c                     )) ||
-	     (typeid( *lvalue ) == typeid( neg_integer_c                  )) ||
-	     (typeid( *lvalue ) == typeid( integer_literal_c              )) ||
-	     (typeid( *lvalue ) == typeid( real_literal_c                 )) ||
-	     (typeid( *lvalue ) == typeid( bit_string_literal_c           )) ||
-	     (typeid( *lvalue ) == typeid( boolean_literal_c              )) ||
-	     (typeid( *lvalue ) == typeid( boolean_true_c                 )) || /* should not really be needed */
-	     (typeid( *lvalue ) == typeid( boolean_false_c                )) || /* should not really be needed */
+	     (lvalue->kind == kind_real_c                         ) ||
+	     (lvalue->kind == kind_integer_c                      ) ||
+	     (lvalue->kind == kind_binary_integer_c               ) ||
+	     (lvalue->kind == kind_octal_integer_c                ) ||
+	     (lvalue->kind == kind_hex_integer_c                  ) ||
+	     (lvalue->kind == kind_neg_real_c                     ) ||
+	     (lvalue->kind == kind_neg_integer_c                  ) ||
+	     (lvalue->kind == kind_integer_literal_c              ) ||
+	     (lvalue->kind == kind_real_literal_c                 ) ||
+	     (lvalue->kind == kind_bit_string_literal_c           ) ||
+	     (lvalue->kind == kind_boolean_literal_c              ) ||
+	     (lvalue->kind == kind_boolean_true_c                 ) || /* should not really be needed */
+	     (lvalue->kind == kind_boolean_false_c                ) || /* should not really be needed */
 	     /*******************************/
 	     /* B.1.2.2   Character Strings */
 	     /*******************************/
-	     (typeid( *lvalue ) == typeid( double_byte_character_string_c )) ||
-	     (typeid( *lvalue ) == typeid( single_byte_character_string_c )) ||
+	     (lvalue->kind == kind_double_byte_character_string_c ) ||
+	     (lvalue->kind == kind_single_byte_character_string_c ) ||
 	     /***************************/
 	     /* B 1.2.3 - Time Literals */
 	     /***************************/
 	     /************************/
 	     /* B 1.2.3.1 - Duration */
 	     /************************/
-	     (typeid( *lvalue ) == typeid( duration_c                     )) ||
+	     (lvalue->kind == kind_duration_c                     ) ||
 	     /************************************/
 	     /* B 1.2.3.2 - Time of day and Date */
 	     /************************************/
-	     (typeid( *lvalue ) == typeid( time_of_day_c                  )) ||
-	     (typeid( *lvalue ) == typeid( daytime_c                      )) || /* should not really be needed */
-	     (typeid( *lvalue ) == typeid( date_c                         )) || /* should not really be needed */
-	     (typeid( *lvalue ) == typeid( date_literal_c                 )) ||
-	     (typeid( *lvalue ) == typeid( date_and_time_c                )) ||
+	     (lvalue->kind == kind_time_of_day_c                  ) ||
+	     (lvalue->kind == kind_daytime_c                      ) || /* should not really be needed */
+	     (lvalue->kind == kind_date_c                         ) || /* should not really be needed */
+	     (lvalue->kind == kind_date_literal_c                 ) ||
+	     (lvalue->kind == kind_date_and_time_c                ) ||
 	     /***************************************/
 	     /* B.3 - Language ST (Structured Text) */
 	     /***************************************/
 	     /***********************/
 	     /* B 3.1 - Expressions */
 	     /***********************/
-	     (typeid( *lvalue ) == typeid( or_expression_c                )) ||
-	     (typeid( *lvalue ) == typeid( xor_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( and_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( equ_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( notequ_expression_c            )) ||
-	     (typeid( *lvalue ) == typeid( lt_expression_c                )) ||
-	     (typeid( *lvalue ) == typeid( gt_expression_c                )) ||
-	     (typeid( *lvalue ) == typeid( le_expression_c                )) ||
-	     (typeid( *lvalue ) == typeid( ge_expression_c                )) ||
-	     (typeid( *lvalue ) == typeid( add_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( sub_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( mul_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( div_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( mod_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( power_expression_c             )) ||
-	     (typeid( *lvalue ) == typeid( neg_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( not_expression_c               )) ||
-	     (typeid( *lvalue ) == typeid( function_invocation_c          )))
+	     (lvalue->kind == kind_or_expression_c                ) ||
+	     (lvalue->kind == kind_xor_expression_c               ) ||
+	     (lvalue->kind == kind_and_expression_c               ) ||
+	     (lvalue->kind == kind_equ_expression_c               ) ||
+	     (lvalue->kind == kind_notequ_expression_c            ) ||
+	     (lvalue->kind == kind_lt_expression_c                ) ||
+	     (lvalue->kind == kind_gt_expression_c                ) ||
+	     (lvalue->kind == kind_le_expression_c                ) ||
+	     (lvalue->kind == kind_ge_expression_c                ) ||
+	     (lvalue->kind == kind_add_expression_c               ) ||
+	     (lvalue->kind == kind_sub_expression_c               ) ||
+	     (lvalue->kind == kind_mul_expression_c               ) ||
+	     (lvalue->kind == kind_div_expression_c               ) ||
+	     (lvalue->kind == kind_mod_expression_c               ) ||
+	     (lvalue->kind == kind_power_expression_c             ) ||
+	     (lvalue->kind == kind_neg_expression_c               ) ||
+	     (lvalue->kind == kind_not_expression_c               ) ||
+	     (lvalue->kind == kind_function_invocation_c          ))
 		STAGE3_ERROR(0, lvalue, lvalue, "Assignment to an expression or a literal value is not allowed.");
 }                                                                  
 
@@ -248,7 +248,7 @@ void lvalue_check_c::check_assignment_to_il_list(symbol_c *lvalue) {
 	     /***********************************/
 	     /* B 2.1 Instructions and Operands */
 	     /***********************************/
-	     (typeid( *lvalue ) == typeid( simple_instr_list_c)))
+	     (lvalue->kind == kind_simple_instr_list_c))
 		STAGE3_ERROR(0, lvalue, lvalue, "Assigning an IL list to an IN_OUT parameter is not allowed.");
 }                                                                  
 
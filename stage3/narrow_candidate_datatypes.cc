@@ -55,6 +55,7 @@
 
 #include "narrow_candidate_datatypes.hh"
 #include "datatype_functions.hh"
+#include "il_dataflow.hh"
 #include <typeinfo>
 #include <list>
 #include <string>
@@ -81,8 +82,8 @@ static void set_datatype(symbol_c *datatype, symbol_c *symbol) {
   
 	/* If we are trying to set to the undefined type, and the symbol's datatype has already been set to something else, 
 	 * we abort the compoiler as I don't think this should ever occur. 
-	 * NOTE: In order to handle JMPs to labels that come before the JMP itself, we run the narrow algorithm twice.
-	 *       This means that this situation may legally occur, so we cannot abort the compiler here!
+	 * NOTE: In order to handle JMPs to labels that come before the JMP itself, we run the narrow algorithm on IL code
+	 *       until a fixpoint is reached (see visit(instruction_list_c *)). This means that this situation may legally occur, so we cannot abort the compiler here!
 	 */
 // 	if ((NULL == datatype) && (NULL != symbol->datatype)) ERROR;
  	if ((NULL == datatype) && (NULL != symbol->datatype)) return;
@@ -124,9 +125,9 @@ bool narrow_candidate_datatypes_c::is_widening_compatible(const struct widen_ent
 		return false;
 
 	for (int k = 0; NULL != widen_table[k].left;  k++) {
-		if        ((typeid(*left_type)   == typeid(*widen_table[k].left))
-		        && (typeid(*right_type)  == typeid(*widen_table[k].right))
-			&& (typeid(*result_type) == typeid(*widen_table[k].result))) {
+		if        ((left_type->kind   == widen_table[k].left->kind)
+		        && (right_type->kind  == widen_table[k].right->kind)
+			&& (result_type->kind == widen_table[k].result->kind)) {
 			if (NULL != deprecated_status)
 				*deprecated_status = (widen_table[k].status == widen_entry::deprecated);
 			return true;
@@ -841,28 +842,42 @@ void *narrow_candidate_datatypes_c::visit(configuration_declaration_c *symbol) {
 
 /*| instruction_list il_instruction */
 // SYM_LIST(instruction_list_c)
+/* Narrowing the datatypes of an IL instruction list is a backward data flow problem:
+ * the datatype an il_instruction must produce is chosen by all the il_instructions that may be
+ * executed immediately after it. We must therefore go through the instructions backwards, so we
+ * can not use the base class' visitor.
+ * In IL instruction lists containing JMPs to labels that come before the JMP instruction
+ * itself, e.g.:  ...
+ *          ld 23
+ *   label1:st byte_var
+ *          ld 34
+ *          JMP label1     
+ *
+ * we must iterate until a fixpoint is reached. The re-evaluation of a basic block only affects the
+ * preceding basic blocks if it has changed the datatype of the il_instructions that end those blocks.
+ */
+class narrow_candidate_datatypes_il_problem_c: public il_dataflow_problem_c {
+  private:
+    visitor_c &narrow_visitor;
+  public:
+    narrow_candidate_datatypes_il_problem_c(visitor_c &visitor): narrow_visitor(visitor) {}
+    direction_t direction(void) {return backward;}
+    bool transfer(il_basic_block_c *block) {
+      std::vector <symbol_c *> prev_datatypes;
+      for (unsigned int j = 0; j < block->pred.size(); j++)
+        prev_datatypes.push_back(block->pred[j]->last()->datatype);
+      for (int i = block->instructions.size() - 1; i >= 0; i--)
+        block->instructions[i]->accept(narrow_visitor);
+      for (unsigned int j = 0; j < block->pred.size(); j++)
+        if (prev_datatypes[j] != block->pred[j]->last()->datatype) return true;
+      return false;
+    }
+};
+
+
 void *narrow_candidate_datatypes_c::visit(instruction_list_c *symbol) {
-	/* In order to execute the narrow algoritm correctly, we need to go through the instructions backwards,
-	 * so we can not use the base class' visitor 
-	 */
-	/* In order to execute the narrow algoritm correctly
-	 * in IL instruction lists containing JMPs to labels that come before the JMP instruction
-	 * itself, we need to run the narrow algorithm twice on the Instruction List.
-	 * e.g.:  ...
-	 *          ld 23
-	 *   label1:st byte_var
-	 *          ld 34
-	 *          JMP label1     
-	 *
-	 * Note that the second time we run the narrow, most of the datatypes are already filled
-	 * in, so it will be able to produce tha correct datatypes for the IL instruction referenced
-	 * by the label, as in the 2nd pass we already know the datatypes of the JMP instruction!
-	 */
-	for(int j = 0; j < 2; j++) {
-		for(int i = symbol->n-1; i >= 0; i--) {
-			symbol->elements[i]->accept(*this);
-		}
-	}
+	narrow_candidate_datatypes_il_problem_c narrow_problem(*this);
+	il_dataflow_solver_c::solve(symbol, &narrow_problem);
 	return NULL;
 }
 
@@ -44,6 +44,7 @@
 #include "constant_folding.hh"
 #include "declaration_check.hh"
 #include "enum_declaration_check.hh"
+#include "../time_report.hh"
 
 
 static int enum_declaration_check(symbol_c *tree_root){
@@ -83,14 +84,22 @@ static int constant_folding(symbol_c *tree_root){
  * before calling this function
  */
 static int type_safety(symbol_c *tree_root){
+	time_report_begin("fill_candidate_datatypes");
 	fill_candidate_datatypes_c fill_candidate_datatypes(tree_root);
 	tree_root->accept(fill_candidate_datatypes);
+	time_report_end();
+	time_report_begin("narrow_candidate_datatypes");
 	narrow_candidate_datatypes_c narrow_candidate_datatypes(tree_root);
 	tree_root->accept(narrow_candidate_datatypes);
+	time_report_end();
+	time_report_begin("print_datatypes_error");
 	print_datatypes_error_c print_datatypes_error(tree_root);
 	tree_root->accept(print_datatypes_error);
+	time_report_end();
+	time_report_begin("forced_narrow_candidate_datatypes");
 	forced_narrow_candidate_datatypes_c forced_narrow_candidate_datatypes(tree_root);
 	tree_root->accept(forced_narrow_candidate_datatypes);
+	time_report_end();
 	return print_datatypes_error.get_error_count();
 }
 
@@ -114,15 +123,24 @@ static int array_range_check(symbol_c *tree_root){
 }
 
 
+/* Run a pass, timing it for the --time-report command line option */
+static int timed_pass(const char *name, int (*pass)(symbol_c *), symbol_c *tree_root){
+	time_report_begin(name);
+	int error_count = pass(tree_root);
+	time_report_end();
+	return error_count;
+}
+
+
 int stage3(symbol_c *tree_root){
 	int error_count = 0;
-	error_count += enum_declaration_check(tree_root);
-	error_count += declaration_safety(tree_root);
-	error_count += flow_control_analysis(tree_root);
-	error_count += constant_folding(tree_root);
-	error_count += type_safety(tree_root);
-	error_count += lvalue_check(tree_root);
-	error_count += array_range_check(tree_root);
+	error_count += timed_pass("enum_declaration_check", enum_declaration_check, tree_root);
+	error_count += timed_pass("declaration_safety",     declaration_safety,     tree_root);
+	error_count += timed_pass("flow_control_analysis",  flow_control_analysis,  tree_root);
+	error_count += timed_pass("constant_folding",       constant_folding,       tree_root);
+	error_count += timed_pass("type_safety",            type_safety,            tree_root);
+	error_count += timed_pass("lvalue_check",           lvalue_check,           tree_root);
+	error_count += timed_pass("array_range_check",      array_range_check,      tree_root);
 	
 	if (error_count > 0) {
 		fprintf(stderr, "%d error(s) found. Bailing out!\n", error_count); 
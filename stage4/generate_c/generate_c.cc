@@ -24,11 +24,15 @@
 
 #include <string>
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <typeinfo>
 #include <list>
 #include <map>
+#include <set>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 #include <strings.h>
 
 
@@ -89,6 +93,14 @@
 /* Idem as body, but for run CONFIG and RESOURCE function */
 #define FB_RUN_SUFFIX "_run__"
 
+/* The image of an initialised FB instance, kept by the FB initializer function
+ * (one for retained and one for non retained instances), and the flags
+ * telling whether each image has already been filled in.
+ * (please see the comment before generate_c_pous_c::print_init_image_begin() for details)
+ */
+#define FB_INIT_IMAGE       "__init_image"
+#define FB_INIT_IMAGE_VALID "__init_image_valid"
+
 /* The FB body function is passed as the only parameter a pointer to the FB data
  * structure instance. The name of this parameter is given by the following constant.
  * In order not to clash with any variable in the IL and ST source codem the
@@ -105,9 +117,18 @@
 
 #define SFC_STEP_ACTION_PREFIX "__SFC_"
 
+/* Appended to the name of an extensible standard function to get the name of
+ * its EN/ENO-free variant (see the note on the fast variants in lib/iec_std_lib.h)
+ */
+#define FAST_FUNCTION_SUFFIX "_fast__"
+
 
 /* Variable declaration symbol for accessor macros */
 #define DECLARE_VAR "__DECLARE_VAR"
+#define DECLARE_VAR_FLAGS "__DECLARE_VAR_FLAGS"
+#define DECLARE_FLAGS_BEGIN "__DECLARE_FLAGS_BEGIN"
+#define DECLARE_FLAGS_END "__DECLARE_FLAGS_END"
+#define DECLARE_SFC_FLAGS "__DECLARE_SFC_FLAGS"
 #define DECLARE_GLOBAL "__DECLARE_GLOBAL"
 #define DECLARE_GLOBAL_FB "__DECLARE_GLOBAL_FB"
 #define DECLARE_GLOBAL_LOCATION "__DECLARE_GLOBAL_LOCATION"
@@ -115,6 +136,7 @@
 #define DECLARE_EXTERNAL "__DECLARE_EXTERNAL"
 #define DECLARE_EXTERNAL_FB "__DECLARE_EXTERNAL_FB"
 #define DECLARE_LOCATED "__DECLARE_LOCATED"
+#define DECLARE_INPUT_REF "__DECLARE_INPUT_REF"
 #define DECLARE_GLOBAL_PROTOTYPE "__DECLARE_GLOBAL_PROTOTYPE"
 
 /* Variable declaration symbol for accessor macros */
@@ -126,6 +148,7 @@
 #define INIT_EXTERNAL_FB "__INIT_EXTERNAL_FB"
 #define INIT_LOCATED "__INIT_LOCATED"
 #define INIT_LOCATED_VALUE "__INIT_LOCATED_VALUE"
+#define RESET_INPUT_REF "__RESET_INPUT_REF"
 
 /* Variable getter symbol for accessor macros */
 #define GET_VAR "__GET_VAR"
@@ -136,12 +159,15 @@
 #define GET_EXTERNAL_BY_REF "__GET_EXTERNAL_BY_REF"
 #define GET_EXTERNAL_FB_BY_REF "__GET_EXTERNAL_FB_BY_REF"
 #define GET_LOCATED_BY_REF "__GET_LOCATED_BY_REF"
+#define GET_INPUT_REF "__GET_INPUT_REF"
+#define GET_INPUT_REF_BY_REF "__GET_INPUT_REF_BY_REF"
 
 /* Variable setter symbol for accessor macros */
 #define SET_VAR "__SET_VAR"
 #define SET_EXTERNAL "__SET_EXTERNAL"
 #define SET_EXTERNAL_FB "__SET_EXTERNAL_FB"
 #define SET_LOCATED "__SET_LOCATED"
+#define SET_INPUT_REF "__SET_INPUT_REF"
 
 /* Variable initial value symbol for accessor macros */
 #define INITIAL_VALUE "__INITIAL_VALUE"
@@ -158,6 +184,266 @@
 /* please see the comment before the RET_operator_c visitor for details... */
 #define END_LABEL VAR_LEADER "end"
 
+/* ends the #line directives that attribute the code back to the generated C file,
+ * so that generate_c_c::write_source_map() can set their line numbers.
+ */
+#define LINE_DIRECTIVE_END "/* C code */"
+
+
+/***********************************************************************/
+/***********************************************************************/
+
+/* Options of the C code generator, set with the -O command line option.
+ * (see stage4_parse_options() at the end of this file)
+ */
+typedef struct {
+    /* replace expressions whose value was determined in stage 3 (constant_folding_c) by the resulting literal */
+    bool fold_constants;
+    /* initialise FB instances by copying the image of a previously initialised instance */
+    bool init_image;
+    /* keep the flags of the variables of FB and program instances apart from their values
+     * (struct of arrays layout, see __IEC_SOA_LAYOUT in lib/accessor.h)
+     */
+    bool soa_layout;
+    /* declare the variables of FB and program instances ordered by use and alignment, not as in the source code */
+    bool reorder_fields;
+    /* pass the large inputs FBs only read by reference, instead of copying them on every call */
+    bool inputs_by_ref;
+    /* call the EN/ENO-free variants of the extensible standard functions when EN and ENO are not used */
+    bool fast_std_calls;
+    /* compute the ** operator in the data type of its result, with integer powers for integer exponents */
+    bool typed_expt;
+    /* also generate VARIABLES.c, the table of the addresses of the variables (see lib/iec_debug.h) */
+    bool debug_registry;
+    /* also generate PROCESS_IMAGE.c, laying out the located variables in contiguous images (see lib/iec_process_image.h) */
+    bool process_image;
+    /* time the programs of each task, and keep their statistics (see lib/iec_task_stats.h) */
+    bool task_stats;
+    /* count the calls to each POU, and the time spent in it (see lib/iec_profile.h) */
+    bool profile;
+    /* attribute the C code of each statement to its IEC 61131-3 source line, and also generate POUS.map */
+    bool line_directives;
+} generate_c_options_t;
+
+static generate_c_options_t generate_c_options = {
+    true,  /* fold_constants */
+    true,  /* init_image */
+    false, /* soa_layout */
+    false, /* reorder_fields */
+    false, /* inputs_by_ref */
+    true,  /* fast_std_calls */
+    true,  /* typed_expt */
+    false, /* debug_registry */
+    false, /* process_image */
+    false, /* task_stats */
+    false, /* profile */
+    false  /* line_directives */
+};
+
+/* The layout of the variables must be chosen before iec_std_lib.h
+ * (and therefore iec_types_all.h) is included by the generated code.
+ */
+static void print_layout_definition(stage4out_c &s4o) {
+  if (generate_c_options.soa_layout)
+    s4o.print("#define __IEC_SOA_LAYOUT\n");
+}
+
+
+
+/* With the 'inputs-by-ref' option the STRING, array and structure inputs of a FB
+ * are not copied into the FB instance on each call, as long as the FB only reads
+ * them. The caller instead binds the input, for the duration of the call, to the
+ * variable it passes to the input (__SET_INPUT_REF() in lib/accessor.h), and the
+ * FB reads the input through that pointer (__GET_INPUT_REF()).
+ * When an expression (and not a variable) is passed to the input, it is copied
+ * into the FB instance as before, and the pointer is made to point to that copy.
+ * Note that the value in the FB instance of an input bound to a variable is not
+ * updated by the calls, so the debugger shows a stale value for that input.
+ *
+ * An input keeps its value between calls, so between calls it must not be read
+ * through a pointer to a variable that may have changed in the mean time. An input
+ * is therefore only passed by reference if:
+ *   - the FB has no VAR_IN_OUT (through which the FB could change the variable
+ *     bound to the input), and does not assign the input (search_assigned_variables_c);
+ *   - the FB body contains no pragma (i.e. C code that could read the input);
+ *   - every call of every instance of the FB passes a value to the input, and
+ *     is an ST call of an instance that is not a VAR_EXTERNAL;
+ *   - the input is never read from outside the FB ('instance.input').
+ * The last condition is checked by name only, ignoring the type of the instance.
+ *
+ * The search needs to see the body of every POU, so it is not done (and no input
+ * is passed by reference) when the build cache is in use.
+ */
+class search_inputs_by_ref_c: public iterator_visitor_c {
+  private:
+    typedef std::set<std::string, nocasecmp_c> name_set_t;
+    /* FB type -> its inputs that may be passed by reference */
+    std::map<std::string, name_set_t, nocasecmp_c> candidates;
+    /* FB type -> its inputs that some call does not pass */
+    std::map<std::string, name_set_t, nocasecmp_c> not_passed;
+    /* FB types with an instance called in IL or as a VAR_EXTERNAL, or containing a pragma */
+    name_set_t excluded_fbs;
+    /* names of the fields of structured variables ('record.field') */
+    name_set_t fields;
+
+    symbol_c *current_pou_name;
+    search_fb_instance_decl_c  *search_fb_instance_decl;
+    search_var_instance_decl_c *search_var_instance_decl;
+
+    static const char *name_of(symbol_c *symbol) {
+      token_c *token = dynamic_cast<token_c *>(symbol);
+      if (NULL == token) ERROR;
+      return token->value;
+    }
+
+    static bool is_large_type(symbol_c *type) {
+      return get_datatype_info_c::is_ANY_STRING(search_base_type_c::get_basetype_decl(type))
+          || get_datatype_info_c::is_array(type)
+          || get_datatype_info_c::is_structure(type);
+    }
+
+    void visit_pou(symbol_c *pou_name, symbol_c *pou, symbol_c *body) {
+      current_pou_name         = pou_name;
+      search_fb_instance_decl  = new search_fb_instance_decl_c (pou);
+      search_var_instance_decl = new search_var_instance_decl_c(pou);
+      body->accept(*this);
+      delete search_fb_instance_decl;
+      delete search_var_instance_decl;
+      search_fb_instance_decl  = NULL;
+      search_var_instance_decl = NULL;
+      current_pou_name         = NULL;
+    }
+
+  public:
+    search_inputs_by_ref_c(symbol_c *tree_root) {
+      current_pou_name         = NULL;
+      search_fb_instance_decl  = NULL;
+      search_var_instance_decl = NULL;
+      tree_root->accept(*this);
+    }
+    virtual ~search_inputs_by_ref_c(void) {}
+
+    bool is_by_ref(const char *fb_type_name, const char *input_name) {
+      if (excluded_fbs.find(fb_type_name) != excluded_fbs.end()) return false;
+      if (fields.find(input_name) != fields.end())               return false;
+      if (candidates[fb_type_name].find(input_name) == candidates[fb_type_name].end()) return false;
+      return not_passed[fb_type_name].find(input_name) == not_passed[fb_type_name].end();
+    }
+
+    bool has_inputs_by_ref(const char *fb_type_name) {
+      name_set_t &inputs = candidates[fb_type_name];
+      for (name_set_t::iterator i = inputs.begin(); i != inputs.end(); i++)
+        if (is_by_ref(fb_type_name, i->c_str())) return true;
+      return false;
+    }
+
+    /***********************/
+    /* B 1.5.1 - Functions */
+    /***********************/
+    void *visit(function_declaration_c *symbol) {
+      symbol->function_body->accept(*this);
+      return NULL;
+    }
+
+    /*****************************/
+    /* B 1.5.2 - Function Blocks */
+    /*****************************/
+    void *visit(function_block_declaration_c *symbol) {
+      const char *fb_name = name_of(symbol->fblock_name);
+      name_set_t inputs;
+      search_assigned_variables_c search_assigned_variables(symbol);
+      function_param_iterator_c fp_iterator(symbol);
+      identifier_c *param_name;
+      while ((param_name = fp_iterator.next()) != NULL) {
+        if (fp_iterator.param_direction() == function_param_iterator_c::direction_inout) {
+          inputs.clear();
+          break;
+        }
+        if ((fp_iterator.param_direction() == function_param_iterator_c::direction_in) &&
+            is_large_type(fp_iterator.param_type()) &&
+            !search_assigned_variables.is_assigned(param_name))
+          inputs.insert(param_name->value);
+      }
+      candidates[fb_name] = inputs;
+      visit_pou(symbol->fblock_name, symbol, symbol->fblock_body);
+      return NULL;
+    }
+
+    /**********************/
+    /* B 1.5.3 - Programs */
+    /**********************/
+    void *visit(program_declaration_c *symbol) {
+      visit_pou(symbol->program_type_name, symbol, symbol->function_block_body);
+      return NULL;
+    }
+
+    /********************/
+    /* 2.1.6 - Pragmas  */
+    /********************/
+    void *visit(pragma_c *symbol) {
+      if (NULL != current_pou_name)
+        excluded_fbs.insert(name_of(current_pou_name));
+      return NULL;
+    }
+
+    /*************************************/
+    /* B.1.4.2   Multi-element Variables */
+    /*************************************/
+    void *visit(structured_variable_c *symbol) {
+      fields.insert(name_of(symbol->field_selector));
+      symbol->record_variable->accept(*this);
+      return NULL;
+    }
+
+    /***********************************/
+    /* B 2.1 Instructions and Operands */
+    /***********************************/
+    void *visit(il_fb_call_c *symbol) {
+      symbol_c *fb_type_name = search_fb_instance_decl->get_type_name(symbol->fb_name);
+      if (NULL != fb_type_name)
+        excluded_fbs.insert(name_of(fb_type_name));
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    /*****************************************/
+    /* B 3.2.2 Subprogram Control Statements */
+    /*****************************************/
+    void *visit(fb_invocation_c *symbol) {
+      symbol_c *fb_type_name = search_fb_instance_decl->get_type_name(symbol->fb_name);
+      if (NULL == fb_type_name) ERROR;
+      if (search_var_instance_decl->get_vartype(symbol->fb_name) == search_var_instance_decl_c::external_vt)
+        excluded_fbs.insert(name_of(fb_type_name));
+
+      function_block_declaration_c *fb_decl = function_block_type_symtable.find_value(fb_type_name);
+      if (fb_decl == function_block_type_symtable.end_value()) ERROR;
+
+      /* same search for the parameter values as generate_c_st_c::visit(fb_invocation_c *) */
+      function_param_iterator_c fp_iterator(fb_decl);
+      function_call_param_iterator_c function_call_param_iterator(symbol);
+      identifier_c *param_name;
+      while ((param_name = fp_iterator.next()) != NULL) {
+        symbol_c *param_value = function_call_param_iterator.search_f(param_name);
+        if ((param_value == NULL) && !fp_iterator.is_en_eno_param_implicit())
+          param_value = function_call_param_iterator.next_nf();
+        if ((param_value == NULL) && (fp_iterator.param_direction() == function_param_iterator_c::direction_in))
+          not_passed[name_of(fb_type_name)].insert(param_name->value);
+      }
+      return iterator_visitor_c::visit(symbol);
+    }
+}; // search_inputs_by_ref_c
+
+
+/* The inputs passed by reference, or NULL if the 'inputs-by-ref' option is not in use */
+static search_inputs_by_ref_c *search_inputs_by_ref = NULL;
+
+static bool is_input_by_ref(symbol_c *fb_type_name, symbol_c *input_name) {
+  if ((NULL == search_inputs_by_ref) || (NULL == fb_type_name) || (NULL == input_name)) return false;
+  token_c *fb_type_token = dynamic_cast<token_c *>(fb_type_name);
+  token_c *input_token   = dynamic_cast<token_c *>(input_name);
+  if ((NULL == fb_type_token) || (NULL == input_token)) return false;
+  return search_inputs_by_ref->is_by_ref(fb_type_token->value, input_token->value);
+}
+
 
 /***********************************************************************/
 /***********************************************************************/
@@ -333,6 +619,24 @@ class print_function_parameter_data_types_c: public generate_c_base_c {
      */
     void *visit(double_byte_string_var_declaration_c *symbol) {return NULL;}
 };
+
+
+/* The name of the C function called for a call to a standard function
+ * (the names of overloaded functions are appended the data types of their parameters).
+ */
+static std::string get_called_function_name(symbol_c *function_name, function_declaration_c *f_decl, int fdecl_mutiplicity) {
+  std::ostringstream buffer;
+  stage4out_c buffer_s4o(&buffer);
+  generate_c_base_c name_printer(&buffer_s4o);
+  function_name->accept(name_printer);
+  if (fdecl_mutiplicity > 1) {
+    /* function being called is overloaded! */
+    buffer_s4o.print("__");
+    print_function_parameter_data_types_c overloaded_func_suf(&buffer_s4o);
+    f_decl->accept(overloaded_func_suf);
+  }
+  return buffer.str();
+}
     
 
 /***********************************************************************/
@@ -1013,6 +1317,107 @@ class generate_c_datatypes_c: public generate_c_typedecl_c {
 /***********************************************************************/
 
 
+/* Determine whether the instances of a FB have located variables, either directly,
+ * or in any of the FB instances they contain.
+ * The initializer function of these FBs must always write the initial value of the
+ * located variables, so they cannot be initialised by copying an image of the instance.
+ */
+class search_located_var_decl_c: public iterator_visitor_c {
+  private:
+    bool found;
+    std::set<symbol_c *> visited;
+
+  public:
+    search_located_var_decl_c(void) {found = false;}
+    virtual ~search_located_var_decl_c(void) {}
+
+    bool has_located_vars(function_block_declaration_c *fb_decl) {
+      found = false;
+      visited.clear();
+      search(fb_decl);
+      return found;
+    }
+
+  private:
+    void search(function_block_declaration_c *fb_decl) {
+      if (visited.find(fb_decl) != visited.end()) return;
+      visited.insert(fb_decl);
+      /* only the declarations matter, not the body */
+      fb_decl->var_declarations->accept(*this);
+    }
+
+  public:
+    void *visit(located_var_decl_c *symbol)        {found = true; return NULL;}
+    void *visit(incompl_located_var_decl_c *symbol) {found = true; return NULL;}
+    void *visit(fb_spec_init_c *symbol) {
+      function_block_declaration_c *fb_decl = function_block_type_symtable.find_value(symbol->function_block_type_name);
+      if (fb_decl != function_block_type_symtable.end_value())
+        search(fb_decl);
+      return NULL;
+    }
+}; // search_located_var_decl_c
+
+
+
+/* Collect the identifiers appearing in the body of a POU, to tell which of
+ * its internal variables are never referenced (see print_reordered_fields()).
+ */
+class search_referenced_identifiers_c: public iterator_visitor_c {
+  private:
+    std::set<std::string> names;
+
+    static std::string upper(const char *name) {
+      std::string str(name);
+      for (size_t i = 0; i < str.size(); i++) str[i] = toupper(str[i]);
+      return str;
+    }
+
+  public:
+    search_referenced_identifiers_c(symbol_c *body) {if (NULL != body) body->accept(*this);}
+    virtual ~search_referenced_identifiers_c(void) {}
+
+    bool is_referenced(const std::string &name) {return names.find(upper(name.c_str())) != names.end();}
+
+    void *visit(identifier_c *symbol) {names.insert(upper(symbol->value)); return NULL;}
+}; // search_referenced_identifiers_c
+
+
+
+/* Collect the variables declared by a POU, in source code order, each with the name
+ * generate_c_vardecl_c declares it with (see print_reordered_fields()).
+ */
+class search_declared_variables_c: public iterator_visitor_c {
+  public:
+    typedef struct {
+      symbol_c *name;        /* the location, for located variables without a name */
+      bool      is_pointer;  /* EXTERNAL and located variables */
+    } variable_t;
+    std::vector<variable_t> variables;
+
+  private:
+    void add(symbol_c *name, bool is_pointer) {
+      variable_t variable = {name, is_pointer};
+      variables.push_back(variable);
+    }
+
+  public:
+    search_declared_variables_c(symbol_c *var_declarations) {if (NULL != var_declarations) var_declarations->accept(*this);}
+    virtual ~search_declared_variables_c(void) {}
+
+    void *visit(var1_list_c *symbol)             {for (int i = 0; i < symbol->n; i++) add(symbol->elements[i], false); return NULL;}
+    void *visit(fb_name_list_c *symbol)          {for (int i = 0; i < symbol->n; i++) add(symbol->elements[i], false); return NULL;}
+    void *visit(en_param_declaration_c *symbol)  {add(symbol->name, false); return NULL;}
+    void *visit(eno_param_declaration_c *symbol) {add(symbol->name, false); return NULL;}
+    void *visit(external_declaration_c *symbol)  {add(symbol->global_var_name, true); return NULL;}
+    void *visit(located_var_decl_c *symbol) {
+      add((NULL != symbol->variable_name)? symbol->variable_name : symbol->location, true);
+      return NULL;
+    }
+}; // search_declared_variables_c
+
+
+
+
 class generate_c_pous_c: public generate_c_typedecl_c {
   private:
     stage4out_c *s4o_ptr;
@@ -1047,6 +1452,243 @@ class generate_c_pous_c: public generate_c_typedecl_c {
       s4o.print(":\n");
       s4o.indent_right();
     }
+
+    /* The calls to the POUs are counted and timed in the record of each POU (see
+     * lib/iec_profile.h). The whole body is timed: the RETURN statements jump to
+     * the end label, just before __IEC_PROFILE_EXIT().
+     */
+    void print_profile_enter(symbol_c *pou_name) {
+      if (!generate_c_options.profile)
+        return;
+      s4o.print(s4o.indent_spaces + "__IEC_PROFILE_ENTER(\"");
+      pou_name->accept(*this);
+      s4o.print("\")\n");
+    }
+
+    void print_profile_exit(void) {
+      if (!generate_c_options.profile)
+        return;
+      s4o.print(s4o.indent_spaces + "__IEC_PROFILE_EXIT()\n");
+    }
+
+    /* Cold start of a PLC with many FB instances spends most of its time in the FB
+     * initializer functions, assigning the initial value of every member one by one.
+     * Since every instance of a FB type starts off with the same values (the bindings
+     * of the EXTERNAL variables to the global variables included, as these never change),
+     * the initializer function keeps a copy of the first instance it initialises, and
+     * initialises all the following instances by copying this image.
+     * The EXTERNAL bindings are then re-done anyway (a cheap pointer assignment each), which
+     * is the only per instance fix-up required. FBs with located variables, directly or in a
+     * nested FB instance, always do the full initialisation (see search_located_var_decl_c).
+     *
+     *  void FB_init__(FB *data__, BOOL retain) {
+     *    static FB __init_image[2];
+     *    static BOOL __init_image_valid[2] = {0, 0};
+     *    if (__init_image_valid[retain != 0]) {
+     *      *data__ = __init_image[retain != 0];
+     *      <initialise the EXTERNAL variables>
+     *      return;
+     *    }
+     *    <initialise all variables, as usual>
+     *    __init_image[retain != 0] = *data__;
+     *    __init_image_valid[retain != 0] = 1;
+     *  }
+     */
+    bool use_init_image(function_block_declaration_c *symbol) {
+      search_located_var_decl_c search_located_var_decl;
+      return generate_c_options.init_image && !search_located_var_decl.has_located_vars(symbol);
+    }
+
+    void print_init_image_begin(function_block_declaration_c *symbol) {
+      s4o.print(s4o.indent_spaces + "static ");
+      symbol->fblock_name->accept(*this);
+      s4o.print(" " FB_INIT_IMAGE "[2];\n");
+      s4o.print(s4o.indent_spaces + "static BOOL " FB_INIT_IMAGE_VALID "[2] = {0, 0};\n");
+      s4o.print(s4o.indent_spaces + "if (" FB_INIT_IMAGE_VALID "[retain != 0]) {\n");
+      s4o.indent_right();
+      s4o.print(s4o.indent_spaces + "*" FB_FUNCTION_PARAM " = " FB_INIT_IMAGE "[retain != 0];\n");
+      s4o.print(s4o.indent_spaces);
+      generate_c_vardecl_c vardecl(&s4o, generate_c_vardecl_c::constructorinit_vf, generate_c_vardecl_c::external_vt);
+      vardecl.print(symbol->var_declarations, NULL, FB_FUNCTION_PARAM"->");
+      s4o.print("\n");
+      print_input_refs_init(symbol);
+      s4o.print(s4o.indent_spaces + "return;\n");
+      s4o.indent_left();
+      s4o.print(s4o.indent_spaces + "}\n");
+    }
+
+    void print_init_image_end(function_block_declaration_c *symbol) {
+      s4o.print(s4o.indent_spaces + FB_INIT_IMAGE "[retain != 0] = *" FB_FUNCTION_PARAM ";\n");
+      s4o.print(s4o.indent_spaces + FB_INIT_IMAGE_VALID "[retain != 0] = 1;\n");
+    }
+
+    /* With the 'reorder-fields' option the variables of the instance struct of a FB or
+     * program are not declared in source code order, but
+     *   - the hot variables first: the interface (EN/ENO, inputs, outputs, in_outs), the
+     *     EXTERNAL and located variables, and the internal variables referenced in the body;
+     *   - then the cold variables: the internal variables the body never references (such
+     *     as configuration and diagnostic values, only accessed by the HMI or the debugger);
+     * each group by decreasing alignment, so no padding is left between the variables.
+     * The number of each variable in VARIABLES.csv (through which the HMI and the debugger
+     * access the variables) follows the source code, so it does not depend on this order.
+     *
+     * The variables are sorted by their declarations, and then each one is declared on
+     * its own by generate_c_vardecl_c.
+     */
+    typedef struct {
+      symbol_c *name;
+      bool      cold;
+      int       alignment;
+    } field_t;
+
+    static bool field_order(const field_t &a, const field_t &b) {
+      if (a.cold != b.cold) return !a.cold;
+      return a.alignment > b.alignment;
+    }
+
+    /* The largest alignment (in bytes) of a C type: that of pointers, 64 bit integers,
+     * doubles and struct timespec (TIME and dates) on 64 bit targets.
+     */
+    static const int max_alignment = 8;
+
+    /* The alignment (in bytes) of a value of the given type, as stored in the instance struct */
+    static int type_alignment(symbol_c *type_decl) {
+      symbol_c *base_type = (NULL == type_decl)? NULL : search_base_type_c::get_basetype_decl(type_decl);
+      if (NULL == base_type)                             return max_alignment;
+      if (get_datatype_info_c::is_ANY_STRING(base_type)) return 1;  /* an array of char */
+      if (get_datatype_info_c::is_enumerated(base_type)) return 4;  /* a C enum */
+
+      /* arrays: the alignment of their elements */
+      array_specification_c *array = dynamic_cast<array_specification_c *>(base_type);
+      if (NULL != array)
+        return type_alignment(array->non_generic_type_name);
+
+      /* structures: the largest alignment of their elements */
+      structure_element_declaration_list_c *elements = dynamic_cast<structure_element_declaration_list_c *>(base_type);
+      if (NULL != elements) {
+        int alignment = 1;
+        for (int i = 0; i < elements->n; i++) {
+          structure_element_declaration_c *element = dynamic_cast<structure_element_declaration_c *>(elements->elements[i]);
+          if (NULL == element) ERROR;
+          alignment = std::max(alignment, type_alignment(spec_init_sperator_c::get_spec(element->spec_init)));
+        }
+        return alignment;
+      }
+
+      /* FB instances: the largest alignment of their variables */
+      function_block_declaration_c *fb_decl = dynamic_cast<function_block_declaration_c *>(base_type);
+      if (NULL != fb_decl) {
+        search_var_instance_decl_c search_var_instance_decl(fb_decl);
+        search_declared_variables_c search_declared_variables(fb_decl->var_declarations);
+        int alignment = 1;
+        for (size_t i = 0; i < search_declared_variables.variables.size(); i++) {
+          search_declared_variables_c::variable_t &variable = search_declared_variables.variables[i];
+          alignment = std::max(alignment, variable.is_pointer? max_alignment
+                                          : type_alignment(search_var_instance_decl.get_decl(variable.name)));
+        }
+        return alignment;
+      }
+
+      int bits = get_sizeof_datatype_c::getsize(base_type);
+      if (bits > 0)                                      return (bits < 8)? 1 : std::min(bits / 8, max_alignment);
+      /* TIME and dates (struct timespec) */
+      return max_alignment;
+    }
+
+    void print_reordered_fields(symbol_c *scope, symbol_c *var_declarations, symbol_c *body, unsigned int vartypes) {
+      search_var_instance_decl_c search_var_instance_decl(scope);
+      search_referenced_identifiers_c search_referenced_identifiers(body);
+      search_declared_variables_c search_declared_variables(var_declarations);
+      std::vector<field_t> fields;
+      for (size_t i = 0; i < search_declared_variables.variables.size(); i++) {
+        search_declared_variables_c::variable_t &variable = search_declared_variables.variables[i];
+        field_t field = {variable.name, false, max_alignment};
+        if (!variable.is_pointer) {
+          search_var_instance_decl_c::vt_t vartype = search_var_instance_decl.get_vartype(variable.name);
+          token_c *name = dynamic_cast<token_c *>(variable.name);
+          if (NULL == name) ERROR;
+          field.alignment = type_alignment(search_var_instance_decl.get_decl(variable.name));
+          field.cold = ((vartype == search_var_instance_decl_c::private_vt) || (vartype == search_var_instance_decl_c::temp_vt))
+                       && !search_referenced_identifiers.is_referenced(name->value);
+        }
+        fields.push_back(field);
+      }
+      std::stable_sort(fields.begin(), fields.end(), field_order);
+
+      generate_c_vardecl_c vardecl(&s4o_incl, generate_c_vardecl_c::local_vf, vartypes);
+      s4o_incl.print(s4o_incl.indent_spaces + "// Variables used by the POU\n");
+      bool cold = false;
+      for (size_t i = 0; i < fields.size(); i++) {
+        if (fields[i].cold && !cold)
+          s4o_incl.print("\n" + s4o_incl.indent_spaces + "// Variables not used by the POU\n");
+        cold = fields[i].cold;
+        vardecl.print_variable(var_declarations, fields[i].name);
+      }
+    }
+
+    /* With the struct of arrays layout the instance struct of a FB or program holds the
+     * values of its variables only, and their flags are declared apart, in the __flags member.
+     * The variables of nested FB instances have their flags in the nested instance, while
+     * external and located variables keep the flags in their own (pointer) struct.
+     */
+    void print_flags_declaration(symbol_c *symbol, symbol_c *var_declarations, symbol_c *body) {
+      if (!generate_c_options.soa_layout)
+        return;
+      s4o_incl.print(s4o_incl.indent_spaces + "// Flags of the variables\n");
+      s4o_incl.print(s4o_incl.indent_spaces + DECLARE_FLAGS_BEGIN "\n");
+      s4o_incl.indent_right();
+      generate_c_vardecl_c vardecl(&s4o_incl,
+                                   generate_c_vardecl_c::localflags_vf,
+                                   generate_c_vardecl_c::input_vt    |
+                                   generate_c_vardecl_c::output_vt   |
+                                   generate_c_vardecl_c::inoutput_vt |
+                                   generate_c_vardecl_c::en_vt       |
+                                   generate_c_vardecl_c::eno_vt      |
+                                   generate_c_vardecl_c::temp_vt     |
+                                   generate_c_vardecl_c::private_vt);
+      vardecl.print(var_declarations);
+      generate_c_sfcdecl_c sfcdecl(&s4o_incl, symbol);
+      sfcdecl.generate(body, generate_c_sfcdecl_c::sfcflags_sd);
+      s4o_incl.indent_left();
+      s4o_incl.print(s4o_incl.indent_spaces + DECLARE_FLAGS_END "\n");
+    }
+
+    /* The pointers through which a FB reads its inputs passed by reference (see search_inputs_by_ref_c),
+     * each to a value of the type of the input.
+     */
+    void print_input_refs_declaration(function_block_declaration_c *symbol) {
+      if ((NULL == search_inputs_by_ref) || !search_inputs_by_ref->has_inputs_by_ref(((token_c *)symbol->fblock_name)->value))
+        return;
+      generate_c_typedecl_c typedecl(&s4o_incl);
+      s4o_incl.print(s4o_incl.indent_spaces + "// Inputs passed by reference\n");
+      function_param_iterator_c fp_iterator(symbol);
+      identifier_c *param_name;
+      while ((param_name = fp_iterator.next()) != NULL) {
+        if ((fp_iterator.param_direction() == function_param_iterator_c::direction_in) &&
+            is_input_by_ref(symbol->fblock_name, param_name)) {
+          s4o_incl.print(s4o_incl.indent_spaces + DECLARE_INPUT_REF "(");
+          fp_iterator.param_type()->accept(typedecl);
+          s4o_incl.print(",");
+          param_name->accept(typedecl);
+          s4o_incl.print(")\n");
+        }
+      }
+      s4o_incl.print("\n");
+    }
+
+    /* Until the first call, the inputs passed by reference are read from the FB instance itself */
+    void print_input_refs_init(function_block_declaration_c *symbol) {
+      function_param_iterator_c fp_iterator(symbol);
+      identifier_c *param_name;
+      while ((param_name = fp_iterator.next()) != NULL) {
+        if ((fp_iterator.param_direction() == function_param_iterator_c::direction_in) &&
+            is_input_by_ref(symbol->fblock_name, param_name)) {
+          s4o.print(s4o.indent_spaces + RESET_INPUT_REF "(" FB_FUNCTION_PARAM "->,");
+          param_name->accept(*this);
+          s4o.print(");\n");
+        }
+      }
+    }
   
 
 
@@ -1234,10 +1876,13 @@ void *visit(function_declaration_c *symbol) {
   s4o.print(s4o.indent_spaces + "}\n");
 
   /* (C) Function body */
+  print_profile_enter(symbol->derived_function_name);
   generate_c_SFC_IL_ST_c generate_c_code(&s4o, symbol->derived_function_name, symbol);
   symbol->function_body->accept(generate_c_code);
+  print_line_directive_end("POUS.c");
   
   print_end_of_block_label();
+  print_profile_exit();
   
   vardecl = new generate_c_vardecl_c(&s4o,
                 generate_c_vardecl_c::foutputassign_vf,
@@ -1283,34 +1928,50 @@ void *visit(function_block_declaration_c *symbol) {
   s4o_incl.print("\n// Data part\n");
   s4o_incl.print("typedef struct {\n");
   s4o_incl.indent_right();
-  /* (A.2) Public variables: i.e. the function parameters... */
-  s4o_incl.print(s4o_incl.indent_spaces + "// FB Interface - IN, OUT, IN_OUT variables\n");
-  vardecl = new generate_c_vardecl_c(&s4o_incl,
-                                     generate_c_vardecl_c::local_vf,
-                                     generate_c_vardecl_c::input_vt    |
-                                     generate_c_vardecl_c::output_vt   |
-                                     generate_c_vardecl_c::inoutput_vt |
-                                     generate_c_vardecl_c::en_vt       |
-                                     generate_c_vardecl_c::eno_vt);
-  vardecl->print(symbol->var_declarations);
-  delete vardecl;
-  s4o_incl.print("\n");
-  /* (A.3) Private internal variables */
-  s4o_incl.print(s4o_incl.indent_spaces + "// FB private variables - TEMP, private and located variables\n");
-  vardecl = new generate_c_vardecl_c(&s4o_incl,
-                                     generate_c_vardecl_c::local_vf,
-                                     generate_c_vardecl_c::temp_vt    |
-                                     generate_c_vardecl_c::private_vt |
-                                     generate_c_vardecl_c::located_vt |
-                                     generate_c_vardecl_c::external_vt);
-  vardecl->print(symbol->var_declarations);
-  delete vardecl;
+  if (generate_c_options.reorder_fields) {
+    /* (A.2) + (A.3) All the variables, ordered by use and alignment */
+    print_reordered_fields(symbol, symbol->var_declarations, symbol->fblock_body,
+                           generate_c_vardecl_c::input_vt    |
+                           generate_c_vardecl_c::output_vt   |
+                           generate_c_vardecl_c::inoutput_vt |
+                           generate_c_vardecl_c::en_vt       |
+                           generate_c_vardecl_c::eno_vt      |
+                           generate_c_vardecl_c::temp_vt     |
+                           generate_c_vardecl_c::private_vt  |
+                           generate_c_vardecl_c::located_vt  |
+                           generate_c_vardecl_c::external_vt);
+  } else {
+    /* (A.2) Public variables: i.e. the function parameters... */
+    s4o_incl.print(s4o_incl.indent_spaces + "// FB Interface - IN, OUT, IN_OUT variables\n");
+    vardecl = new generate_c_vardecl_c(&s4o_incl,
+                                       generate_c_vardecl_c::local_vf,
+                                       generate_c_vardecl_c::input_vt    |
+                                       generate_c_vardecl_c::output_vt   |
+                                       generate_c_vardecl_c::inoutput_vt |
+                                       generate_c_vardecl_c::en_vt       |
+                                       generate_c_vardecl_c::eno_vt);
+    vardecl->print(symbol->var_declarations);
+    delete vardecl;
+    s4o_incl.print("\n");
+    /* (A.3) Private internal variables */
+    s4o_incl.print(s4o_incl.indent_spaces + "// FB private variables - TEMP, private and located variables\n");
+    vardecl = new generate_c_vardecl_c(&s4o_incl,
+                                       generate_c_vardecl_c::local_vf,
+                                       generate_c_vardecl_c::temp_vt    |
+                                       generate_c_vardecl_c::private_vt |
+                                       generate_c_vardecl_c::located_vt |
+                                       generate_c_vardecl_c::external_vt);
+    vardecl->print(symbol->var_declarations);
+    delete vardecl;
+  }
   
   /* (A.4) Generate private internal variables for SFC */
   sfcdecl = new generate_c_sfcdecl_c(&s4o_incl, symbol);
   sfcdecl->generate(symbol->fblock_body, generate_c_sfcdecl_c::sfcdecl_sd);
   delete sfcdecl;
   s4o_incl.print("\n");
+  print_input_refs_declaration(symbol);
+  print_flags_declaration(symbol, symbol->var_declarations, symbol->fblock_body);
 
   /* (A.5) Function Block data structure type name. */
   s4o_incl.indent_left();
@@ -1338,7 +1999,12 @@ void *visit(function_block_declaration_c *symbol) {
   s4o.print(", BOOL retain) {\n");
   s4o.indent_right();
 
-  /* (B.2) Member initializations... */
+  /* (B.2) Copy the image of an instance already initialised, if available... */
+  bool init_image = use_init_image(symbol);
+  if (init_image)
+    print_init_image_begin(symbol);
+
+  /* (B.3) Member initializations... */
   s4o.print(s4o.indent_spaces);
   vardecl = new generate_c_vardecl_c(&s4o,
                                      generate_c_vardecl_c::constructorinit_vf,
@@ -1356,8 +2022,13 @@ void *visit(function_block_declaration_c *symbol) {
 
   sfcdecl = new generate_c_sfcdecl_c(&s4o, symbol, FB_FUNCTION_PARAM"->");
 
-  /* (B.3) Generate private internal variables for SFC */
+  /* (B.4) Generate private internal variables for SFC */
   sfcdecl->generate(symbol->fblock_body, generate_c_sfcdecl_c::sfcinit_sd);
+  print_input_refs_init(symbol);
+
+  /* (B.5) ...and keep the image of this instance for the next ones. */
+  if (init_image)
+    print_init_image_end(symbol);
 
   s4o.indent_left();
   s4o.print(s4o.indent_spaces + "}\n\n");
@@ -1420,9 +2091,12 @@ void *visit(function_block_declaration_c *symbol) {
   s4o.print("\n");
 
   /* (C.5) Function code */
+  print_profile_enter(symbol->fblock_name);
   generate_c_SFC_IL_ST_c generate_c_code(&s4o, symbol->fblock_name, symbol, FB_FUNCTION_PARAM"->");
   symbol->fblock_body->accept(generate_c_code);
+  print_line_directive_end("POUS.c");
   print_end_of_block_label();
+  print_profile_exit();
   s4o.print(s4o.indent_spaces + "return;\n");
   s4o.indent_left();
   s4o.print(s4o.indent_spaces + "} // ");
@@ -1475,32 +2149,45 @@ void *visit(program_declaration_c *symbol) {
   s4o_incl.print("typedef struct {\n");
   s4o_incl.indent_right();
 
-  /* (A.2) Public variables: i.e. the program parameters... */
-  s4o_incl.print(s4o_incl.indent_spaces + "// PROGRAM Interface - IN, OUT, IN_OUT variables\n");
-  vardecl = new generate_c_vardecl_c(&s4o_incl,
-                                     generate_c_vardecl_c::local_vf,
-                                     generate_c_vardecl_c::input_vt  |
-                                     generate_c_vardecl_c::output_vt |
-                                     generate_c_vardecl_c::inoutput_vt);
-  vardecl->print(symbol->var_declarations);
-  delete vardecl;
-  s4o_incl.print("\n");
-  /* (A.3) Private internal variables */
-  s4o_incl.print(s4o_incl.indent_spaces + "// PROGRAM private variables - TEMP, private and located variables\n");
-  vardecl = new generate_c_vardecl_c(&s4o_incl,
-                generate_c_vardecl_c::local_vf,
-                generate_c_vardecl_c::temp_vt    |
-                generate_c_vardecl_c::private_vt |
-                generate_c_vardecl_c::located_vt |
-                generate_c_vardecl_c::external_vt);
-  vardecl->print(symbol->var_declarations);
-  delete vardecl;
+  if (generate_c_options.reorder_fields) {
+    /* (A.2) + (A.3) All the variables, ordered by use and alignment */
+    print_reordered_fields(symbol, symbol->var_declarations, symbol->function_block_body,
+                           generate_c_vardecl_c::input_vt    |
+                           generate_c_vardecl_c::output_vt   |
+                           generate_c_vardecl_c::inoutput_vt |
+                           generate_c_vardecl_c::temp_vt     |
+                           generate_c_vardecl_c::private_vt  |
+                           generate_c_vardecl_c::located_vt  |
+                           generate_c_vardecl_c::external_vt);
+  } else {
+    /* (A.2) Public variables: i.e. the program parameters... */
+    s4o_incl.print(s4o_incl.indent_spaces + "// PROGRAM Interface - IN, OUT, IN_OUT variables\n");
+    vardecl = new generate_c_vardecl_c(&s4o_incl,
+                                       generate_c_vardecl_c::local_vf,
+                                       generate_c_vardecl_c::input_vt  |
+                                       generate_c_vardecl_c::output_vt |
+                                       generate_c_vardecl_c::inoutput_vt);
+    vardecl->print(symbol->var_declarations);
+    delete vardecl;
+    s4o_incl.print("\n");
+    /* (A.3) Private internal variables */
+    s4o_incl.print(s4o_incl.indent_spaces + "// PROGRAM private variables - TEMP, private and located variables\n");
+    vardecl = new generate_c_vardecl_c(&s4o_incl,
+                  generate_c_vardecl_c::local_vf,
+                  generate_c_vardecl_c::temp_vt    |
+                  generate_c_vardecl_c::private_vt |
+                  generate_c_vardecl_c::located_vt |
+                  generate_c_vardecl_c::external_vt);
+    vardecl->print(symbol->var_declarations);
+    delete vardecl;
+  }
 
   /* (A.4) Generate private internal variables for SFC */
   sfcdecl = new generate_c_sfcdecl_c(&s4o_incl, symbol);
   sfcdecl->generate(symbol->function_block_body, generate_c_sfcdecl_c::sfcdecl_sd);
   delete sfcdecl;
   s4o_incl.print("\n");
+  print_flags_declaration(symbol, symbol->var_declarations, symbol->function_block_body);
   
   /* (A.5) Program data structure type name. */
   s4o_incl.indent_left();
@@ -1582,9 +2269,12 @@ void *visit(program_declaration_c *symbol) {
   s4o.print("\n");
 
   /* (C.5) Function code */
+  print_profile_enter(symbol->program_type_name);
   generate_c_SFC_IL_ST_c generate_c_code(&s4o, symbol->program_type_name, symbol, FB_FUNCTION_PARAM"->");
   symbol->function_block_body->accept(generate_c_code);
+  print_line_directive_end("POUS.c");
   print_end_of_block_label();
+  print_profile_exit();
   s4o.print(s4o.indent_spaces + "return;\n");
   s4o.indent_left();
   s4o.print(s4o.indent_spaces + "} // ");
@@ -1680,9 +2370,17 @@ void *visit(configuration_declaration_c *symbol) {
   s4o.print("/*     FILE GENERATED BY iec2c             */\n");
   s4o.print("/* Editing this file is not recommended... */\n");
   s4o.print("/*******************************************/\n\n");
+  print_layout_definition(s4o);
   s4o.print("#include \"iec_std_lib.h\"\n\n");
   s4o.print("#include \"accessor.h\"\n\n"); 
   s4o.print("#include \"POUS.h\"\n\n");
+  if (generate_c_options.profile)
+    s4o.print("__IEC_PROFILE_DEFINE_BLOCK\n\n");
+  if (generate_c_options.task_stats) {
+    s4o.print("#include \"iec_task_stats.h\"\n\n");
+    s4o.print("static __IEC_task_stats_block_t __IEC_task_stats_block;\n");
+    s4o.print("__IEC_task_stats_block_t *__IEC_task_stats = &__IEC_task_stats_block;\n\n");
+  }
 
   /* (A) configuration declaration... */
   /* (A.1) configuration name in comment */
@@ -1867,7 +2565,8 @@ class generate_c_resources_c: public generate_c_typedecl_c {
     typedef enum {
       declare_dt,
       init_dt,
-      run_dt
+      run_dt,
+      run_end_dt
     } declaretype_t;
 
     declaretype_t wanted_declaretype;
@@ -1988,7 +2687,10 @@ END_RESOURCE
       s4o.print("/*     FILE GENERATED BY iec2c             */\n");
       s4o.print("/* Editing this file is not recommended... */\n");
       s4o.print("/*******************************************/\n\n");
+      print_layout_definition(s4o);
       s4o.print("#include \"iec_std_lib.h\"\n\n");
+      if (generate_c_options.task_stats)
+        s4o.print("#include \"iec_task_stats.h\"\n\n");
       
       /* (A) resource declaration... */
       /* (A.1) resource name in comment */
@@ -2072,6 +2774,10 @@ END_RESOURCE
       s4o.print(FB_RUN_SUFFIX);
       s4o.print("(unsigned long tick) {\n");
       s4o.indent_right();
+      if (generate_c_options.task_stats) {
+        s4o.print(s4o.indent_spaces + "unsigned long long __task_stats_now = __IEC_TASK_STATS_NOW();\n");
+        s4o.print(s4o.indent_spaces + "unsigned long long __task_stats_start;\n");
+      }
       
       wanted_declaretype = run_dt;
       
@@ -2081,6 +2787,12 @@ END_RESOURCE
       /* (C.3) Program run declaration... */
       symbol->program_configuration_list->accept(*this);
       
+      /* (C.4) Task statistics... */
+      if (generate_c_options.task_stats) {
+        wanted_declaretype = run_end_dt;
+        symbol->task_configuration_list->accept(*this);
+      }
+      
       s4o.indent_left();
       s4o.print("}\n\n");
       
@@ -2135,12 +2847,19 @@ END_RESOURCE
           if (symbol->prog_conf_elements != NULL)
             symbol->prog_conf_elements->accept(*this);
           
+          if (generate_c_options.task_stats && (symbol->task_name != NULL))
+            s4o.print(s4o.indent_spaces + "__task_stats_start = __IEC_TASK_STATS_NOW();\n");
           s4o.print(s4o.indent_spaces);
           symbol->program_type_name->accept(*this);
           s4o.print(FB_FUNCTION_SUFFIX);
           s4o.print("(&");
           symbol->program_name->accept(*this);
           s4o.print(");\n");
+          if (generate_c_options.task_stats && (symbol->task_name != NULL)) {
+            s4o.print(s4o.indent_spaces + "__IEC_task_program_done(");
+            symbol->task_name->accept(*this);
+            s4o.print("__stats, __task_stats_start);\n");
+          }
           
           wanted_assigntype = send_at;
           if (symbol->prog_conf_elements != NULL)
@@ -2166,6 +2885,11 @@ END_RESOURCE
           s4o.print(s4o.indent_spaces + "BOOL ");
           current_task_name->accept(*this);
           s4o.print(";\n");
+          if (generate_c_options.task_stats) {
+            s4o.print(s4o.indent_spaces + "static __IEC_task_stats_t *");
+            current_task_name->accept(*this);
+            s4o.print("__stats;\n");
+          }
           symbol->task_initialization->accept(*this);
           break;
         case init_dt:
@@ -2176,6 +2900,20 @@ END_RESOURCE
           break;
         case run_dt:
           symbol->task_initialization->accept(*this);
+          if (generate_c_options.task_stats) {
+            s4o.print(s4o.indent_spaces + "if (");
+            current_task_name->accept(*this);
+            s4o.print(") __IEC_task_release(");
+            current_task_name->accept(*this);
+            s4o.print("__stats, __task_stats_now);\n");
+          }
+          break;
+        case run_end_dt:
+          s4o.print(s4o.indent_spaces + "if (");
+          current_task_name->accept(*this);
+          s4o.print(") __IEC_task_done(");
+          current_task_name->accept(*this);
+          s4o.print("__stats);\n");
           break;
         default:
           break;
@@ -2203,6 +2941,20 @@ END_RESOURCE
             current_task_name->accept(*this);
             s4o.print("_R_TRIG, retain);\n");
           }
+          if (generate_c_options.task_stats) {
+            s4o.print(s4o.indent_spaces);
+            current_task_name->accept(*this);
+            s4o.print("__stats = __IEC_task_stats_register(\"");
+            current_resource_name->accept(*this);
+            s4o.print(".");
+            current_task_name->accept(*this);
+            s4o.print("\", ");
+            if ((symbol->single_data_source == NULL) && (symbol->interval_data_source != NULL))
+              s4o.print_long_long_integer(calculate_time(symbol->interval_data_source));
+            else
+              s4o.print("0");
+            s4o.print(");\n");
+          }
           break;
         case run_dt:
           if (symbol->single_data_source != NULL) {
@@ -2390,7 +3142,74 @@ class generate_c_c: public iterator_visitor_c {
       current_mode = none_gm;
     }
             
-    ~generate_c_c(void) {}
+    ~generate_c_c(void) {
+      if (generate_c_options.line_directives)
+        write_source_map();
+    }
+
+
+    /* With -O line-directives, the #line directives that attribute the C code back
+     * to POUS.c are printed with a dummy line number, as stage4out_c does not count
+     * the lines it prints. Once POUS.c is complete (and closed), set their line
+     * numbers, and write POUS.map, listing the ranges of lines of POUS.c generated
+     * from each line of the IEC 61131-3 source code:
+     *   <first C line> <last C line> <IEC line> <IEC file>
+     * (separated by tabs), for the tools that do not read the debug information.
+     */
+    void write_source_map(void) {
+      std::string filepath = (NULL == current_builddir)? "" : std::string(current_builddir) + "/";
+      std::vector<std::string> lines;
+      std::string line;
+
+      pous_s4o.close();
+      std::ifstream in((filepath + "POUS.c").c_str());
+      while (std::getline(in, line))
+        lines.push_back(line);
+      in.close();
+
+      std::ofstream out((filepath + "POUS.c").c_str());
+      stage4out_c map_s4o(current_builddir, "POUS", "map");
+      map_s4o.print("# c_first\tc_last\tiec_line\tiec_file\n");
+      std::string iec_file;
+      int iec_line = 0, c_first = 0;
+      const std::string directive = "#line ", end = " " LINE_DIRECTIVE_END;
+      for (unsigned int i = 0; i < lines.size(); i++) {
+        int c_line = i + 1;
+        if (lines[i].compare(0, directive.size(), directive) == 0) {
+          /* the previous range ends here */
+          if ((iec_line > 0) && (c_line > c_first)) {
+            map_s4o.print(c_first);  map_s4o.print("\t");
+            map_s4o.print(c_line-1); map_s4o.print("\t");
+            map_s4o.print(iec_line); map_s4o.print("\t");
+            map_s4o.print(iec_file); map_s4o.print("\n");
+          }
+          iec_line = 0;
+          c_first = c_line + 1;
+          if ((lines[i].size() >= end.size()) && (lines[i].compare(lines[i].size() - end.size(), end.size(), end) == 0)) {
+            /* the C code resumes on the next line */
+            std::ostringstream resume;
+            resume << directive << c_line + 1 << " \"POUS.c\"" << end;
+            lines[i] = resume.str();
+          } else {
+            /* #line <IEC line> "<IEC file>", with '\\' and '"' escaped */
+            size_t quote = lines[i].find('"');
+            iec_line = atoi(lines[i].c_str() + directive.size());
+            iec_file.clear();
+            for (size_t c = quote + 1; (quote != std::string::npos) && (c + 1 < lines[i].size()); c++) {
+              if (lines[i][c] == '\\') c++;
+              iec_file += lines[i][c];
+            }
+          }
+        }
+        out << lines[i] << "\n";
+      }
+      if ((iec_line > 0) && ((int)lines.size() >= c_first)) {
+        map_s4o.print(c_first);            map_s4o.print("\t");
+        map_s4o.print((int)lines.size());  map_s4o.print("\t");
+        map_s4o.print(iec_line);           map_s4o.print("\t");
+        map_s4o.print(iec_file);           map_s4o.print("\n");
+      }
+    }
 
 
 
@@ -2416,11 +3235,50 @@ class generate_c_c: public iterator_visitor_c {
     } 
 
 
+    /* Generate the code of a function, function block or program, re-using the
+     * code stored in the build cache (if any) when the POU has not changed.
+     * Note that the cache is bypassed whenever code generation has been disabled
+     * by a pragma, or if the POU itself leaves it disabled, and with -O line-directives
+     * (the hash of a POU ignores its position in the source code, which the
+     * #line directives of its code depend on).
+     */
+    void generate_pou(symbol_c *symbol) {
+      build_cache_c::generated_code_t generated;
+
+      if ((NULL == build_cache) || generate_c_options.line_directives ||
+          !pous_s4o.is_output_enabled() || !pous_incl_s4o.is_output_enabled()) {
+        symbol->accept(generate_c_pous);
+        return;
+      }
+      if (build_cache->get(symbol, generated)) {
+        pous_s4o     .print(generated.code);
+        pous_incl_s4o.print(generated.header);
+        return;
+      }
+      pous_s4o     .start_capture();
+      pous_incl_s4o.start_capture();
+      symbol->accept(generate_c_pous);
+      generated.code   = pous_s4o     .stop_capture();
+      generated.header = pous_incl_s4o.stop_capture();
+      if (pous_s4o.is_output_enabled() && pous_incl_s4o.is_output_enabled())
+        build_cache->put(symbol, generated);
+    }
+
+
 /***************************/
 /* B 0 - Programming Model */
 /***************************/
     void *visit(library_c *symbol) {
+      if (generate_c_options.inputs_by_ref && (NULL == build_cache))
+        search_inputs_by_ref = new search_inputs_by_ref_c(symbol);
+
       pous_incl_s4o.print("#ifndef __POUS_H\n#define __POUS_H\n\n#include \"accessor.h\"\n\n");
+      if (generate_c_options.profile)
+        pous_incl_s4o.print("#include \"iec_profile.h\"\n\n");
+      if (generate_c_options.soa_layout)
+        pous_incl_s4o.print("#ifndef __IEC_SOA_LAYOUT\n"
+                            "#error \"POUS.h was generated for the struct of arrays layout: define __IEC_SOA_LAYOUT before including iec_std_lib.h\"\n"
+                            "#endif\n\n");
 
       current_mode = datatypes_gm;
       for(int i = 0; i < symbol->n; i++) {
@@ -2434,15 +3292,29 @@ class generate_c_c: public iterator_visitor_c {
 
       pous_incl_s4o.print("#endif //__POUS_H\n");
       
-      generate_var_list_c generate_var_list(&variables_s4o, symbol);
+      stage4out_c *registry_s4o = NULL;
+      if (generate_c_options.debug_registry)
+        registry_s4o = new stage4out_c(current_builddir, "VARIABLES", "c");
+      generate_var_list_c generate_var_list(&variables_s4o, symbol, registry_s4o);
       generate_var_list.generate_programs(symbol);
       generate_var_list.generate_variables(symbol);
       variables_s4o.print("\n// Ticktime\n");
       variables_s4o.print_long_long_integer(common_ticktime, false);
       variables_s4o.print("\n");
+      generate_var_list.generate_layout();
+      delete registry_s4o;
 
       generate_location_list_c generate_location_list(&located_variables_s4o);
       symbol->accept(generate_location_list);
+
+      if (generate_c_options.process_image) {
+        stage4out_c process_image_s4o(current_builddir, "PROCESS_IMAGE", "c");
+        generate_process_image_c generate_process_image(&process_image_s4o);
+        generate_process_image.generate(symbol);
+      }
+
+      delete search_inputs_by_ref;
+      search_inputs_by_ref = NULL;
       return NULL;
     }
 
@@ -2484,7 +3356,7 @@ class generate_c_c: public iterator_visitor_c {
           symbol->var_declarations_list->accept(generate_c_datatypes);
           break;
         case pous_gm:
-          symbol->accept(generate_c_pous);
+          generate_pou(symbol);
           break;
         default:
           break;
@@ -2501,7 +3373,7 @@ class generate_c_c: public iterator_visitor_c {
             symbol->var_declarations->accept(generate_c_datatypes);
             break;
           case pous_gm:
-            symbol->accept(generate_c_pous);
+            generate_pou(symbol);
             break;
           default:
             break;
@@ -2518,7 +3390,7 @@ class generate_c_c: public iterator_visitor_c {
             symbol->var_declarations->accept(generate_c_datatypes);
             break;
           case pous_gm:
-            symbol->accept(generate_c_pous);
+            generate_pou(symbol);
             break;
           default:
             break;
@@ -2636,3 +3508,64 @@ visitor_c *new_code_generator(stage4out_c *s4o, const char *builddir)  {return n
 void delete_code_generator(visitor_c *code_generator) {delete code_generator;}
 
 
+
+static struct {
+    const char *name;
+    bool       *flag;
+    bool        value;
+    const char *help;
+} generate_c_option_list[] = {
+    {   "const-fold", &generate_c_options.fold_constants, true,  "print the value of constant expressions as a literal (default)"},
+    {"no-const-fold", &generate_c_options.fold_constants, false, "print constant expressions as they appear in the source code"},
+    {   "init-image",    &generate_c_options.init_image,     true,  "initialise FB instances from the image of an instance already initialised (default)"},
+    {"no-init-image",    &generate_c_options.init_image,     false, "initialise every member of every FB instance"},
+    {   "soa-layout",    &generate_c_options.soa_layout,     true,  "keep the flags of the variables of FB and program instances apart from their values"},
+    {"no-soa-layout",    &generate_c_options.soa_layout,     false, "keep the flags of each variable next to its value (default)"},
+    {   "reorder-fields", &generate_c_options.reorder_fields, true,  "declare the variables of FB and program instances by use and alignment"},
+    {"no-reorder-fields", &generate_c_options.reorder_fields, false, "declare the variables of FB and program instances in source code order (default)"},
+    {   "inputs-by-ref", &generate_c_options.inputs_by_ref, true,  "do not copy the STRING, array and structure inputs a FB only reads (not with -C; the debugger then shows stale values for these inputs)"},
+    {"no-inputs-by-ref", &generate_c_options.inputs_by_ref, false, "copy every input into the FB instance on each call (default)"},
+    {   "fast-std-calls", &generate_c_options.fast_std_calls, true,  "call the EN/ENO-free variants of ADD, MUL, MAX, GT, ... when EN and ENO are not used (default)"},
+    {"no-fast-std-calls", &generate_c_options.fast_std_calls, false, "always call the extensible standard functions with EN and ENO"},
+    {   "typed-expt",    &generate_c_options.typed_expt,     true,  "compute ** in the data type of the result, by multiplication for integer exponents (default)"},
+    {"no-typed-expt",    &generate_c_options.typed_expt,     false, "compute ** with pow(), in LREAL"},
+    {   "debug-registry", &generate_c_options.debug_registry, true,  "also generate VARIABLES.c, the addresses of the variables of VARIABLES.csv and of their elements"},
+    {"no-debug-registry", &generate_c_options.debug_registry, false, "do not generate VARIABLES.c (default)"},
+    {   "process-image", &generate_c_options.process_image, true,  "also generate PROCESS_IMAGE.c, defining the located variables in contiguous %I, %Q and %M images"},
+    {"no-process-image", &generate_c_options.process_image, false, "leave the located variables to be defined by the runtime (default)"},
+    {   "task-stats",    &generate_c_options.task_stats,     true,  "keep the execution time, jitter and overrun statistics of each task"},
+    {"no-task-stats",    &generate_c_options.task_stats,     false, "do not time the tasks (default)"},
+    {   "profile",       &generate_c_options.profile,        true,  "count the calls to each POU and the time spent in it, when compiled with __IEC_PROFILE defined"},
+    {"no-profile",       &generate_c_options.profile,        false, "do not profile the POUs (default)"},
+    {   "line-directives", &generate_c_options.line_directives, true,  "emit #line directives in POUS.c for debuggers and profilers, and write the source map POUS.map"},
+    {"no-line-directives", &generate_c_options.line_directives, false, "do not emit #line directives (default)"},
+    {NULL, NULL, false, NULL}
+};
+
+
+int stage4_parse_options(char *options) {
+  char *option = options;
+  while ((NULL != option) && ('\0' != *option)) {
+    char *next = strchr(option, ',');
+    if (NULL != next) *(next++) = '\0';
+    int i;
+    for (i = 0; NULL != generate_c_option_list[i].name; i++)
+      if (strcmp(option, generate_c_option_list[i].name) == 0) break;
+    if (NULL == generate_c_option_list[i].name) {
+      fprintf(stderr, "Unrecognized option for the C code generator: '%s'\n", option);
+      return -1;
+    }
+    *(generate_c_option_list[i].flag) = generate_c_option_list[i].value;
+    option = next;
+  }
+  return 0;
+}
+
+
+void stage4_print_options(void) {
+  printf("      options available for the C code generator:\n");
+  for (int i = 0; NULL != generate_c_option_list[i].name; i++)
+    printf("       %-16s: %s\n", generate_c_option_list[i].name, generate_c_option_list[i].help);
+}
+
+
@@ -61,6 +61,103 @@ typedef struct
   param_list.clear();
 
 
+/* Determine whether the const_value (determined by constant_folding_c in stage 3) of an expression may be
+ * printed out as a literal, instead of the expression itself.
+ * 
+ * constant_folding_c does its calculations using 64 bit values (int64, uint64, real64), while the C code
+ * will do the same calculations using the data types of each operand (which may overflow and wrap around).
+ * We must therefore only consider the const_value when it fits inside the expression's data type, and the same
+ * holds for all of its sub-expressions. Note that REAL values are never used, since any sub-expression
+ * would be calculated in C using 32 bit floats, and would therefore produce a (slightly) different result.
+ */
+class check_const_value_c: public iterator_visitor_c {
+  private:
+    bool is_ok;
+    static check_const_value_c *singleton_;
+
+  public:
+    static bool is_printable(symbol_c *expression) {
+      if (NULL == expression) return false;
+      if (NULL == singleton_) singleton_ = new check_const_value_c();
+      singleton_->is_ok = true;
+      expression->accept(*singleton_);
+      return singleton_->is_ok;
+    }
+
+    /* Does the const_value of this symbol fit inside its own data type? */
+    static bool fits_datatype(symbol_c *symbol) {
+      if (NULL == symbol->datatype) return false;
+      if (search_base_type_c::type_is_subrange  (symbol->datatype)) return false;
+      if (search_base_type_c::type_is_enumerated(symbol->datatype)) return false;
+      symbol_c *basetype = search_base_type_c::get_basetype_decl(symbol->datatype);
+      if (NULL == basetype) return false;
+
+      if (get_datatype_info_c::is_BOOL_compatible(basetype))
+        return VALID_CVALUE(bool, symbol);
+      if (get_datatype_info_c::is_ANY_signed_INT_compatible(basetype)) {
+        int bits = get_sizeof_datatype_c::getsize(basetype);
+        if (!VALID_CVALUE(int64, symbol) || (bits <= 0) || (bits > 64)) return false;
+        int64_t value = GET_CVALUE(int64, symbol);
+        if (bits == 64) return (value != INT64_MIN);  /* INT64_MIN can not be written as a C literal */
+        return (value >= -((int64_t)1 << (bits-1))) && (value <= ((int64_t)1 << (bits-1)) - 1);
+      }
+      if (get_datatype_info_c::is_ANY_unsigned_INT_compatible(basetype) || get_datatype_info_c::is_ANY_nBIT_compatible(basetype)) {
+        int bits = get_sizeof_datatype_c::getsize(basetype);
+        if (!VALID_CVALUE(uint64, symbol) || (bits <= 0) || (bits > 64)) return false;
+        uint64_t value = GET_CVALUE(uint64, symbol);
+        if (value > (uint64_t)INT64_MAX) return false;  /* would need an unsigned suffix in C */
+        return (bits == 64) || (value <= ((uint64_t)1 << bits) - 1);
+      }
+      if (get_datatype_info_c::is_ANY_REAL_compatible(basetype) && (get_sizeof_datatype_c::getsize(basetype) == 64)) {
+        if (!VALID_CVALUE(real64, symbol)) return false;
+        real64_t value = GET_CVALUE(real64, symbol);
+        return (value == value) && (value - value == 0);  /* not NaN, and not infinite */
+      }
+      return false;  /* REAL, TIME, DATE, STRING, ... */
+    }
+
+  private:
+    void *check(symbol_c *symbol) {if (!fits_datatype(symbol)) is_ok = false; return NULL;}
+
+    /* literals: the data type checking in stage 3 already guarantees they fit in their data type */
+    void *visit(real_c               *symbol) {return NULL;}
+    void *visit(integer_c            *symbol) {return NULL;}
+    void *visit(binary_integer_c     *symbol) {return NULL;}
+    void *visit(octal_integer_c      *symbol) {return NULL;}
+    void *visit(hex_integer_c        *symbol) {return NULL;}
+    void *visit(neg_real_c           *symbol) {return NULL;}
+    void *visit(neg_integer_c        *symbol) {return NULL;}
+    void *visit(integer_literal_c    *symbol) {return NULL;}
+    void *visit(real_literal_c       *symbol) {return NULL;}
+    void *visit(bit_string_literal_c *symbol) {return NULL;}
+    void *visit(boolean_literal_c    *symbol) {return NULL;}
+
+    void *visit(symbolic_variable_c  *symbol) {return check(symbol);}
+    void *visit(    or_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   xor_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   and_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   equ_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(notequ_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(    lt_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(    gt_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(    le_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(    ge_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   add_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   sub_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   mul_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   div_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   mod_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit( power_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   neg_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    void *visit(   not_expression_c  *symbol) {check(symbol); return iterator_visitor_c::visit(symbol);}
+    /* anything else (e.g. function invocations) is never printed as a literal */
+    void *visit(function_invocation_c *symbol) {is_ok = false; return NULL;}
+};
+
+check_const_value_c *check_const_value_c::singleton_ = NULL;
+
+
+
 class generate_c_base_c: public iterator_visitor_c {
 
   protected:
@@ -94,6 +191,34 @@ class generate_c_base_c: public iterator_visitor_c {
       return s4o.printupper((token->value)+offset);
     }
 
+    /* With -O line-directives, attribute the C code that follows (up to the next #line)
+     * to the line of the IEC 61131-3 source code where the symbol starts.
+     * Must be called at the start of a line of C code.
+     */
+    void print_line_directive(symbol_c *symbol) {
+      if (!generate_c_options.line_directives)                   return;
+      if ((NULL == symbol->first_file) || (symbol->first_line <= 0)) return;
+      s4o.print("#line ");
+      s4o.print(symbol->first_line);
+      s4o.print(" \"");
+      for (const char *c = symbol->first_file; *c != '\0'; c++) {
+        if ((*c == '\\') || (*c == '"'))
+          s4o.print("\\");
+        s4o.print(std::string(1, *c));
+      }
+      s4o.print("\"\n");
+    }
+
+    /* ... and attribute the C code that follows back to the generated file
+     * (the line number is set by generate_c_c::write_source_map()).
+     */
+    void print_line_directive_end(const char *c_file) {
+      if (!generate_c_options.line_directives) return;
+      s4o.print("#line 1 \"");
+      s4o.print(c_file);
+      s4o.print("\" " LINE_DIRECTIVE_END "\n");
+    }
+
     void *print_literal(symbol_c *type, symbol_c *value) {
       s4o.print("__");
       type->accept(*this);
@@ -103,6 +228,34 @@ class generate_c_base_c: public iterator_visitor_c {
       return NULL;
     }
 
+    /* Print the const_value of an expression (determined in stage 3 by constant_folding_c) as a literal
+     * of the expression's data type, if possible (see check_const_value_c). 
+     * Returns false if nothing was printed, in which case the caller must print out the expression itself.
+     */
+    bool print_const_value(symbol_c *symbol) {
+      if (!generate_c_options.fold_constants)                return false;
+      if (!check_const_value_c::is_printable(symbol))      return false;
+      symbol_c *basetype = search_base_type_c::get_basetype_decl(symbol->datatype);
+
+      s4o.print("__");
+      basetype->accept(*this);
+      s4o.print("_LITERAL(");
+      if      (get_datatype_info_c::is_BOOL_compatible(basetype))
+        s4o.print(GET_CVALUE(bool, symbol)? "TRUE" : "FALSE");
+      else if (get_datatype_info_c::is_ANY_signed_INT_compatible(basetype))
+        s4o.print((long long int)GET_CVALUE(int64, symbol));
+      else if (get_datatype_info_c::is_ANY_REAL_compatible(basetype)) {
+        char str[64];
+        snprintf(str, sizeof(str), "%.17g", (double)GET_CVALUE(real64, symbol));
+        s4o.print(str);
+        if (strpbrk(str, ".e") == NULL) s4o.print(".0");  /* make sure C handles it as a floating point literal */
+      }
+      else
+        s4o.print((unsigned long long int)GET_CVALUE(uint64, symbol));
+      s4o.print(")");
+      return true;
+    }
+
     void *print_striped_token(token_c *token, int offset = 0) {
       std::string str = "";
       bool leading_zero = true;
@@ -215,7 +368,10 @@ class generate_c_base_c: public iterator_visitor_c {
           symbol_c *r_exp) {
       s4o.print(function);
       compare_type->accept(*this);
-      s4o.print("(__BOOL_LITERAL(TRUE), NULL, 2, ");
+      if (generate_c_options.fast_std_calls)
+        s4o.print(FAST_FUNCTION_SUFFIX "(");
+      else
+        s4o.print("(__BOOL_LITERAL(TRUE), NULL, 2, ");
       l_exp->accept(*this);
       s4o.print(", ");
       r_exp->accept(*this);
@@ -223,6 +379,96 @@ class generate_c_base_c: public iterator_visitor_c {
       return NULL;
     }
 
+    /* Calls to the extensible standard functions that use neither EN nor ENO are printed as
+     * calls to their EN/ENO-free variants with 2 inputs (see the note on the fast variants
+     * in lib/iec_std_lib.h), which, unlike the va_list based functions, the C compiler inlines.
+     *   ADD(a, b, c)  ->  ADD__INT__INT_fast__(ADD__INT__INT_fast__((INT)a, (INT)b), (INT)c)
+     * The comparisons of more than 2 inputs check each input against the following one,
+     * so only their calls with 2 inputs are handled.
+     *
+     * param_list is the list of parameters built for the call, en_is_passed tells whether
+     * the call passes a value to EN.
+     */
+    bool is_fast_function_call(symbol_c *function_name, bool en_is_passed, std::list<FUNCTION_PARAM*> &param_list) {
+      static const char *nested_functions[]  = {"ADD", "MUL", "AND", "OR", "XOR", "MAX", "MIN", NULL};
+      static const char *compare_functions[] = {"GT", "GE", "EQ", "LE", "LT", NULL};
+
+      if (!generate_c_options.fast_std_calls || en_is_passed) return false;
+      token_c *name = dynamic_cast<token_c *>(function_name);
+      if (NULL == name) return false;
+
+      bool is_extensible = false;
+      int inputs = 0;
+      std::list<FUNCTION_PARAM*>::iterator pt;
+      PARAM_LIST_ITERATOR() {
+        token_c *param_name = dynamic_cast<token_c *>(PARAM_NAME);
+        if (NULL == param_name) return false;
+        if (PARAM_DIRECTION != function_param_iterator_c::direction_in) {
+          if (NULL != PARAM_VALUE) return false;  /* ENO, or some other output, is used */
+        } else if (strcmp(param_name->value, "") == 0)
+          is_extensible = true;  /* the dummy parameter with the number of extensible inputs */
+        else if (strcasecmp(param_name->value, "EN") != 0)
+          inputs++;
+      }
+      if (!is_extensible) return false;
+
+      /* the explicitly typed functions (ADD_INT, MAX_STRING, ...) are also extensible */
+      for (int i = 0; NULL != nested_functions[i]; i++) {
+        size_t len = strlen(nested_functions[i]);
+        if ((strncasecmp(name->value, nested_functions[i], len) == 0) && ((name->value[len] == '\0') || (name->value[len] == '_')))
+          return (inputs >= 2);
+      }
+      for (int i = 0; NULL != compare_functions[i]; i++) {
+        size_t len = strlen(compare_functions[i]);
+        if ((strncasecmp(name->value, compare_functions[i], len) == 0) && ((name->value[len] == '\0') || (name->value[len] == '_')))
+          return (inputs == 2);
+      }
+      return false;
+    }
+
+    /* Print the (nested) calls to the EN/ENO-free variant of an extensible standard function,
+     * for a call accepted by is_fast_function_call().
+     * function_name is the name of the C function that would otherwise be called.
+     */
+    void *print_fast_function_call(std::string function_name, std::list<FUNCTION_PARAM*> &param_list) {
+      std::vector<FUNCTION_PARAM*> inputs;
+      std::list<FUNCTION_PARAM*>::iterator pt;
+      PARAM_LIST_ITERATOR() {
+        token_c *param_name = dynamic_cast<token_c *>(PARAM_NAME);
+        if (NULL == param_name) ERROR;
+        if ((PARAM_DIRECTION == function_param_iterator_c::direction_in) &&
+            (strcmp(param_name->value, "") != 0) && (strcasecmp(param_name->value, "EN") != 0))
+          inputs.push_back(*pt);
+      }
+      if (inputs.size() < 2) ERROR;
+
+      for (size_t i = 1; i < inputs.size(); i++)
+        s4o.print(function_name + FAST_FUNCTION_SUFFIX "(");
+      for (size_t i = 0; i < inputs.size(); i++) {
+        symbol_c *param_type  = inputs[i]->param_type;
+        symbol_c *param_value = inputs[i]->param_value;
+        if (param_value == NULL) {
+          /* If not, get the default value of this variable's type */
+          param_value = type_initial_value_c::get(param_type);
+        }
+        if (param_value == NULL) ERROR;
+        if (i > 0)
+          s4o.print(", ");
+        s4o.print("(");
+        if      (get_datatype_info_c::is_ANY_INT_literal(param_type))
+          get_datatype_info_c::lint_type_name.accept(*this);
+        else if (get_datatype_info_c::is_ANY_REAL_literal(param_type))
+          get_datatype_info_c::lreal_type_name.accept(*this);
+        else
+          param_type->accept(*this);
+        s4o.print(")");
+        print_check_function(param_type, param_value);
+        if (i > 0)
+          s4o.print(")");
+      }
+      return NULL;
+    }
+
     void *print_check_function(symbol_c *type,
           symbol_c *value,
           symbol_c *fb_name = NULL,
@@ -335,8 +335,12 @@ class generate_c_il_c: public generate_c_typedecl_c, il_default_variable_visitor
        *         3rd parameter: number of operands we will be passing (required because we are calling an extensible standard function!)
        *         4th parameter: the left  hand side of the comparison expression (in out case, the IL implicit variable)
        *         4th parameter: the right hand side of the comparison expression (in out case, current operand)
+       *       or its EN/ENO-free variant with 2 operands (see the note on the fast variants in lib/iec_std_lib.h).
        */
-      s4o.print("(__BOOL_LITERAL(TRUE), NULL, 2, ");
+      if (generate_c_options.fast_std_calls)
+        s4o.print(FAST_FUNCTION_SUFFIX "(");
+      else
+        s4o.print("(__BOOL_LITERAL(TRUE), NULL, 2, ");
       this->implicit_variable_current.accept(*this);
       s4o.print(", ");
       operand->accept(*this);
@@ -365,8 +369,12 @@ class generate_c_il_c: public generate_c_typedecl_c, il_default_variable_visitor
 
     void *print_getter(symbol_c *symbol) {
       unsigned int vartype = search_var_instance_decl->get_vartype(symbol);
+      bool input_by_ref = (vartype == search_var_instance_decl_c::input_vt) &&
+                          is_input_by_ref(fbname, get_var_name_c::get_name(symbol));
       if (wanted_variablegeneration == fparam_output_vg) {
-        if (vartype == search_var_instance_decl_c::external_vt) {
+        if (input_by_ref)
+          s4o.print(GET_INPUT_REF_BY_REF);
+        else if (vartype == search_var_instance_decl_c::external_vt) {
           if (search_var_instance_decl->type_is_fb(symbol))
             s4o.print(GET_EXTERNAL_FB_BY_REF);
           else
@@ -378,7 +386,9 @@ class generate_c_il_c: public generate_c_typedecl_c, il_default_variable_visitor
           s4o.print(GET_VAR_BY_REF);
       }
       else {
-        if (vartype == search_var_instance_decl_c::external_vt) {
+        if (input_by_ref)
+          s4o.print(GET_INPUT_REF);
+        else if (vartype == search_var_instance_decl_c::external_vt) {
           if (search_var_instance_decl->type_is_fb(symbol))
             s4o.print(GET_EXTERNAL_FB);
           else
@@ -513,6 +523,10 @@ void *visit(symbolic_variable_c *symbol) {
       break;
     case complextype_suffix_vg:
       break;
+    case expression_vg:
+      if (print_const_value(symbol))
+        break;
+      /* fall through */
     default:
       if (this->is_variable_prefix_null()) {
         vartype = search_var_instance_decl->get_vartype(symbol);
@@ -707,7 +721,16 @@ void *visit(instruction_list_c *symbol) {
   this->implicit_variable_result_back.accept(*this);
   s4o.print(".INTvar = 0;\n\n");
   */
-  print_list(symbol, s4o.indent_spaces, ";\n" + s4o.indent_spaces, ";\n");
+  if (!generate_c_options.line_directives) {
+    print_list(symbol, s4o.indent_spaces, ";\n" + s4o.indent_spaces, ";\n");
+    return NULL;
+  }
+  for(int i = 0; i < symbol->n; i++) {
+    print_line_directive(symbol->elements[i]);
+    s4o.print(s4o.indent_spaces);
+    symbol->elements[i]->accept(*this);
+    s4o.print(";\n");
+  }
   return NULL;
 }
 
@@ -878,6 +901,15 @@ void *visit(il_function_call_c *symbol) {
 
   this->implicit_variable_result.accept(*this);
   s4o.print(" = ");
+
+  /* Calls to extensible standard functions without EN and ENO call their EN/ENO-free variants.
+   * (EN and ENO can not be passed in a non formal function call)
+   */
+  if ((function_type_prefix == NULL) && (function_type_suffix == NULL) && is_fast_function_call(function_name, false, param_list)) {
+    print_fast_function_call(get_called_function_name(function_name, f_decl, fdecl_mutiplicity), param_list);
+    CLEAR_PARAM_LIST()
+    return NULL;
+  }
     
   if (function_type_prefix != NULL) {
     s4o.print("(");
@@ -1280,6 +1312,14 @@ void *visit(il_formal_funct_call_c *symbol) {
 
   this->implicit_variable_result.accept(*this);
   s4o.print(" = ");
+
+  /* Calls to extensible standard functions without EN and ENO call their EN/ENO-free variants */
+  if ((function_type_prefix == NULL) && (function_type_suffix == NULL) &&
+      is_fast_function_call(function_name, NULL != function_call_param_iterator_c(symbol).search_f("EN"), param_list)) {
+    print_fast_function_call(get_called_function_name(function_name, f_decl, fdecl_mutiplicity), param_list);
+    CLEAR_PARAM_LIST()
+    return NULL;
+  }
   
   if (function_type_prefix != NULL) {
     s4o.print("(");
@@ -242,7 +242,10 @@ class generate_c_inlinefcall_c: public generate_c_typedecl_c {
 
     void *print_getter(symbol_c *symbol) {
       unsigned int vartype = search_var_instance_decl->get_vartype(symbol);
-      if (vartype == search_var_instance_decl_c::external_vt) {
+      if ((vartype == search_var_instance_decl_c::input_vt) &&
+          is_input_by_ref(fbname, get_var_name_c::get_name(symbol)))
+        s4o.print(GET_INPUT_REF);
+      else if (vartype == search_var_instance_decl_c::external_vt) {
         if (search_var_instance_decl->type_is_fb(symbol))
           s4o.print(GET_EXTERNAL_FB);
         else
@@ -157,6 +157,7 @@ class generate_c_sfc_elements_c: public generate_c_base_c {
       switch (wanted_sfcgeneration) {
         case actionassociation_sg:
           if (((list_c*)symbol->action_association_list)->n > 0) {
+            print_line_directive(symbol);
             s4o.print(s4o.indent_spaces + "// ");
             symbol->step_name->accept(*this);
             s4o.print(" action associations\n");
@@ -197,6 +198,7 @@ class generate_c_sfc_elements_c: public generate_c_base_c {
       switch (wanted_sfcgeneration) {
         case actionassociation_sg:
           if (((list_c*)symbol->action_association_list)->n > 0) {
+            print_line_directive(symbol);
             s4o.print(s4o.indent_spaces + "// ");
             symbol->step_name->accept(*this);
             s4o.print(" action associations\n");
@@ -258,6 +260,7 @@ class generate_c_sfc_elements_c: public generate_c_base_c {
           }
           break;
         case transitiontest_sg:
+          print_line_directive(symbol);
           s4o.print(s4o.indent_spaces + "if (");
           symbol->from_steps->accept(*this);
           s4o.print(") {\n");
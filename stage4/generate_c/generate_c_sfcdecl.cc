@@ -38,6 +38,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
       typedef enum {
         sfcdecl_sd,
         sfcinit_sd,
+        sfcflags_sd,
         stepcount_sd,
         stepdef_sd,
         stepundef_sd,
@@ -113,6 +114,19 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
           /* last_ticktime declaration */
           s4o.print(s4o.indent_spaces + "TIME __lasttick_time;\n");
           break;
+        case sfcflags_sd:
+          for(int i = 0; i < symbol->n; i++)
+            symbol->elements[i]->accept(*this);
+
+          /* flags of the steps, actions and transitions tables (struct of arrays layout) */
+          s4o.print(s4o.indent_spaces + DECLARE_SFC_FLAGS "(");
+          s4o.print(step_number);
+          s4o.print(", ");
+          s4o.print(action_number);
+          s4o.print(", ");
+          s4o.print(transition_number);
+          s4o.print(")\n");
+          break;
         case sfcinit_sd:
           s4o.print(s4o.indent_spaces);
           s4o.print("UINT i;\n");
@@ -130,7 +144,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
           wanted_sfcdeclaration = sfcinit_sd;
           
           /* steps table initialisation */
-          s4o.print(s4o.indent_spaces + "static const STEP temp_step = {{0, 0}, 0, {0, 0}};\n");
+          s4o.print(s4o.indent_spaces + "static const STEP temp_step = {{0}, 0, {0, 0}};\n");
           s4o.print(s4o.indent_spaces + "for(i = 0; i < ");
           print_variable_prefix();
           s4o.print("__nb_steps; i++) {\n");
@@ -156,7 +170,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
           wanted_sfcdeclaration = sfcinit_sd;
           
           /* actions table initialisation */
-          s4o.print(s4o.indent_spaces + "static const ACTION temp_action = {0, {0, 0}, 0, 0, {0, 0}, {0, 0}};\n");
+          s4o.print(s4o.indent_spaces + "static const ACTION temp_action = {0, {0}, 0, 0, {0, 0}, {0, 0}};\n");
           s4o.print(s4o.indent_spaces + "for(i = 0; i < ");
           print_variable_prefix();
           s4o.print("__nb_actions; i++) {\n");
@@ -241,6 +255,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
           symbol->action_association_list->accept(*this);
           break;
         case sfcdecl_sd:
+        case sfcflags_sd:
           symbol->action_association_list->accept(*this);
         case stepcount_sd:
           step_number++;
@@ -282,6 +297,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
           symbol->action_association_list->accept(*this);
           break;
         case sfcdecl_sd:
+        case sfcflags_sd:
           symbol->action_association_list->accept(*this);
         case stepcount_sd:
         case sfcinit_sd:
@@ -330,6 +346,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
     void *visit(transition_c *symbol) {
       switch (wanted_sfcdeclaration) {
         case sfcdecl_sd:
+        case sfcflags_sd:
         case transitioncount_sd:
           transition_number++;
           break;
@@ -358,6 +375,7 @@ class generate_c_sfcdecl_c: protected generate_c_typedecl_c {
           break;
         case actioncount_sd:
         case sfcdecl_sd:
+        case sfcflags_sd:
           action_number++;
           break;
         default:
@@ -129,8 +129,12 @@ class generate_c_st_c: public generate_c_typedecl_c {
 
 void *print_getter(symbol_c *symbol) {
   unsigned int vartype = search_var_instance_decl->get_vartype(symbol);
+  bool input_by_ref = (vartype == search_var_instance_decl_c::input_vt) &&
+                      is_input_by_ref(fbname, get_var_name_c::get_name(symbol));
   if (wanted_variablegeneration == fparam_output_vg) {
-    if (vartype == search_var_instance_decl_c::external_vt) {
+    if (input_by_ref)
+      s4o.print(GET_INPUT_REF_BY_REF);
+    else if (vartype == search_var_instance_decl_c::external_vt) {
       if (search_var_instance_decl->type_is_fb(symbol))
         s4o.print(GET_EXTERNAL_FB_BY_REF);
       else
@@ -142,7 +146,9 @@ void *print_getter(symbol_c *symbol) {
       s4o.print(GET_VAR_BY_REF);
   }
   else {
-    if (vartype == search_var_instance_decl_c::external_vt) {
+    if (input_by_ref)
+      s4o.print(GET_INPUT_REF);
+    else if (vartype == search_var_instance_decl_c::external_vt) {
       if (search_var_instance_decl->type_is_fb(symbol))
         s4o.print(GET_EXTERNAL_FB);
       else
@@ -221,6 +227,42 @@ void *print_setter(symbol_c* symbol,
   return NULL;
 }
 
+/* Pass a value to an input of a FB passed by reference (see search_inputs_by_ref_c):
+ * bind the input to the variable passed to it, or, when an expression is passed
+ * (or a variable that may not outlive the call, or of another type), copy the value
+ * into the FB instance and bind the input to that copy.
+ */
+void *print_input_ref(symbol_c *fb_name, symbol_c *param_name, symbol_c *param_type, symbol_c *param_value) {
+  unsigned int vartype = search_var_instance_decl->get_vartype(param_value);
+  bool bind = (param_value->kind == kind_symbolic_variable_c) &&
+              !this->is_variable_prefix_null() &&
+              ((vartype & (search_var_instance_decl_c::input_vt  |
+                           search_var_instance_decl_c::output_vt |
+                           search_var_instance_decl_c::private_vt|
+                           search_var_instance_decl_c::temp_vt)) != 0) &&
+              get_datatype_info_c::is_type_equal(search_base_type_c::get_basetype_decl(param_value->datatype),
+                                                 search_base_type_c::get_basetype_decl(param_type));
+
+  if (!bind) {
+    print_setter(param_name, param_type, param_value, fb_name);
+    s4o.print(";\n" + s4o.indent_spaces);
+  }
+  s4o.print(bind? SET_INPUT_REF : RESET_INPUT_REF);
+  s4o.print("(");
+  print_variable_prefix();
+  fb_name->accept(*this);
+  s4o.print(".,");
+  param_name->accept(*this);
+  if (bind) {
+    s4o.print(",");
+    wanted_variablegeneration = fparam_output_vg;
+    param_value->accept(*this);
+    wanted_variablegeneration = expression_vg;
+  }
+  s4o.print(")");
+  return NULL;
+}
+
 /********************************/
 /* B 1.3.3 - Derived data types */
 /********************************/
@@ -269,6 +311,10 @@ void *visit(symbolic_variable_c *symbol) {
       break;
     case complextype_suffix_vg:
       break;
+    case expression_vg:
+      if (print_const_value(symbol))
+        break;
+      /* fall through */
     default:
       if (this->is_variable_prefix_null()) {
         if (wanted_variablegeneration == fparam_output_vg) {
@@ -451,6 +497,7 @@ void *visit(array_initial_elements_list_c *symbol) {
 /* B 3.1 - Expressions */
 /***********************/
 void *visit(or_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype))
     return print_binary_expression(symbol->l_exp, symbol->r_exp, " || ");
   if (get_datatype_info_c::is_ANY_nBIT_compatible(symbol->datatype))
@@ -460,6 +507,7 @@ void *visit(or_expression_c *symbol) {
 }
 
 void *visit(xor_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype)) {
     s4o.print("(");
     symbol->l_exp->accept(*this);
@@ -479,6 +527,7 @@ void *visit(xor_expression_c *symbol) {
 }
 
 void *visit(and_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype))
     return print_binary_expression(symbol->l_exp, symbol->r_exp, " && ");
   if (get_datatype_info_c::is_ANY_nBIT_compatible(symbol->datatype))
@@ -488,6 +537,7 @@ return NULL;
 }
 
 void *visit(equ_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_TIME_compatible      (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_DATE_compatible  (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_STRING_compatible(symbol->l_exp->datatype))
@@ -496,6 +546,7 @@ void *visit(equ_expression_c *symbol) {
 }
 
 void *visit(notequ_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_TIME_compatible      (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_DATE_compatible  (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_STRING_compatible(symbol->l_exp->datatype))
@@ -504,6 +555,7 @@ void *visit(notequ_expression_c *symbol) {
 }
 
 void *visit(lt_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_TIME_compatible      (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_DATE_compatible  (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_STRING_compatible(symbol->l_exp->datatype))
@@ -512,6 +564,7 @@ void *visit(lt_expression_c *symbol) {
 }
 
 void *visit(gt_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_TIME_compatible      (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_DATE_compatible  (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_STRING_compatible(symbol->l_exp->datatype))
@@ -520,6 +573,7 @@ void *visit(gt_expression_c *symbol) {
 }
 
 void *visit(le_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_TIME_compatible      (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_DATE_compatible  (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_STRING_compatible(symbol->l_exp->datatype))
@@ -528,6 +582,7 @@ void *visit(le_expression_c *symbol) {
 }
 
 void *visit(ge_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   if (get_datatype_info_c::is_TIME_compatible      (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_DATE_compatible  (symbol->l_exp->datatype) ||
       get_datatype_info_c::is_ANY_STRING_compatible(symbol->l_exp->datatype))
@@ -536,6 +591,7 @@ void *visit(ge_expression_c *symbol) {
 }
 
 void *visit(add_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
 /*
   symbol_c *left_type  = symbol->l_exp->datatype;
   symbol_c *right_type = symbol->r_exp->datatype;
@@ -551,6 +607,7 @@ void *visit(add_expression_c *symbol) {
 }
 
 void *visit(sub_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
 /*
   symbol_c *left_type  = symbol->l_exp->datatype;
   symbol_c *right_type = symbol->r_exp->datatype;
@@ -569,6 +626,7 @@ void *visit(sub_expression_c *symbol) {
 }
 
 void *visit(mul_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
 /*
   symbol_c *left_type  = symbol->l_exp->datatype;
   symbol_c *right_type = symbol->r_exp->datatype;
@@ -582,6 +640,7 @@ void *visit(mul_expression_c *symbol) {
 }
 
 void *visit(div_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
 /*
   symbol_c *left_type  = symbol->l_exp->datatype;
   symbol_c *right_type = symbol->r_exp->datatype;
@@ -595,6 +654,7 @@ void *visit(div_expression_c *symbol) {
 }
 
 void *visit(mod_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   s4o.print("((");
   symbol->r_exp->accept(*this);
   s4o.print(" == 0)?0:");
@@ -603,7 +663,74 @@ void *visit(mod_expression_c *symbol) {
   return NULL;
 }
 
+/* With the 'typed-expt' option, a ** b is computed in the data type of the result (REAL or LREAL):
+ *   - a ** 2, a ** 3 and a ** 4, with a a variable: by repeated multiplication (a * a * a);
+ *   - an integer exponent (ANY_INT, or an integral constant): __expt_int_<type>() (repeated squaring),
+ *     or __expt_uint_<type>() for an unsigned exponent (a ULINT may not fit in the LINT of __expt_int_<type>());
+ *   - any other exponent: __expt_<type>() (i.e. powf() for REAL, pow() for LREAL).
+ */
 void *visit(power_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
+
+  symbol_c *type = search_base_type_c::get_basetype_decl(symbol->datatype);
+  if (generate_c_options.typed_expt && (NULL != type) && get_datatype_info_c::is_ANY_REAL_compatible(type)) {
+    bool int_exponent  = get_datatype_info_c::is_ANY_INT_compatible(symbol->r_exp->datatype);
+    bool uint_exponent = get_datatype_info_c::is_ANY_unsigned_INT_compatible(symbol->r_exp->datatype);
+    bool const_exponent = false;
+    int64_t exponent = 0;
+    if (VALID_CVALUE(int64, symbol->r_exp)) {
+      exponent = GET_CVALUE(int64, symbol->r_exp); const_exponent = true;
+    } else if (VALID_CVALUE(uint64, symbol->r_exp) && (GET_CVALUE(uint64, symbol->r_exp) <= (uint64_t)INT64_MAX)) {
+      exponent = GET_CVALUE(uint64, symbol->r_exp); const_exponent = true;
+    } else if (VALID_CVALUE(uint64, symbol->r_exp)) {
+      /* too large for a LINT: computed by __expt_uint_<type>() below */
+    } else if (VALID_CVALUE(real64, symbol->r_exp) && !std::isnan(GET_CVALUE(real64, symbol->r_exp))
+                                                  && (fabs(GET_CVALUE(real64, symbol->r_exp)) < 1e18)  /* before the cast: it must not overflow */
+                                                  && (GET_CVALUE(real64, symbol->r_exp) == (int64_t)GET_CVALUE(real64, symbol->r_exp))) {
+      exponent = (int64_t)GET_CVALUE(real64, symbol->r_exp); const_exponent = true;
+    }
+    if (const_exponent) {int_exponent = true; uint_exponent = false;}
+
+    /* the base is printed several times, so it must be free of side effects (and cheap) */
+    bool simple_base = (NULL != dynamic_cast<symbolic_variable_c *>(symbol->l_exp)) ||
+                       (NULL != dynamic_cast<structured_variable_c *>(symbol->l_exp));
+    if (const_exponent && simple_base && (exponent >= 1) && (exponent <= 4)) {
+      s4o.print("(");
+      for (int64_t i = 0; i < exponent; i++) {
+        if (i > 0) s4o.print(" * ");
+        symbol->l_exp->accept(*this);
+      }
+      s4o.print(")");
+      return NULL;
+    }
+
+    s4o.print(uint_exponent? "__expt_uint_" : int_exponent? "__expt_int_" : "__expt_");
+    type->accept(*this);
+    s4o.print("(");
+    symbol->l_exp->accept(*this);
+    s4o.print(", ");
+    if (const_exponent) {
+      s4o.print("(LINT)");
+      s4o.print((long long int)exponent);
+    } else if (uint_exponent) {
+      s4o.print("(ULINT)(");
+      symbol->r_exp->accept(*this);
+      s4o.print(")");
+    } else if (int_exponent) {
+      s4o.print("(LINT)(");
+      symbol->r_exp->accept(*this);
+      s4o.print(")");
+    } else {
+      s4o.print("(");
+      type->accept(*this);
+      s4o.print(")(");
+      symbol->r_exp->accept(*this);
+      s4o.print(")");
+    }
+    s4o.print(")");
+    return NULL;
+  }
+
   s4o.print("EXPT__LREAL__LREAL__LREAL((BOOL)__BOOL_LITERAL(TRUE),\n");
   s4o.indent_right();
   s4o.print(s4o.indent_spaces + "NULL,\n");
@@ -617,10 +744,12 @@ void *visit(power_expression_c *symbol) {
 }
 
 void *visit(neg_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   return print_unary_expression(symbol->exp, " -");
 }
 
 void *visit(not_expression_c *symbol) {
+  if (print_const_value(symbol)) return NULL;
   return print_unary_expression(symbol->exp, get_datatype_info_c::is_BOOL_compatible(symbol->datatype)?"!":"~");
 }
 
@@ -738,6 +867,13 @@ void *visit(function_invocation_c *symbol) {
   int fdecl_mutiplicity =  function_symtable.count(symbol->function_name);
   if (fdecl_mutiplicity == 0) ERROR;
 
+  /* Calls to extensible standard functions without EN and ENO call their EN/ENO-free variants */
+  if (is_fast_function_call(function_name, NULL != function_call_param_iterator_c(symbol).search_f("EN"), param_list)) {
+    print_fast_function_call(get_called_function_name(function_name, f_decl, fdecl_mutiplicity), param_list);
+    CLEAR_PARAM_LIST()
+    return NULL;
+  }
+
   if (has_output_params) {
     fcall_number++;
     s4o.print("__");
@@ -827,7 +963,15 @@ void *visit(function_invocation_c *symbol) {
 /* B 3.2 Statements */
 /********************/
 void *visit(statement_list_c *symbol) {
-  return print_list(symbol, s4o.indent_spaces, ";\n" + s4o.indent_spaces, ";\n");
+  if (!generate_c_options.line_directives)
+    return print_list(symbol, s4o.indent_spaces, ";\n" + s4o.indent_spaces, ";\n");
+  for(int i = 0; i < symbol->n; i++) {
+    print_line_directive(symbol->elements[i]);
+    s4o.print(s4o.indent_spaces);
+    symbol->elements[i]->accept(*this);
+    s4o.print(";\n");
+  }
+  return NULL;
 }
 
 /*********************************/
@@ -900,7 +1044,11 @@ void *visit(fb_invocation_c *symbol) {
     if (param_value != NULL)
       if ((param_direction == function_param_iterator_c::direction_in) ||
           (param_direction == function_param_iterator_c::direction_inout)) {
-        if (this->is_variable_prefix_null()) {
+        if ((param_direction == function_param_iterator_c::direction_in) &&
+            is_input_by_ref(function_block_type_name, param_name)) {
+          print_input_ref(symbol->fb_name, param_name, param_type, param_value);
+        }
+        else if (this->is_variable_prefix_null()) {
           symbol->fb_name->accept(*this);
           s4o.print(".");
           param_name->accept(*this);
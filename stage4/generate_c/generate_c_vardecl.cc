@@ -23,6 +23,8 @@
  */
 
 #include <limits>  // required for std::numeric_limits<XXX>
+#include <vector>
+#include <math.h>  // required for signbit()
 
 class initialization_analyzer_c: public null_visitor_c {
   public:
@@ -80,6 +82,23 @@ class generate_c_array_initialization_c: public generate_c_typedecl_c {
     unsigned long long int defined_values_count;
     unsigned long long int current_initialization_count;
 
+    /* The initial values of the array elements, in order, as runs of consecutive elements
+     * with the same value. A repeat count in the initialization (e.g. [1000(0)]) becomes a
+     * single run, so it need not be expanded element by element.
+     */
+    typedef struct {
+      symbol_c *value;
+      unsigned long long int count;
+    } value_run_t;
+    std::vector<value_run_t> value_runs;
+
+    /* Arrays with at least this number of elements, whose values may be described by fewer than
+     * 1/RUN_LENGTH_MIN_RATIO runs, are initialised with a loop over a table of runs,
+     * instead of a C initializer listing every element.
+     */
+    static const unsigned long long int RUN_LENGTH_MIN_ARRAY_SIZE = 64;
+    static const unsigned long long int RUN_LENGTH_MIN_RATIO      = 4;
+
   public:
     generate_c_array_initialization_c(stage4out_c *s4o_ptr): generate_c_typedecl_c(s4o_ptr) {}
     ~generate_c_array_initialization_c(void) {}
@@ -102,27 +121,40 @@ class generate_c_array_initialization_c: public generate_c_typedecl_c {
       int i;
       
       init_array_size(array_specification);
+      get_array_values(array_initialization);
       
       s4o.print("\n");
       s4o.print(s4o.indent_spaces + "{\n");
       s4o.indent_right();
       s4o.print(s4o.indent_spaces);
-      s4o.print("static const ");
 
-      current_mode = typedecl_am;
-      array_specification->accept(*this);
-      s4o.print(" temp = ");
-
-      init_array_values(array_initialization);
+      if (use_run_length_initialization()) {
+        init_array_run_length(array_specification);
+      } else {
+        s4o.print("static const ");
+        current_mode = typedecl_am;
+        array_specification->accept(*this);
+        s4o.print(" temp = {{");
+        print_array_values();
+        s4o.print("}};\n");
+      }
 
-      s4o.print(";\n");
       var1_list->accept(*this);
       s4o.indent_left();
       s4o.print(s4o.indent_spaces + "}");
     }
     
     void init_array_values(symbol_c *array_initialization) {
+      get_array_values(array_initialization);
       s4o.print("{{");
+      print_array_values();
+      s4o.print("}}");
+    }
+
+  private:
+    /* Fill in value_runs with the initial value of every array element */
+    void get_array_values(symbol_c *array_initialization) {
+      value_runs.clear();
 
       current_mode = initializationvalue_am;
       array_initialization->accept(*this);
@@ -130,16 +162,105 @@ class generate_c_array_initialization_c: public generate_c_typedecl_c {
       if (array_default_initialization != NULL && defined_values_count < array_size)
         array_default_initialization->accept(*this);
       if (defined_values_count < array_size) {
-        for (unsigned long long int i = defined_values_count; i < array_size; i++) {
-          if (defined_values_count > 0)
-            s4o.print(",");
-          array_default_value->accept(*this);
-          defined_values_count++;
+        add_value_run(array_default_value, array_size - defined_values_count);
+        defined_values_count = array_size;
+      }
+    }
+
+    void add_value_run(symbol_c *value, unsigned long long int count) {
+      if (count == 0) return;
+      if (!value_runs.empty() && (value_runs.back().value == value)) {
+        value_runs.back().count += count;
+        return;
+      }
+      value_run_t run = {value, count};
+      value_runs.push_back(run);
+    }
+
+    /* Print the initial values of all elements, separated by commas */
+    void print_array_values(void) {
+      bool first = true;
+      current_mode = initializationvalue_am;
+      for (unsigned int r = 0; r < value_runs.size(); r++)
+        for (unsigned long long int i = 0; i < value_runs[r].count; i++) {
+          if (!first) s4o.print(",");
+          value_runs[r].value->accept(*this);
+          first = false;
+        }
+    }
+
+    /* Whether the value is known to be represented by all bits set to 0 (i.e. the value
+     * of a zero initialised static variable).
+     */
+    static bool is_zero_value(symbol_c *value) {
+      if (VALID_CVALUE(bool,   value)) return (GET_CVALUE(bool,   value) == false);
+      if (VALID_CVALUE(int64,  value)) return (GET_CVALUE(int64,  value) == 0);
+      if (VALID_CVALUE(uint64, value)) return (GET_CVALUE(uint64, value) == 0);
+      if (VALID_CVALUE(real64, value)) return (GET_CVALUE(real64, value) == 0) && !signbit(GET_CVALUE(real64, value));
+      return false;
+    }
+
+    bool use_run_length_initialization(void) {
+      return (array_size >= RUN_LENGTH_MIN_ARRAY_SIZE) && (value_runs.size() * RUN_LENGTH_MIN_RATIO <= array_size);
+    }
+
+    /* Initialise the array from a table of runs, i.e. for an ARRAY [1..1000] OF INT := [10(0), 990(5)]
+     *   static __ARRAY_OF_INT_1000 temp;
+     *   static const INT temp_values[] = {5};
+     *   static const unsigned long long temp_offsets[] = {10ULL};
+     *   static const unsigned long long temp_counts[] = {990ULL};
+     *   {unsigned long long r, i;
+     *    for (r = 0; r < 1; r++) for (i = 0; i < temp_counts[r]; i++)
+     *      ((INT *)&temp.table)[temp_offsets[r] + i] = temp_values[r];}
+     * The runs of zeros are left out, as a static variable starts off zero initialised.
+     */
+    void init_array_run_length(symbol_c *array_specification) {
+      std::vector<unsigned long long int> offsets;
+      std::vector<unsigned int> runs;
+      unsigned long long int offset = 0;
+
+      for (unsigned int r = 0; r < value_runs.size(); r++) {
+        if (!is_zero_value(value_runs[r].value)) {
+          offsets.push_back(offset);
+          runs.push_back(r);
         }
+        offset += value_runs[r].count;
       }
 
-      s4o.print("}}");
+      s4o.print("static ");
+      current_mode = typedecl_am;
+      array_specification->accept(*this);
+      s4o.print(" temp;\n");
+      if (runs.size() > 0) {
+        current_mode = initializationvalue_am;
+        s4o.print(s4o.indent_spaces + "static const ");
+        array_base_type->accept(*this);
+        s4o.print(" temp_values[] = {");
+        for (unsigned int j = 0; j < runs.size(); j++) {
+          if (j > 0) s4o.print(",");
+          value_runs[runs[j]].value->accept(*this);
+        }
+        s4o.print("};\n" + s4o.indent_spaces + "static const unsigned long long temp_offsets[] = {");
+        for (unsigned int j = 0; j < runs.size(); j++) {
+          if (j > 0) s4o.print(",");
+          s4o.print_long_long_integer(offsets[j]);
+        }
+        s4o.print("};\n" + s4o.indent_spaces + "static const unsigned long long temp_counts[] = {");
+        for (unsigned int j = 0; j < runs.size(); j++) {
+          if (j > 0) s4o.print(",");
+          s4o.print_long_long_integer(value_runs[runs[j]].count);
+        }
+        s4o.print("};\n" + s4o.indent_spaces + "{unsigned long long r, i;\n");
+        s4o.print(s4o.indent_spaces + " for (r = 0; r < ");
+        s4o.print((unsigned long)runs.size());
+        s4o.print("; r++) for (i = 0; i < temp_counts[r]; i++)\n");
+        s4o.print(s4o.indent_spaces + "   ((");
+        array_base_type->accept(*this);
+        s4o.print(" *)&temp.table)[temp_offsets[r] + i] = temp_values[r];}\n");
+      }
     }
+
+  public:
     
     void *visit(identifier_c *type_name) {
       symbol_c *type_decl;
@@ -245,9 +366,10 @@ class generate_c_array_initialization_c: public generate_c_typedecl_c {
             if (current_initialization_count >= defined_values_count) {
               if (defined_values_count >= array_size)
                 ERROR;
-              if (defined_values_count > 0)
-                s4o.print(",");
-              symbol->elements[i]->accept(*this);
+              if (symbol->elements[i]->kind == kind_array_initial_elements_c)
+                symbol->elements[i]->accept(*this);
+              else
+                add_value_run(symbol->elements[i], 1);
               defined_values_count++;
             }
             else {
@@ -290,25 +412,17 @@ class generate_c_array_initialization_c: public generate_c_typedecl_c {
               temp_element_number = initial_element_count - diff;
             current_initialization_count += initial_element_count - 1;
             initial_element_count = temp_element_number;
-            if (initial_element_count > 0) {
+            if (initial_element_count > 0)
               defined_values_count++;
-              s4o.print(",");
-            }
           }
           else
             current_initialization_count += initial_element_count - 1;
           if (defined_values_count + initial_element_count > array_size)
             ERROR;
-          for (unsigned long long int i = 0; i < initial_element_count; i++) {
-            if (i > 0)
-              s4o.print(",");
-            if (symbol->array_initial_element != NULL) {
-              symbol->array_initial_element->accept(*this);
-            }
-            else {
-              array_default_value->accept(*this);
-            }
-          }
+          if (symbol->array_initial_element != NULL)
+            add_value_run(symbol->array_initial_element, initial_element_count);
+          else
+            add_value_run(array_default_value, initial_element_count);
           if (initial_element_count > 1)
             defined_values_count += initial_element_count - 1;
           break;
@@ -806,6 +920,14 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
      *                long b;
      *                real c;
      *
+     * localflags_vf: declaration of the flags of the variables
+     *           declared with local_vf, for the struct of arrays layout
+     *           (see __IEC_SOA_LAYOUT in lib/accessor.h). Function block
+     *           instances, external and located variables keep their own flags.
+     *           e.g.
+     *                __DECLARE_VAR_FLAGS(a)
+     *                __DECLARE_VAR_FLAGS(b)
+     *
      * init_vf: local initialisation without declaration.
      *           e.g.
      *                a = 9;
@@ -833,6 +955,7 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
     typedef enum {finterface_vf,
                   foutputassign_vf,
                   local_vf,
+                  localflags_vf,
                   localinit_vf,
                   init_vf,
                   constructorinit_vf,
@@ -865,6 +988,14 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
     /* Used to declare 'void' in case no variables are declared in a function interface... */
     int finterface_var_count;
 
+    /* The only variable to declare (local_vf only), or NULL to declare all of them. */
+    /* Only set by print_variable()...! */
+    symbol_c *wanted_variable;
+
+    bool is_wanted_variable(symbol_c *variable_name) {
+      return (NULL == wanted_variable) || (variable_name == wanted_variable) || (compare_identifiers(variable_name, wanted_variable) == 0);
+    }
+
     /* Current parsed resource name, for resource 
      * specific global variable declaration (with #define...)*/
     symbol_c *resource_name;
@@ -936,11 +1067,25 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
       /* should NEVER EVER occur!! */
       if (list == NULL) ERROR;
 
+      if (wanted_varformat == localflags_vf) {
+        if (is_fb) return NULL;
+        for(int i = 0; i < list->n; i++) {
+          s4o.print(s4o.indent_spaces);
+          s4o.print(DECLARE_VAR_FLAGS);
+          s4o.print("(");
+          list->elements[i]->accept(*this);
+          s4o.print(")\n");
+        }
+        return NULL;
+      }
+
       /* now to produce the c equivalent... */
       if ((wanted_varformat == local_vf) ||
           (wanted_varformat == init_vf) ||
           (wanted_varformat == localinit_vf)) {
         for(int i = 0; i < list->n; i++) {
+          if (!is_wanted_variable(list->elements[i]))
+            continue;
           s4o.print(s4o.indent_spaces);
           if (wanted_varformat == local_vf) {
             if (!is_fb) {
@@ -1075,6 +1220,7 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
             s4o.print(INIT_VAR);
             s4o.print("(");
             this->print_variable_prefix();
+            s4o.print(",");
             list->elements[i]->accept(*this);
             s4o.print(",");
             this->current_var_init_symbol->accept(*this);
@@ -1100,6 +1246,7 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
       current_var_type_symbol = NULL;
       current_var_init_symbol = NULL;
       globalnamespace         = NULL;
+      wanted_variable         = NULL;
       nv = NULL;
       resource_name = res_name;
     }
@@ -1128,6 +1275,16 @@ class generate_c_vardecl_c: protected generate_c_typedecl_c {
       globalnamespace = NULL;
     }
 
+    /* Declare only the variable variable_name, out of the variable declarations in symbol.
+     * Only for the local_vf format, which declares each variable on its own.
+     */
+    void print_variable(symbol_c *symbol, symbol_c *variable_name) {
+      if (local_vf != wanted_varformat) ERROR;
+      wanted_variable = variable_name;
+      print(symbol);
+      wanted_variable = NULL;
+    }
+
   protected:
 /***************************/
 /* B 0 - Programming Model */
@@ -1274,7 +1431,15 @@ void *visit(en_param_declaration_c *symbol) {
       symbol->name->accept(*this);
     }
 
-    if ((wanted_varformat == local_vf) ||
+    if (wanted_varformat == localflags_vf) {
+      s4o.print(s4o.indent_spaces);
+      s4o.print(DECLARE_VAR_FLAGS);
+      s4o.print("(");
+      symbol->name->accept(*this);
+      s4o.print(")\n");
+    }
+
+    if (((wanted_varformat == local_vf) && is_wanted_variable(symbol->name)) ||
         (wanted_varformat == init_vf) ||
         (wanted_varformat == localinit_vf)) {
       s4o.print(s4o.indent_spaces);
@@ -1305,6 +1470,7 @@ void *visit(en_param_declaration_c *symbol) {
       s4o.print(INIT_VAR);
       s4o.print("(");
       this->print_variable_prefix();
+      s4o.print(",");
       // s4o.print("EN = __BOOL_LITERAL(TRUE);");
       symbol->name->accept(*this);
       s4o.print(",");
@@ -1333,7 +1499,15 @@ void *visit(eno_param_declaration_c *symbol) {
       symbol->name->accept(*this);
     }
 
-    if ((wanted_varformat == local_vf) ||
+    if (wanted_varformat == localflags_vf) {
+      s4o.print(s4o.indent_spaces);
+      s4o.print(DECLARE_VAR_FLAGS);
+      s4o.print("(");
+      symbol->name->accept(*this);
+      s4o.print(")\n");
+    }
+
+    if (((wanted_varformat == local_vf) && is_wanted_variable(symbol->name)) ||
         (wanted_varformat == init_vf) ||
         (wanted_varformat == localinit_vf)) {
       s4o.print(s4o.indent_spaces);
@@ -1375,6 +1549,7 @@ void *visit(eno_param_declaration_c *symbol) {
       s4o.print(INIT_VAR);
       s4o.print("(");
       this->print_variable_prefix();
+      s4o.print(",");
       // s4o.print("ENO = __BOOL_LITERAL(TRUE);");
       symbol->name->accept(*this);
       s4o.print(",__BOOL_LITERAL(TRUE)");
@@ -1715,6 +1890,8 @@ void *visit(located_var_decl_c *symbol) {
   /* now to produce the c equivalent... */
   switch(wanted_varformat) {
     case local_vf:
+      if (!is_wanted_variable((symbol->variable_name != NULL)? symbol->variable_name : symbol->location))
+        break;
       s4o.print(s4o.indent_spaces);
       s4o.print(DECLARE_LOCATED);
       s4o.print("(");
@@ -1857,6 +2034,8 @@ void *visit(external_declaration_c *symbol) {
   switch (wanted_varformat) {
     case local_vf:
     case localinit_vf:
+      if (!is_wanted_variable(symbol->global_var_name))
+        break;
       s4o.print(s4o.indent_spaces);
       if (is_fb)
         s4o.print(DECLARE_EXTERNAL_FB);
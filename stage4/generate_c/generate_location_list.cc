@@ -26,9 +26,9 @@ class generate_location_list_c: public iterator_visitor_c {
 
   protected:
     stage4out_c &s4o;
+    symbol_c *current_var_type_symbol;
 
   private:
-    symbol_c *current_var_type_symbol;
     generate_c_base_c *generate_c_base;
     
   public:
@@ -36,7 +36,7 @@ class generate_location_list_c: public iterator_visitor_c {
       generate_c_base = new generate_c_base_c(s4o_ptr);
       current_var_type_symbol = NULL;
     }
-    ~generate_location_list_c(void) {
+    virtual ~generate_location_list_c(void) {
       delete generate_c_base;
     }
 
@@ -50,34 +50,34 @@ class generate_location_list_c: public iterator_visitor_c {
       
       switch (location->value[2]) {
         case 'X': // bit
-          if (typeid(*current_var_type_symbol) == typeid(bool_type_name_c)) return true;
+          if (current_var_type_symbol->kind == kind_bool_type_name_c) return true;
           break;
         case 'B': // Byte, 8 bits
-          if (typeid(*current_var_type_symbol) == typeid(sint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(usint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(string_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(byte_type_name_c)) return true;
+          if (current_var_type_symbol->kind == kind_sint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_usint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_string_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_byte_type_name_c) return true;
           break;
         case 'W': // Word, 16 bits
-          if (typeid(*current_var_type_symbol) == typeid(int_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(uint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(word_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(wstring_type_name_c)) return true;
+          if (current_var_type_symbol->kind == kind_int_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_uint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_word_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_wstring_type_name_c) return true;
           break;
         case 'D': // Double, 32 bits
-          if (typeid(*current_var_type_symbol) == typeid(dint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(udint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(real_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(dword_type_name_c)) return true;
+          if (current_var_type_symbol->kind == kind_dint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_udint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_real_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_dword_type_name_c) return true;
           break;
         case 'L': // Long, 64 bits
-          if (typeid(*current_var_type_symbol) == typeid(lint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(ulint_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(lreal_type_name_c)) return true;
-          if (typeid(*current_var_type_symbol) == typeid(lword_type_name_c)) return true;
+          if (current_var_type_symbol->kind == kind_lint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_ulint_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_lreal_type_name_c) return true;
+          if (current_var_type_symbol->kind == kind_lword_type_name_c) return true;
           break;
         default:
-          if (typeid(*current_var_type_symbol) == typeid(bool_type_name_c)) return true;
+          if (current_var_type_symbol->kind == kind_bool_type_name_c) return true;
       }
       return false;
     }
@@ -152,3 +152,248 @@ class generate_location_list_c: public iterator_visitor_c {
     }
 
 }; /* generate_location_list_c */
+
+
+
+
+/***********************************************************************/
+/***********************************************************************/
+/***********************************************************************/
+/***********************************************************************/
+
+/* Generates PROCESS_IMAGE.c (iec2c -O process-image), which defines the located
+ * variables of LOCATED_VARIABLES.h inside contiguous input, output and memory
+ * images. See lib/iec_process_image.h for the layout of the images.
+ */
+class generate_process_image_c: public generate_location_list_c {
+
+  private:
+    typedef struct {
+      std::string name;                     /* C name, e.g. __IX2_3 */
+      std::string location;                 /* e.g. %IX2.3 */
+      std::string type;                     /* e.g. BOOL */
+      unsigned int size;                    /* in bytes, 0 for a packed bit */
+      std::vector<unsigned long> address;   /* e.g. {2, 3} */
+      unsigned int offset;
+      unsigned int bit;
+    } located_t;
+
+    /* the largest locations first, then by address */
+    static bool located_before(const located_t &a, const located_t &b) {
+      if (a.size != b.size) return (a.size == 0)? false : ((b.size == 0) || (a.size > b.size));
+      return a.address < b.address;
+    }
+
+    std::vector<located_t> images[3];       /* %I, %Q and %M */
+    std::vector<located_t> others;          /* STRING and WSTRING */
+    std::set<std::string> declared;
+    generate_c_base_c *type_printer;
+    std::ostringstream type_name;
+    stage4out_c type_name_s4o;
+
+  public:
+    generate_process_image_c(stage4out_c *s4o_ptr)
+      : generate_location_list_c(s4o_ptr), type_name_s4o(&type_name) {
+      type_printer = new generate_c_base_c(&type_name_s4o);
+    }
+    virtual ~generate_process_image_c(void) {
+      delete type_printer;
+    }
+
+    void generate(symbol_c *symbol) {
+      static const char *image_names[3] = {"input", "output", "memory"};
+
+      symbol->accept(*this);
+
+      s4o.print("/*******************************************/\n");
+      s4o.print("/*     FILE GENERATED BY iec2c             */\n");
+      s4o.print("/* Editing this file is not recommended... */\n");
+      s4o.print("/*******************************************/\n\n");
+      s4o.print("#include \"iec_std_lib.h\"\n");
+      s4o.print("#include \"iec_process_image.h\"\n\n");
+
+      for (int i = 0; i < 3; i++)
+        print_image(images[i], image_names[i], i == 2);
+
+      if (!others.empty()) {
+        s4o.print("/* Not part of any image */\n");
+        for (unsigned int i = 0; i < others.size(); i++) {
+          s4o.print("static " + others[i].type + " _" + others[i].name + ";\n");
+          s4o.print(others[i].type + " *" + others[i].name + " = &_" + others[i].name + ";\n");
+        }
+      }
+    }
+
+  private:
+    void print_image(std::vector<located_t> &image, std::string image_name, bool unpacked_bits) {
+      std::vector<located_t> bits;
+      unsigned int offset = 0, group_offset = 0;
+
+      /* lay out the image */
+      std::sort(image.begin(), image.end(), located_before);
+      for (unsigned int i = 0; i < image.size(); i++) {
+        located_t &located = image[i];
+        if (located.size == 0 && unpacked_bits)
+          located.size = 1;
+        if (located.size > 0) {
+          located.offset = offset;
+          offset += located.size;
+          continue;
+        }
+        /* a packed bit: the bits whose address only differ by the last number share the same bytes */
+        if (bits.empty() || !same_bit_group(bits.back(), located)) {
+          group_offset = offset;
+          offset += group_size(image, i);
+        }
+        located.offset = group_offset + located.address.back() / 8;
+        located.bit = located.address.back() % 8;
+        bits.push_back(located);
+      }
+
+      s4o.print("/* ");
+      s4o.print(image_name);
+      s4o.print(" image */\n");
+      s4o.print("IEC_LWORD __IEC_" + image_name + "_image[");
+      s4o.print((offset + 7) / 8 + ((offset == 0)? 1 : 0));
+      s4o.print("];\n");
+      s4o.print("const unsigned int __IEC_" + image_name + "_image_size = ");
+      s4o.print(offset);
+      s4o.print(";\n");
+
+      /* the located variables */
+      if (!bits.empty()) {
+        s4o.print("static BOOL __IEC_" + image_name + "_bools[");
+        s4o.print((unsigned int)bits.size());
+        s4o.print("];\n");
+      }
+      for (unsigned int i = 0, b = 0; i < image.size(); i++) {
+        located_t &located = image[i];
+        s4o.print(located.type + " *" + located.name + " = ");
+        if (located.size > 0) {
+          s4o.print("(" + located.type + " *)((unsigned char *)__IEC_" + image_name + "_image + ");
+          s4o.print(located.offset);
+          s4o.print(");\n");
+        } else {
+          s4o.print("&__IEC_" + image_name + "_bools[");
+          s4o.print(b++);
+          s4o.print("];\n");
+        }
+      }
+
+      /* the offset table */
+      s4o.print("const __IEC_image_location_t __IEC_" + image_name + "_locations[] = {\n");
+      for (unsigned int i = 0; i < image.size(); i++) {
+        s4o.print("  {\"" + image[i].location + "\", ");
+        s4o.print(image[i].offset);
+        s4o.print(", ");
+        s4o.print(image[i].bit);
+        s4o.print(", ");
+        s4o.print(image[i].size);
+        s4o.print("},\n");
+      }
+      s4o.print("  {NULL, 0, 0, 0}\n};\n");
+      s4o.print("const unsigned int __IEC_" + image_name + "_locations_count = ");
+      s4o.print((unsigned int)image.size());
+      s4o.print(";\n");
+
+      /* copying the bits */
+      if (image_name != "memory") {
+        if (!bits.empty()) {
+          s4o.print("static const __IEC_image_bit_t __IEC_" + image_name + "_bits[] = {\n");
+          for (unsigned int i = 0; i < bits.size(); i++) {
+            s4o.print("  {");
+            s4o.print(bits[i].offset);
+            s4o.print(", ");
+            s4o.print(bits[i].bit);
+            s4o.print("},\n");
+          }
+          s4o.print("};\n");
+        }
+        if (image_name == "input")
+          s4o.print("void __IEC_unpack_input_image(void) {\n");
+        else
+          s4o.print("void __IEC_pack_output_image(void) {\n");
+        if (!bits.empty()) {
+          s4o.print(s4o.indent_spaces + "  ");
+          s4o.print((image_name == "input")? "__IEC_unpack_bits(" : "__IEC_pack_bits(");
+          s4o.print("__IEC_" + image_name + "_image, __IEC_" + image_name + "_bools, __IEC_" + image_name + "_bits, ");
+          s4o.print((unsigned int)bits.size());
+          s4o.print(");\n");
+        }
+        s4o.print("}\n");
+      }
+      s4o.print("\n");
+    }
+
+    static bool same_bit_group(const located_t &a, const located_t &b) {
+      return (a.address.size() == b.address.size())
+          && std::equal(a.address.begin(), a.address.end() - 1, b.address.begin());
+    }
+
+    /* the number of bytes taken by the bits of the group starting at image[i] (the
+     * bits are sorted by address, so the last bit of the group has the highest number)
+     */
+    static unsigned int group_size(const std::vector<located_t> &image, unsigned int i) {
+      unsigned int last = i;
+      while ((last + 1 < image.size()) && same_bit_group(image[last + 1], image[i]))
+        last++;
+      return image[last].address.back() / 8 + 1;
+    }
+
+/********************************************/
+/* B.1.4.1   Directly Represented Variables */
+/********************************************/
+
+    void *visit(direct_variable_c *symbol) {
+      if (NULL == current_var_type_symbol)
+        return NULL;
+
+      located_t located;
+      const char *value = symbol->value + 1;   /* skip the % */
+      for (int i = 0; value[i] != '\0'; i++)
+        located.name += (value[i] == '.')? '_' : (char)toupper(value[i]);
+      located.name = "__" + located.name;
+      if (!declared.insert(located.name).second)
+        return NULL;  /* the same location, declared elsewhere */
+      located.location = "%";
+      for (int i = 0; value[i] != '\0'; i++)
+        located.location += (char)toupper(value[i]);
+
+      type_name.str("");
+      current_var_type_symbol->accept(*type_printer);
+      located.type = type_name.str();
+
+      int image = 0;
+      switch (toupper(value[0])) {
+        case 'I': image = 0; break;
+        case 'Q': image = 1; break;
+        case 'M': image = 2; break;
+        default : ERROR;
+      }
+      const char *number = value + 1;
+      switch (toupper(value[1])) {
+        case 'X': located.size = 0; number++; break;
+        case 'B': located.size = 1; number++; break;
+        case 'W': located.size = 2; number++; break;
+        case 'D': located.size = 4; number++; break;
+        case 'L': located.size = 8; number++; break;
+        default : located.size = 0;   /* %I0.1 is a bit */
+      }
+      while (*number != '\0') {
+        char *end;
+        located.address.push_back(strtoul(number, &end, 10));
+        if ((end == number) || ((*end != '.') && (*end != '\0'))) ERROR;
+        number = (*end == '.')? end + 1 : end;
+      }
+      if (located.address.empty()) ERROR;
+      located.offset = 0;
+      located.bit = 0;
+
+      if ((located.type == "STRING") || (located.type == "WSTRING"))
+        others.push_back(located);
+      else
+        images[image].push_back(located);
+      return NULL;
+    }
+
+}; /* generate_process_image_c */
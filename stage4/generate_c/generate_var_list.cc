@@ -219,9 +219,22 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     bool configuration_defined;
     std::list<SYMBOL> current_symbol_list;
     search_type_symbol_c *search_type_symbol;
+
+    /* The registry of the variables (VARIABLES.c, see lib/iec_debug.h), or NULL if not wanted.
+     * Its entries are built while VARIABLES.csv is being generated, in the same order.
+     */
+    stage4out_c *registry_s4o;
+    /* What must be prepended to the name of a variable to get its C name, for each
+     * enclosing scope: "CONFIG__" or "RES0__" for the global variables, "RES0__INST0."
+     * then "RES0__INST0.FB1." for the variables of program and FB instances.
+     */
+    std::list<std::string> current_c_prefix_list;
+    std::string registry_externs;
+    std::string registry_entries;
+    std::string registry_element_entries;
     
   public:
-    generate_var_list_c(stage4out_c *s4o_ptr, symbol_c *scope)
+    generate_var_list_c(stage4out_c *s4o_ptr, symbol_c *scope, stage4out_c *registry_s4o_ptr = NULL)
     : generate_c_typedecl_c(s4o_ptr) {
       search_type_symbol = new search_type_symbol_c(scope);
       current_var_number = 0;
@@ -229,6 +242,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
       current_var_type_name = NULL;
       current_declarationtype = none_dt;
       current_var_class_category = none_vcc;
+      registry_s4o = registry_s4o_ptr;
     }
     
     ~generate_var_list_c(void) {
@@ -259,11 +273,31 @@ class generate_var_list_c: protected generate_c_typedecl_c {
       current_var_number = 0;
       configuration_defined = false;
       current_declarationtype = variables_dt;
+      registry_externs.clear();
+      registry_entries.clear();
+      registry_element_entries.clear();
       symbol->accept(*this);
       current_declarationtype = none_dt;
       s4o.print("\n");
+      if (NULL != registry_s4o)
+        print_registry();
     }
     
+    /* With the struct of arrays layout (iec2c -O soa-layout) the variables listed
+     * above still start with their value, but their flags are no longer right after it.
+     * The debugger must then look for the flags of
+     *   - a VAR (or ARRAY, STRUCT) of a program or FB instance, e.g. RES0__INST0.FB1.X,
+     *     in the __flags member of the instance it belongs to, i.e. RES0__INST0.FB1.__flags.X
+     *   - a global VAR, e.g. CONFIG__X, in CONFIG__X__flags
+     * EXT, IN, OUT and MEM variables keep their flags in their own (pointer) struct.
+     */
+    void generate_layout(void) {
+      if (!generate_c_options.soa_layout)
+        return;
+      s4o.print("\n// Layout\n");
+      s4o.print("SOA\n");
+    }
+
     void declare_variables(symbol_c *symbol) {
       list_c *list = dynamic_cast<list_c *>(symbol);
       /* should NEVER EVER occur!! */
@@ -276,13 +310,16 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     
     void declare_variable(symbol_c *symbol) {
       // Arrays and structures are not supported in debugging
+      // (but their elements are in the registry)
       switch (search_type_symbol->current_var_type_category) {
           case search_type_symbol_c::array_vtc:
           case search_type_symbol_c::structure_vtc:
+          declare_registry_elements(symbol);
           return;
           default:
            break;
       }
+      declare_registry_entry(symbol);
       print_var_number();
       s4o.print(";");
       switch (search_type_symbol->current_var_type_category) {
@@ -334,7 +371,9 @@ class generate_var_list_c: protected generate_c_typedecl_c {
               current_name->symbol = symbol;
               tmp_var_type = this->current_var_type_symbol;
               current_symbol_list.push_back(*current_name);
+              current_c_prefix_list.push_back(c_variable_name(symbol) + ".");
               this->current_var_type_symbol->accept(*this);
+              current_c_prefix_list.pop_back();
               current_symbol_list.pop_back();
               this->current_var_type_symbol = tmp_var_type;
           }
@@ -384,6 +423,202 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     }
 
 
+/*******************************************/
+/* Registry of the variables (VARIABLES.c) */
+/*******************************************/
+    static std::string symbol_str(symbol_c *symbol) {
+      std::ostringstream buffer;
+      stage4out_c buffer_s4o(&buffer);
+      generate_c_base_c printer(&buffer_s4o);
+      symbol->accept(printer);
+      return buffer.str();
+    }
+
+    static std::string number_str(unsigned long long number) {
+      std::ostringstream buffer;
+      buffer << number;
+      return buffer.str();
+    }
+
+    /* The names of the enclosing configuration, resource and instances, as in VARIABLES.csv */
+    std::string iec_scope_name(void) {
+      std::string name;
+      std::list<SYMBOL>::iterator pt;
+      for(pt = current_symbol_list.begin(); pt != current_symbol_list.end(); pt++)
+        name += symbol_str(pt->symbol) + ".";
+      return name;
+    }
+
+    /* The name of the variable in VARIABLES.csv */
+    std::string iec_variable_name(symbol_c *symbol) {
+      return iec_scope_name() + symbol_str(symbol);
+    }
+
+    /* The name of the variable in the generated C code */
+    std::string c_variable_name(symbol_c *symbol) {
+      if (current_c_prefix_list.empty()) ERROR;
+      return current_c_prefix_list.back() + symbol_str(symbol);
+    }
+
+    /* Global variables and program instances are declared in other C files */
+    bool in_global_scope(void) {
+      return !current_c_prefix_list.empty() && (current_c_prefix_list.back().compare(current_c_prefix_list.back().length() - 1, 1, ".") != 0);
+    }
+
+    /* The __IEC_types_enum value of a value of the given base type */
+    static std::string registry_type(symbol_c *type_decl, bool pointer) {
+      if (!get_datatype_info_c::is_ANY_ELEMENTARY(type_decl))
+        return "UNKNOWN_ENUM";
+      std::string type_name = symbol_str(type_decl);
+      if (type_name == "WSTRING")  /* not in the __ANY() list of iec_types_all.h */
+        return "UNKNOWN_ENUM";
+      return type_name + (pointer? "_P_ENUM" : "_ENUM");
+    }
+
+    static void add_registry_entry(std::string &entries, std::string name, std::string ptr, std::string type,
+                                   std::string size, std::string count, std::string stride) {
+      entries += "  {\"" + name + "\", " + ptr + ", " + type + ", " + size + ", " + count + ", " + stride + "},\n";
+    }
+
+    /* The entry of a variable listed in VARIABLES.csv (i.e. not an array nor a structure).
+     * Values that do not have a fixed address (the EXT, IN, OUT and MEM variables of a
+     * type that is not elementary, the FB instances) get an entry without a value,
+     * so the entries keep the numbers of VARIABLES.csv.
+     */
+    void declare_registry_entry(symbol_c *symbol) {
+      if (NULL == registry_s4o)
+        return;
+
+      std::string name = iec_variable_name(symbol);
+      bool pointer = (this->current_var_class_category != none_vcc);
+      bool has_name = (NULL != dynamic_cast<identifier_c *>(symbol));
+
+      if (search_type_symbol->current_var_type_category == search_type_symbol_c::function_block_vtc) {
+        if (in_global_scope() && !pointer)
+          registry_externs += "extern " + symbol_str(this->current_var_type_name) + " " + c_variable_name(symbol) + ";\n";
+        add_registry_entry(registry_entries, name, "NULL", "UNKNOWN_ENUM", "0", "0", "0");
+        return;
+      }
+
+      std::string type = registry_type(this->current_var_type_symbol, pointer);
+      if (!has_name || (pointer && (type == "UNKNOWN_ENUM"))) {
+        add_registry_entry(registry_entries, name, "NULL", "UNKNOWN_ENUM", "0", "0", "0");
+        return;
+      }
+
+      std::string c_name = c_variable_name(symbol);
+      std::string value = pointer? "*(" + c_name + ".value)" : c_name + ".value";
+      if (in_global_scope())
+        registry_externs += "extern __IEC_" + symbol_str(this->current_var_type_name) + (pointer? "_p " : "_t ") + c_name + ";\n";
+      add_registry_entry(registry_entries, name, "&(" + c_name + ")", type, "sizeof(" + value + ")", "1", "sizeof(" + value + ")");
+    }
+
+    /* The entries of the elements of an array, or the members of a structure, declared
+     * as a VAR (the EXT variables refer to a global variable, whose elements are already
+     * in the registry).
+     */
+    void declare_registry_elements(symbol_c *symbol) {
+      if ((NULL == registry_s4o) || (this->current_var_class_category != none_vcc))
+        return;
+
+      std::string c_name = c_variable_name(symbol);
+      if (in_global_scope()) {
+        std::string type_name = symbol_str(this->current_var_type_name);
+        array_specification_c *array = dynamic_cast<array_specification_c *>(this->current_var_type_symbol);
+        if ((NULL != array) && (this->current_var_type_name == array->non_generic_type_name)) {
+          /* an anonymous array type, named as in generate_c_vardecl_c */
+          list_c *subranges = dynamic_cast<list_c *>(array->array_subrange_list);
+          if (NULL == subranges) ERROR;
+          type_name = "__" + type_name;
+          for (int i = 0; i < subranges->n; i++) {
+            subrange_c *subrange = dynamic_cast<subrange_c *>(subranges->elements[i]);
+            if (NULL == subrange) ERROR;
+            type_name += "_" + number_str(subrange->dimension);
+          }
+        }
+        registry_externs += "extern __IEC_" + type_name + "_t " + c_name + ";\n";
+      }
+      declare_registry_values(this->current_var_type_symbol, c_name + ".value", iec_variable_name(symbol), 1, "");
+    }
+
+    /* c_path: the first value, held in 'count' values 'stride' bytes apart */
+    void declare_registry_values(symbol_c *type_decl, std::string c_path, std::string name, unsigned long long count, std::string stride) {
+      array_specification_c *array = dynamic_cast<array_specification_c *>(type_decl);
+      structure_element_declaration_list_c *elements = dynamic_cast<structure_element_declaration_list_c *>(type_decl);
+
+      if ((NULL != array) && (count == 1)) {
+        list_c *subranges = dynamic_cast<list_c *>(array->array_subrange_list);
+        if (NULL == subranges) ERROR;
+        c_path += ".table";
+        for (int i = 0; i < subranges->n; i++) {
+          subrange_c *subrange = dynamic_cast<subrange_c *>(subranges->elements[i]);
+          if (NULL == subrange) ERROR;
+          count *= subrange->dimension;
+          c_path += "[0]";
+        }
+        declare_registry_values(search_base_type_c::get_basetype_decl(array->non_generic_type_name), c_path, name, count, "sizeof(" + c_path + ")");
+        return;
+      }
+
+      if (NULL != elements) {
+        for (int i = 0; i < elements->n; i++) {
+          structure_element_declaration_c *element = dynamic_cast<structure_element_declaration_c *>(elements->elements[i]);
+          if (NULL == element) ERROR;
+          std::string element_name = symbol_str(element->structure_element_name);
+          declare_registry_values(search_base_type_c::get_basetype_decl(element->spec_init),
+                                  c_path + "." + element_name, name + "." + element_name, count, stride);
+        }
+        return;
+      }
+
+      /* an elementary or enumerated value, or an array held in an array of structures (a single value) */
+      if (count == 1)
+        stride = "sizeof(" + c_path + ")";
+      add_registry_entry(registry_element_entries, name, "&(" + c_path + ")", registry_type(type_decl, false),
+                         "sizeof(" + c_path + ")", number_str(count), stride);
+    }
+
+    /* The names of the steps of a transition, as in VARIABLES.csv */
+    static std::string steps_str(steps_c *symbol) {
+      if (symbol->step_name != NULL)
+        return symbol_str(symbol->step_name);
+      list_c *list = dynamic_cast<list_c *>(symbol->step_name_list);
+      if (NULL == list) ERROR;
+      std::string names;
+      for (int i = 0; i < list->n; i++)
+        names += (i > 0? "," : "") + symbol_str(list->elements[i]);
+      return names;
+    }
+
+    /* The entry of a step, action or transition of a SFC */
+    void declare_registry_sfc_entry(std::string name, std::string c_member) {
+      if (NULL == registry_s4o)
+        return;
+      std::string c_name = current_c_prefix_list.back() + c_member;
+      add_registry_entry(registry_entries, name, "&(" + c_name + ")", "BOOL_ENUM", "sizeof(" + c_name + ".value)", "1", "sizeof(" + c_name + ".value)");
+    }
+
+    void print_registry(void) {
+      registry_s4o->print("/*******************************************/\n");
+      registry_s4o->print("/*     FILE GENERATED BY iec2c             */\n");
+      registry_s4o->print("/* Editing this file is not recommended... */\n");
+      registry_s4o->print("/*******************************************/\n\n");
+      print_layout_definition(*registry_s4o);
+      registry_s4o->print("#include \"iec_std_lib.h\"\n\n");
+      registry_s4o->print("#include \"accessor.h\"\n");
+      registry_s4o->print("#include \"POUS.h\"\n");
+      registry_s4o->print("#include \"iec_debug.h\"\n\n");
+      registry_s4o->print(registry_externs);
+      registry_s4o->print("\n// The variables of VARIABLES.csv, then the elements of the arrays and structures\n");
+      registry_s4o->print("const __IEC_debug_var_t __IEC_debug_vars[] = {\n");
+      registry_s4o->print(registry_entries);
+      registry_s4o->print(registry_element_entries);
+      registry_s4o->print("  {NULL, NULL, UNKNOWN_ENUM, 0, 0, 0}\n");
+      registry_s4o->print("};\n\n");
+      registry_s4o->print("const unsigned int __IEC_debug_vars_count = sizeof(__IEC_debug_vars) / sizeof(__IEC_debug_vars[0]) - 1;\n");
+    }
+
+
 /********************************/
 /* B 1.3.3 - Derived data types */
 /********************************/
@@ -849,6 +1084,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     /* INITIAL_STEP step_name ':' action_association_list END_STEP */
     //SYM_REF2(initial_step_c, step_name, action_association_list)
     void *visit(initial_step_c *symbol) {
+      declare_registry_sfc_entry(iec_variable_name(symbol->step_name) + ".X", "__step_list[" + number_str(step_number) + "].state");
       print_var_number();
       s4o.print(";VAR;");
       print_symbol_list();
@@ -865,6 +1101,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     /* STEP step_name ':' action_association_list END_STEP */
     //SYM_REF2(step_c, step_name, action_association_list)
     void *visit(step_c *symbol) {
+      declare_registry_sfc_entry(iec_variable_name(symbol->step_name) + ".X", "__step_list[" + number_str(step_number) + "].state");
       print_var_number();
       s4o.print(";VAR;");
       print_symbol_list();
@@ -887,6 +1124,12 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     /* integer -> may be NULL ! */
     //SYM_REF5(transition_c, transition_name, integer, from_steps, to_steps, transition_condition)
     void *visit(transition_c *symbol) {
+      if (NULL != registry_s4o) {
+        steps_c *from_steps = dynamic_cast<steps_c *>(symbol->from_steps);
+        steps_c *to_steps   = dynamic_cast<steps_c *>(symbol->to_steps);
+        if ((NULL == from_steps) || (NULL == to_steps)) ERROR;
+        declare_registry_sfc_entry(iec_scope_name() + steps_str(from_steps) + "->" + steps_str(to_steps), "__debug_transition_list[" + number_str(transition_number) + "]");
+      }
       print_var_number();
       s4o.print(";VAR;");
       print_symbol_list();
@@ -928,6 +1171,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     /* ACTION action_name ':' function_block_body END_ACTION */
     //SYM_REF2(action_c, action_name, function_block_body)
     void *visit(action_c *symbol) {
+      declare_registry_sfc_entry(iec_variable_name(symbol->action_name) + ".Q", "__action_list[" + number_str(action_number) + "].state");
       print_var_number();
       s4o.print(";VAR;");
       print_symbol_list();
@@ -995,6 +1239,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
       current_name = new SYMBOL;
       current_name->symbol = symbol->configuration_name;
       current_symbol_list.push_back(*current_name);
+      current_c_prefix_list.push_back(symbol_str(symbol->configuration_name) + "__");
       configuration_defined = true;
       
       switch (current_declarationtype) {
@@ -1007,6 +1252,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
       }
 
       symbol->resource_declarations->accept(*this);
+      current_c_prefix_list.pop_back();
       current_symbol_list.pop_back();
       configuration_defined = false;
       return NULL;
@@ -1023,6 +1269,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
       current_name = new SYMBOL;
       current_name->symbol = symbol->resource_name;
       current_symbol_list.push_back(*current_name);
+      current_c_prefix_list.push_back(symbol_str(symbol->resource_name) + "__");
 
       switch (current_declarationtype) {
         case variables_dt:
@@ -1036,6 +1283,7 @@ class generate_var_list_c: protected generate_c_typedecl_c {
       
       symbol->resource_declaration->accept(*this);
       
+      current_c_prefix_list.pop_back();
       current_symbol_list.pop_back();
       return NULL;
     }
@@ -1043,7 +1291,13 @@ class generate_var_list_c: protected generate_c_typedecl_c {
     /* task_configuration_list program_configuration_list */
     //SYM_REF2(single_resource_declaration_c, task_configuration_list, program_configuration_list)
     void *visit(single_resource_declaration_c *symbol) {
+      /* a configuration without any RESOURCE: generate_c names it RESOURCE */
+      bool single_resource = (current_c_prefix_list.size() == 1);
+      if (single_resource)
+        current_c_prefix_list.push_back("RESOURCE__");
       symbol->program_configuration_list->accept(*this);
+      if (single_resource)
+        current_c_prefix_list.pop_back();
       return NULL;
     }
     
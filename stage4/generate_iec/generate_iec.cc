@@ -695,7 +695,7 @@ void *visit(non_retain_option_c *symbol) {s4o.print("NON_RETAIN"); return NULL;}
 /* VAR_INPUT [RETAIN | NON_RETAIN] input_declaration_list END_VAR */
 /* option -> the RETAIN/NON_RETAIN/<NULL> directive... */
 void *visit(input_declarations_c *symbol) {
-  if (typeid(*(symbol->method)) == typeid(explicit_definition_c)) {
+  if (symbol->method->kind == kind_explicit_definition_c) {
     s4o.print(s4o.indent_spaces); s4o.print("VAR_INPUT ");
     if (symbol->option != NULL)
       symbol->option->accept(*this);
@@ -728,7 +728,7 @@ void *visit(implicit_definition_c *symbol) {return NULL;}
 
 /* EN : BOOL := 1 */
 void *visit(en_param_declaration_c *symbol) {
-  if (typeid(*(symbol->method)) == typeid(explicit_definition_c)) {
+  if (symbol->method->kind == kind_explicit_definition_c) {
     symbol->name->accept(*this);
     s4o.print(" : ");
     symbol->type_decl->accept(*this);
@@ -738,7 +738,7 @@ void *visit(en_param_declaration_c *symbol) {
 
 /* ENO : BOOL */
 void *visit(eno_param_declaration_c *symbol) {
-  if (typeid(*(symbol->method)) == typeid(explicit_definition_c)) {
+  if (symbol->method->kind == kind_explicit_definition_c) {
     symbol->name->accept(*this);
     s4o.print(" : ");
     symbol->type->accept(*this);
@@ -831,7 +831,7 @@ void *visit(fb_name_list_c *symbol) {return print_list(symbol, "", ", ");}
 /* VAR_OUTPUT [RETAIN | NON_RETAIN] var_init_decl_list END_VAR */
 /* option -> may be NULL ! */
 void *visit(output_declarations_c *symbol) {
-  if (typeid(*(symbol->method)) == typeid(explicit_definition_c)) {
+  if (symbol->method->kind == kind_explicit_definition_c) {
     s4o.print(s4o.indent_spaces); s4o.print("VAR_OUTPUT ");
     if (symbol->option != NULL)
       symbol->option->accept(*this);
@@ -2097,6 +2097,19 @@ visitor_c *new_code_generator(stage4out_c *s4o, const char *builddir)  {return n
 void delete_code_generator(visitor_c *code_generator) {delete code_generator;}
 
 
+/* The IEC code generator does not have any options */
+int stage4_parse_options(char *options) {
+  if ((NULL == options) || ('\0' == *options))
+    return 0;
+  fprintf(stderr, "Unrecognized option for the IEC code generator: '%s'\n", options);
+  return -1;
+}
+
+void stage4_print_options(void) {
+  printf("      (the IEC code generator does not have any options)\n");
+}
+
+
 
 
 
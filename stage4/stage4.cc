@@ -79,6 +79,18 @@ stage4out_c::stage4out_c(std::string indent_level):
   this->indent_level = indent_level;
   this->indent_spaces = "";
   allow_output = true;
+  capture = NULL;
+  captured_out = NULL;
+}
+
+stage4out_c::stage4out_c(std::ostream *out_stream, std::string indent_level):
+	m_file(NULL) {
+  out = out_stream;
+  this->indent_level = indent_level;
+  this->indent_spaces = "";
+  allow_output = true;
+  capture = NULL;
+  captured_out = NULL;
 }
 
 stage4out_c::stage4out_c(const char *dir, const char *radix, const char *extension, std::string indent_level) {	
@@ -103,6 +115,8 @@ stage4out_c::stage4out_c(const char *dir, const char *radix, const char *extensi
   this->indent_level = indent_level;
   this->indent_spaces = "";
   allow_output = true;
+  capture = NULL;
+  captured_out = NULL;
 }
 
 stage4out_c::~stage4out_c(void) {
@@ -117,6 +131,18 @@ void stage4out_c::flush(void) {
   out->flush();
 }
 
+void stage4out_c::close(void) {
+  static std::ofstream discard;  /* never opened: discards everything */
+  if (NULL == m_file) return;
+  m_file->close();
+  delete m_file;
+  m_file = NULL;
+  out = &discard;
+}
+
+/* NOTE: the {enable code generation} pragmas may appear inside the body of a POU, while
+ *       its code is being captured for the build cache, so the capture is left untouched.
+ */
 void stage4out_c::enable_output(void) {
   allow_output = true;
 }
@@ -125,6 +151,28 @@ void stage4out_c::disable_output(void) {
   allow_output = false;
 }
 
+bool stage4out_c::is_output_enabled(void) {
+  return allow_output;
+}
+
+void stage4out_c::start_capture(void) {
+  if (NULL != capture) ERROR;
+  capture = new std::ostringstream();
+  captured_out = out;
+  out = capture;
+}
+
+std::string stage4out_c::stop_capture(void) {
+  if (NULL == capture) ERROR;
+  std::string text = capture->str();
+  out = captured_out;
+  *out << text;
+  delete capture;
+  capture = NULL;
+  captured_out = NULL;
+  return text;
+}
+
 void stage4out_c::indent_right(void) {
   indent_spaces+=indent_level;
 }
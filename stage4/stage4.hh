@@ -39,6 +39,7 @@
 #ifndef _STAGE4_HH
 #define _STAGE4_HH
 
+#include <sstream>
 #include "../absyntax/absyntax.hh"
 
 
@@ -53,12 +54,24 @@ class stage4out_c {
   public:
     stage4out_c(std::string indent_level = "  ");
     stage4out_c(const char *dir, const char *radix, const char *extension, std::string indent_level = "  ");
+    /* print to a stream owned by the caller (e.g. a std::ostringstream) */
+    stage4out_c(std::ostream *out_stream, std::string indent_level = "  ");
     ~stage4out_c(void);
     
     void flush(void);
+    /* close the file (if printing to a file), so it may be re-written; what is printed afterwards is discarded */
+    void close(void);
     
     void enable_output(void);
     void disable_output(void);
+    bool is_output_enabled(void);
+
+    /* Temporarily send the output to a buffer as well, so the code generated
+     * for a POU may be stored in the build cache (see absyntax_utils/build_cache.hh).
+     * stop_capture() returns the text printed since start_capture().
+     */
+    void        start_capture(void);
+    std::string stop_capture(void);
 
     void indent_right(void);
     void indent_left(void);
@@ -98,10 +111,20 @@ class stage4out_c {
      */
     bool allow_output;
 
+    /* the stream being captured into, or NULL when not capturing */
+    std::ostringstream *capture;
+    std::ostream       *captured_out;
 };
 
 
 
+/* Each code generator (generate_c, generate_iec, ...) accepts its own set of options,
+ * given in the command line as a comma separated list (e.g. -O opt1,opt2=value).
+ * stage4_parse_options() returns -1 if any option is not recognized, or 0 otherwise.
+ */
+int  stage4_parse_options(char *options);
+void stage4_print_options(void);
+
 int stage4(symbol_c *tree_root, const char *builddir);
 
 #endif /* _STAGE4_HH */
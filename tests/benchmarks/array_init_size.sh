@@ -0,0 +1,41 @@
+#!/bin/bash
+# Measures the size of the generated POUS.c, and the time gcc takes to
+# compile it, for a program with large 'recipe table' arrays initialised
+# with repeat counts (e.g. [100000(0)]).
+#
+# To compare with another version of the compiler, give the path to
+# its iec2c binary in the IEC2C environment variable.
+#
+# usage: ./array_init_size.sh [ARRAY_SIZE]
+
+SIZE=${1:-100000}
+
+. ./common.sh array_init_size
+
+cat > $OUTDIR/recipes.st <<END
+PROGRAM recipes
+  VAR
+    zeros    : ARRAY [1..$SIZE] OF INT  := [$SIZE(0)];
+    setpoint : ARRAY [1..$SIZE] OF REAL := [10(1.5), $((SIZE-20))(20.0), 10(1.5)];
+    steps    : ARRAY [1..$SIZE] OF DINT := [1, 2, 3, 4, $((SIZE-4))(-1)];
+    flags    : ARRAY [1..$SIZE] OF BOOL;
+  END_VAR
+  flags[1] := zeros[1] = 0;
+END_PROGRAM
+
+CONFIGURATION config
+  RESOURCE resource1 ON PLC
+    TASK task0(INTERVAL := T#100ms, PRIORITY := 0);
+    PROGRAM instance0 WITH task0 : recipes;
+  END_RESOURCE
+END_CONFIGURATION
+END
+
+$IEC2C -I $LIBDIR -T $OUTDIR $OUTDIR/recipes.st > /dev/null || exit 1
+start=`date +%s.%N`
+$CC -I $LIBDIR -c $OUTDIR/POUS.c -o $OUTDIR/POUS.o -O2 || exit 1
+end=`date +%s.%N`
+
+printf "%-20s %12s\n" "POUS.c (bytes)" `wc -c < $OUTDIR/POUS.c`
+printf "%-20s %12s\n" "POUS.o .text+.data" `size $OUTDIR/POUS.o | tail -1 | awk '{print $1+$2}'`
+printf "%-20s %12.2f\n" "gcc time (s)" `echo "$end - $start" | bc -l`
@@ -0,0 +1,67 @@
+#!/bin/bash
+# Checks the build cache (-C option): a project whose POU bodies contain code
+# generation pragmas is compiled without the cache, then with an empty cache (every
+# POU is compiled and stored), and twice more once the cache is filled (every POU is
+# re-used). POUS.c and POUS.h must be the same in all cases.
+#
+# usage: ./build_cache.sh
+
+. ./common.sh build_cache
+ST=$OUTDIR/build_cache.st
+{
+  echo "FUNCTION il_twice : DINT"
+  echo "  VAR_INPUT x : DINT; END_VAR"
+  echo "  LD x"
+  echo "  {disable code generation} ADD 1000"
+  echo "  {enable code generation} MUL 2"
+  echo "  ST il_twice"
+  echo "END_FUNCTION"
+  echo "FUNCTION_BLOCK scaled"
+  echo "  VAR_INPUT x : DINT; END_VAR"
+  echo "  VAR_OUTPUT y : DINT; END_VAR"
+  echo "  y := x * 2;"
+  echo "  {disable code generation}"
+  echo "  y := 0;"
+  echo "  {enable code generation}"
+  echo "  y := y + il_twice(x);"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR s : scaled; total : DINT; END_VAR"
+  echo "  s(x := 3);"
+  echo "  total := total + s.y;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+CACHE=$OUTDIR/cache
+rm -rf $CACHE; mkdir -p $CACHE $OUTDIR/nocache
+$IEC2C -I $LIBDIR -T $OUTDIR/nocache $ST > $OUTDIR/nocache.log 2>&1 || { echo "compilation failed (see $OUTDIR/nocache.log)"; exit 1; }
+
+FAILED=0
+for RUN in cold warm warm_again; do
+  mkdir -p $OUTDIR/$RUN
+  if ! $IEC2C -I $LIBDIR -T $OUTDIR/$RUN -C $CACHE $ST > $OUTDIR/$RUN.log 2>&1; then
+    echo "$RUN: compilation failed (see $OUTDIR/$RUN.log)"
+    FAILED=$((FAILED + 1))
+    continue
+  fi
+  for F in POUS.c POUS.h; do
+    cmp -s $OUTDIR/nocache/$F $OUTDIR/$RUN/$F || { echo "$RUN: $F differs (diff $OUTDIR/nocache/$F $OUTDIR/$RUN/$F)"; FAILED=$((FAILED + 1)); }
+  done
+  STATS=`grep 'Build cache' $OUTDIR/$RUN.log`
+  echo "$RUN: $STATS"
+  if [ $RUN != cold ] && ! echo "$STATS" | grep -q ' 0 POU(s) compiled'; then
+    echo "$RUN: the cached POUs were not re-used"
+    FAILED=$((FAILED + 1))
+  fi
+done
+
+if [ $FAILED -gt 0 ]; then
+  echo "$FAILED check(s) failed"
+  exit 1
+fi
@@ -0,0 +1,53 @@
+#!/bin/bash
+# Checks that the code generator options that change the generated C code do not
+# change what the programs do.
+#
+# Each codegen_checks/NAME.st is compiled twice, without any code generator option
+# and with the options given on its first line, e.g.
+#   (* options: -O init-image *)
+# (the options that are on by default are turned off instead, e.g. -O no-typed-expt)
+# and both versions are run by the simulation runtime (../sim.c), with the arguments
+# given on its second line, e.g.
+#   (* sim: -t 20ms *)
+# and with the input script codegen_checks/NAME.in, if there is one. The outputs
+# recorded by both runs must be those of codegen_checks/NAME.expected.
+#
+# usage: ./codegen_check.sh [NAME ...]
+
+CHECKS=${*:-`ls codegen_checks/*.st | sed 's,.*/\(.*\)\.st$,\1,'`}
+
+. ./common.sh codegen_check
+
+# run NAME DIR [IEC2C_OPTIONS]
+# compiles and runs codegen_checks/NAME.st in DIR; the outputs are recorded in DIR/outputs
+run() {
+  local name=$1 dir=$2
+  shift 2
+  rm -rf $dir; mkdir -p $dir
+  $IEC2C -I $LIBDIR -T $dir $* codegen_checks/$name.st > $dir/iec2c.log 2>&1 || { echo "compilation failed (see $dir/iec2c.log)"; return 1; }
+  $CC $CFLAGS -I $LIBDIR -I $dir -o $dir/sim ../sim.c $dir/config.c $dir/resource1.c -lrt -lm > $dir/cc.log 2>&1 \
+    || { echo "C compilation failed (see $dir/cc.log)"; return 1; }
+  $dir/sim $SIM_ARGS -o $dir/outputs 2> $dir/sim.log || { echo "simulation failed (see $dir/sim.log)"; return 1; }
+  cmp -s $dir/outputs codegen_checks/$name.expected || { echo "wrong outputs (diff $dir/outputs codegen_checks/$name.expected)"; return 1; }
+  echo "ok"
+}
+
+FAILED=0
+for NAME in $CHECKS; do
+  ST=codegen_checks/$NAME.st
+  OPTIONS=`sed -n '1s/^(\* options: \(.*\) \*)$/\1/p' $ST`
+  SIM_ARGS=`sed -n '2s/^(\* sim: \(.*\) \*)$/\1/p' $ST`
+  if [ -f codegen_checks/$NAME.in ]; then SIM_ARGS="$SIM_ARGS -s codegen_checks/$NAME.in"; fi
+
+  RESULT=`run $NAME $OUTDIR/$NAME.default`
+  [ "$RESULT" = "ok" ] || FAILED=$((FAILED + 1))
+  printf "%-20s %-36s %s\n" $NAME "(no option)" "$RESULT"
+  RESULT=`run $NAME $OUTDIR/$NAME.options $OPTIONS`
+  [ "$RESULT" = "ok" ] || FAILED=$((FAILED + 1))
+  printf "%-20s %-36s %s\n" $NAME "$OPTIONS" "$RESULT"
+done
+
+if [ $FAILED -gt 0 ]; then
+  echo "$FAILED run(s) failed"
+  exit 1
+fi
@@ -0,0 +1,44 @@
+#!/bin/bash
+# Measures the cold start time (config_init__()) of a configuration with
+# many FB instances, with and without the 'init-image' code generator option.
+#
+# usage: ./cold_start.sh [NUMBER_OF_FB_INSTANCES]
+
+INSTANCES=${1:-2000}
+
+. ./common.sh cold_start
+ST=$OUTDIR/cold_start.st
+{
+  echo "FUNCTION_BLOCK motor"
+  echo "  VAR_INPUT start, stop : BOOL; setpoint : REAL := 1500.0; END_VAR"
+  echo "  VAR_OUTPUT running : BOOL; speed : REAL; END_VAR"
+  echo "  VAR ramp : ARRAY [1..16] OF REAL := [1.0, 2.0, 4.0, 8.0, 12(16.0)];"
+  echo "      name : STRING := 'motor'; t_on : TON; t_off : TOF; count : DINT := 100; END_VAR"
+  echo "  VAR_EXTERNAL enable : BOOL; END_VAR"
+  echo "  t_on(IN := start AND enable, PT := T#2s); t_off(IN := NOT stop, PT := T#1s);"
+  echo "  running := t_on.Q AND t_off.Q;"
+  echo "  IF running THEN speed := setpoint; ELSE speed := 0.0; END_IF;"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  for i in `seq $INSTANCES`; do echo "    m$i : motor;"; done
+  echo "  END_VAR"
+  echo "  m1(start := TRUE);"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  VAR_GLOBAL enable : BOOL := TRUE; END_VAR"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+printf "%-16s %12s %12s\n" "" "first (us)" "next (us)"
+for opt in no-init-image init-image; do
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O $opt $ST > /dev/null || exit 1
+  $CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/cold_start \
+      cold_start_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+  printf "%-16s %s\n" $opt "`$OUTDIR/cold_start`"
+done
@@ -0,0 +1,72 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Measures the time config_init__() takes (i.e. the cold start of the PLC).
+ * See cold_start.sh
+ *
+ * usage: cold_start [REPEAT]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "iec_std_lib.h"
+
+void config_init__(void);
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+int main(int argc, char **argv) {
+  int repeat = (argc > 1)? atoi(argv[1]) : 100;
+  int i;
+  double start, first, all;
+
+  start = now();
+  config_init__();
+  first = now() - start;
+
+  start = now();
+  for (i = 0; i < repeat; i++)
+    config_init__();
+  all = now() - start;
+
+  printf("%12.1f %12.1f\n", first * 1e6, all * 1e6 / repeat);
+  return 0;
+}
@@ -0,0 +1,35 @@
+# matiec - a compiler for the programming languages defined in IEC 61131-3
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Settings shared by the scripts of this directory, which are all run from this
+# directory. Each script sources this file once it has read its own arguments:
+#
+#   . ./common.sh NAME
+#
+# which sets
+#   IEC2C   the compiler, in the build tree (unless set in the environment)
+#   LIBDIR  the headers of the standard library, in the source tree
+#   CC      the C compiler (default: gcc)
+#   CFLAGS  its flags (default: -O2)
+#   OUTDIR  the directory for the files of the script (NAME.out), created if needed
+# The defaults of CC and CFLAGS only apply if they are not set by then.
+
+IEC2C=${IEC2C:-../../iec2c}
+LIBDIR=../../lib
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--O2}
+OUTDIR=$1.out
+
+mkdir -p $OUTDIR
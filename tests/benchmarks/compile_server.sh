@@ -0,0 +1,43 @@
+#!/bin/bash
+# Measures the throughput (compiles/second) of the compile server (iec2c -S),
+# compared to starting a new iec2c process for each compilation.
+#
+# Every example in the AnnexF directory is compiled REPEAT times with
+# each method.
+#
+# usage: ./compile_server.sh [REPEAT]
+
+REPEAT=${1:-10}
+
+. ./common.sh compile_server
+LIBDIR=`cd $LIBDIR; pwd`
+SRCDIR=`cd ../../AnnexF; pwd`
+OUTDIR=`cd $OUTDIR; pwd`
+SOCKET=$OUTDIR/iec2c.sock
+
+$CC -O2 -o $OUTDIR/client compile_server_client.c || exit 1
+
+# run_all <command prefix>
+# prints the number of compilations per second
+run_all() {
+  local count=0
+  local start=`date +%s.%N`
+  for r in `seq $REPEAT`; do
+    for src in $SRCDIR/*.txt; do
+      $* -T $OUTDIR $src > /dev/null 2>&1
+      count=$((count+1))
+    done
+  done
+  local end=`date +%s.%N`
+  echo "$count / ($end - $start)" | bc -l | xargs printf "%.1f"
+}
+
+printf "%-30s %10s\n" "method" "compiles/s"
+printf "%-30s %10s\n" "one iec2c process per file" `run_all $IEC2C -I $LIBDIR`
+
+$IEC2C -I $LIBDIR -S $SOCKET > /dev/null &
+SERVER=$!
+while [ ! -S $SOCKET ]; do sleep 0.1; done
+printf "%-30s %10s\n" "compile server" `run_all $OUTDIR/client $SOCKET`
+kill $SERVER
+rm -f $SOCKET
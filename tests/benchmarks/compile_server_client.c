@@ -0,0 +1,83 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * A minimal client of the iec2c compile server (iec2c -S <socket_path>).
+ *
+ * usage: compile_server_client <socket_path> [-T <target_directory>] [-O <options>] [-C <cache_directory>] <input_file>
+ *
+ * Sends the request, copies the reply to stdout, and exits with the
+ * exit status of the compilation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../../compile_server.hh"
+
+
+int main(int argc, char **argv) {
+  struct sockaddr_un addr;
+  char reply[65536];
+  size_t len = 0;
+  ssize_t res;
+  int i, fd;
+  char *status;
+
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <socket_path> [iec2c options] <input_file>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, argv[1], sizeof(addr.sun_path) - 1);
+  if ((fd < 0) || (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)) {
+    perror(argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  for (i = 2; i < argc; i++) {
+    if (write(fd, argv[i], strlen(argv[i])) < 0) return EXIT_FAILURE;
+    if (write(fd, (i < argc - 1)? "\t" : "\n", 1) < 0) return EXIT_FAILURE;
+  }
+
+  while ((len < sizeof(reply) - 1) && ((res = read(fd, reply + len, sizeof(reply) - 1 - len)) > 0))
+    len += res;
+  reply[len] = '\0';
+  close(fd);
+
+  status = strstr(reply, "\n" COMPILE_SERVER_STATUS_LINE);
+  if (status == NULL) {
+    fputs(reply, stdout);
+    return EXIT_FAILURE;
+  }
+  *status = '\0';
+  fputs(reply, stdout);
+  return atoi(status + 1 + strlen(COMPILE_SERVER_STATUS_LINE));
+}
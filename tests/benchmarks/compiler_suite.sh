@@ -0,0 +1,78 @@
+#!/bin/bash
+# Benchmark suite of the compiler.
+#
+# Generates synthetic projects with gen_project.sh, each stressing one aspect of
+# the compiler (many POUs, many variables, deeply nested structures, large arrays,
+# large CASE statements, long IL jump chains, large SFCs), and compiles each of them
+# REPEAT times with 'iec2c --time-report=json'. Prints the CPU time of each phase
+# of the compiler (the best of the REPEAT runs) and compares it with the baseline
+# saved by a previous run with -s. Phases that got slower by more than THRESHOLD %
+# (and by more than 1 ms) are reported as regressions, and make the exit status 1.
+#
+# usage: ./compiler_suite.sh [-s] [REPEAT] [THRESHOLD]
+#   -s : save the results as the new baseline (compiler_suite.baseline)
+
+SAVE=no
+if [ "$1" = "-s" ]; then SAVE=yes; shift; fi
+REPEAT=${1:-3}
+THRESHOLD=${2:-10}
+
+. ./common.sh compiler_suite
+BASELINE=compiler_suite.baseline
+RESULTS=$OUTDIR/results
+
+#          name          POUS  VARS  DEPTH ARRAY_SIZE CASES JUMPS STEPS
+PROJECTS="small          10    20    4     100        50    50    10
+          many_pous      200   20    4     100        50    50    10
+          many_vars      10    1000  4     100        50    50    10
+          deep_structs   10    20    40    100        50    50    10
+          big_arrays     10    20    4     100000     50    50    10
+          big_case       10    20    4     100        5000  50    10
+          il_jumps       10    20    4     100        50    5000  10
+          sfc_steps      10    20    4     100        50    50    500"
+rm -f $RESULTS.all
+echo "$PROJECTS" | while read NAME ARGS; do
+  SRC=$OUTDIR/$NAME.st
+  ./gen_project.sh $SRC $ARGS || exit 1
+  mkdir -p $OUTDIR/$NAME
+  for r in `seq $REPEAT`; do
+    if ! $IEC2C -I $LIBDIR -T $OUTDIR/$NAME --time-report=json $SRC > /dev/null 2> $OUTDIR/$NAME.log; then
+      echo "$NAME: compilation failed (see $OUTDIR/$NAME.log)"
+      exit 1
+    fi
+    # one phase per line: {"name": "stage3", "depth": 0, "wall_s": 0.1, "cpu_s": 0.1, ...}
+    sed -n 's/.*"name": "\([^"]*\)", "depth": \([0-9]*\), "wall_s": [0-9.]*, "cpu_s": \([0-9.]*\).*/\1 \2 \3/p' $OUTDIR/$NAME.log |
+      while read PHASE DEPTH CPU; do echo "$NAME $PHASE $DEPTH $CPU"; done >> $RESULTS.all
+  done
+done || exit 1
+
+# the best of the runs, in ms, in the order the phases were run
+awk '{key = $1 " " $2 " " $3; ms = $4 * 1000;
+      if (!(key in best)) {order[n++] = key; best[key] = ms}
+      else if (ms < best[key]) best[key] = ms}
+     END {for (i = 0; i < n; i++) printf "%s %.3f\n", order[i], best[order[i]]}' $RESULTS.all > $RESULTS
+
+if [ $SAVE = yes ]; then
+  cp $RESULTS $BASELINE
+  echo "baseline saved in $BASELINE"
+fi
+
+touch $BASELINE
+printf "%-14s %-36s %10s %10s %9s\n" "project" "phase" "cpu (ms)" "baseline" "change"
+awk -v threshold=$THRESHOLD '
+  FILENAME == ARGV[1] {baseline[$1 " " $2] = $4; next}
+  {
+    key = $1 " " $2
+    name = sprintf("%*s%s", 2 * $3, "", $2)
+    if (!(key in baseline)) {
+      printf "%-14s %-36s %10.3f %10s\n", $1, name, $4, "-"
+      next
+    }
+    change = (baseline[key] > 0)? 100 * ($4 - baseline[key]) / baseline[key] : 0
+    flag = ""
+    if (change > threshold && $4 - baseline[key] > 1) {flag = "  REGRESSION"; regressions++}
+    printf "%-14s %-36s %10.3f %10.3f %+8.1f%%%s\n", $1, name, $4, baseline[key], change, flag
+  }
+  END {
+    if (regressions > 0) {printf "\n%d phase(s) slower than the baseline by more than %s%%\n", regressions, threshold; exit 1}
+  }' $BASELINE $RESULTS
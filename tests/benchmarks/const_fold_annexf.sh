@@ -0,0 +1,31 @@
+#!/bin/bash
+# Measures the effect of constant folding/propagation on the generated C code.
+#
+# Each example in the AnnexF directory is compiled twice, with and without
+# the 'no-const-fold' code generator option. For each version we report the
+# size of the generated POUS.c, and the size of the code (text segment) of
+# the object file produced by the C compiler.
+#
+# usage: ./const_fold_annexf.sh [CFLAGS]
+
+CFLAGS=${*:--O2}
+
+. ./common.sh const_fold_annexf
+SRCDIR=../../AnnexF
+
+# compile <source file> <output dir> [iec2c options]
+# prints "<size of POUS.c> <size of text segment>"
+compile() {
+  rm -rf $2; mkdir -p $2
+  $IEC2C -I $LIBDIR -T $2 $3 $1 > /dev/null 2>&1 || { echo "- -"; return; }
+  $CC -I $LIBDIR -c $2/POUS.c -o $2/POUS.o $CFLAGS > /dev/null 2>&1 || { echo "`wc -c < $2/POUS.c` -"; return; }
+  echo "`wc -c < $2/POUS.c` `size $2/POUS.o | tail -1 | awk '{print $1}'`"
+}
+
+printf "%-22s %10s %10s   %10s %10s\n" "" "POUS.c" "" ".text" ""
+printf "%-22s %10s %10s   %10s %10s\n" "file" "no-fold" "fold" "no-fold" "fold"
+for src in $SRCDIR/*.txt; do
+  name=`basename $src .txt`
+  set -- `compile $src $OUTDIR/$name.nofold "-O no-const-fold"` `compile $src $OUTDIR/$name.fold`
+  printf "%-22s %10s %10s   %10s %10s\n" $name $1 $3 $2 $4
+done
@@ -0,0 +1,161 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Microbenchmark of the get_datatype_info_c predicates.
+ *
+ * Compares the cost of the is_ANY_xxx() predicates, that now test the
+ * symbol_c::type_category bitmask, with that of the chains of typeid()
+ * comparisons they used to be implemented with (reproduced below).
+ * Use datatype_predicates.sh to build and run it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#include <typeinfo>
+
+#include "absyntax_utils/absyntax_utils.hh"
+
+
+
+void error_exit(const char *file_name, int line_no, const char *errmsg, ...) {
+  va_list argptr;
+  fprintf(stderr, "\nInternal compiler error in file %s at line %d", file_name, line_no);
+  if (errmsg != NULL) {
+    fprintf(stderr, ": ");
+    va_start(argptr, errmsg);
+    vfprintf(stderr, errmsg, argptr);
+    va_end(argptr);
+  }
+  fprintf(stderr, "\n");
+  exit(EXIT_FAILURE);
+}
+
+
+
+/* The previous implementation, based on typeid(). */
+class typeid_datatype_info_c {
+  public:
+    static bool is_ANY_signed_INT(symbol_c *type_symbol) {
+      if (type_symbol == NULL)                                     {return false;}
+      if (typeid(*type_symbol) == typeid(sint_type_name_c))        {return true;}
+      if (typeid(*type_symbol) == typeid(int_type_name_c))         {return true;}
+      if (typeid(*type_symbol) == typeid(dint_type_name_c))        {return true;}
+      if (typeid(*type_symbol) == typeid(lint_type_name_c))        {return true;}
+      return false;
+    }
+    static bool is_ANY_unsigned_INT(symbol_c *type_symbol) {
+      if (type_symbol == NULL)                                     {return false;}
+      if (typeid(*type_symbol) == typeid(usint_type_name_c))       {return true;}
+      if (typeid(*type_symbol) == typeid(uint_type_name_c))        {return true;}
+      if (typeid(*type_symbol) == typeid(udint_type_name_c))       {return true;}
+      if (typeid(*type_symbol) == typeid(ulint_type_name_c))       {return true;}
+      return false;
+    }
+    static bool is_ANY_signed_SAFEINT(symbol_c *type_symbol) {
+      if (type_symbol == NULL)                                     {return false;}
+      if (typeid(*type_symbol) == typeid(safesint_type_name_c))    {return true;}
+      if (typeid(*type_symbol) == typeid(safeint_type_name_c))     {return true;}
+      if (typeid(*type_symbol) == typeid(safedint_type_name_c))    {return true;}
+      if (typeid(*type_symbol) == typeid(safelint_type_name_c))    {return true;}
+      return false;
+    }
+    static bool is_ANY_unsigned_SAFEINT(symbol_c *type_symbol) {
+      if (type_symbol == NULL)                                     {return false;}
+      if (typeid(*type_symbol) == typeid(safeusint_type_name_c))   {return true;}
+      if (typeid(*type_symbol) == typeid(safeuint_type_name_c))    {return true;}
+      if (typeid(*type_symbol) == typeid(safeudint_type_name_c))   {return true;}
+      if (typeid(*type_symbol) == typeid(safeulint_type_name_c))   {return true;}
+      return false;
+    }
+    static bool is_ANY_REAL(symbol_c *type_symbol) {
+      if (type_symbol == NULL)                                     {return false;}
+      if (typeid(*type_symbol) == typeid(real_type_name_c))        {return true;}
+      if (typeid(*type_symbol) == typeid(lreal_type_name_c))       {return true;}
+      return false;
+    }
+    static bool is_ANY_SAFEREAL(symbol_c *type_symbol) {
+      if (type_symbol == NULL)                                     {return false;}
+      if (typeid(*type_symbol) == typeid(safereal_type_name_c))    {return true;}
+      if (typeid(*type_symbol) == typeid(safelreal_type_name_c))   {return true;}
+      return false;
+    }
+    static bool is_ANY_INT(symbol_c *type_symbol) {
+      return is_ANY_signed_INT(type_symbol) || is_ANY_unsigned_INT(type_symbol);
+    }
+    static bool is_ANY_SAFEINT(symbol_c *type_symbol) {
+      return is_ANY_signed_SAFEINT(type_symbol) || is_ANY_unsigned_SAFEINT(type_symbol);
+    }
+    static bool is_ANY_INT_compatible(symbol_c *type_symbol) {
+      return is_ANY_INT(type_symbol) || is_ANY_SAFEINT(type_symbol);
+    }
+    static bool is_ANY_NUM_compatible(symbol_c *type_symbol) {
+      return is_ANY_REAL(type_symbol) || is_ANY_INT(type_symbol) || is_ANY_SAFEREAL(type_symbol) || is_ANY_SAFEINT(type_symbol);
+    }
+};
+
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+#define BENCH(label, predicate)                                                    \
+  {                                                                                \
+    int count = 0;                                                                 \
+    double start = now();                                                          \
+    for (int r = 0; r < repeat; r++)                                               \
+      for (int i = 0; i < n; i++)                                                  \
+        count += predicate(types[i]);                                              \
+    double elapsed = now() - start;                                                \
+    printf("%-50s %8.2f ns/call  (%d)\n", label, elapsed * 1e9 / ((double)repeat * n), count); \
+  }
+
+
+int main(int argc, char **argv) {
+  int repeat = (argc > 1)? atoi(argv[1]) : 2000000;
+
+  /* a mix of the data types found in typical code, plus some derived data types */
+  symbol_c *types[] = {
+    &get_datatype_info_c::bool_type_name,  &get_datatype_info_c::int_type_name,   &get_datatype_info_c::dint_type_name,
+    &get_datatype_info_c::real_type_name,  &get_datatype_info_c::lreal_type_name, &get_datatype_info_c::time_type_name,
+    &get_datatype_info_c::word_type_name,  &get_datatype_info_c::udint_type_name, &get_datatype_info_c::string_type_name,
+    &get_datatype_info_c::safeint_type_name, &get_datatype_info_c::safelreal_type_name, &get_datatype_info_c::dt_type_name,
+    new structure_type_declaration_c(NULL, NULL), new array_specification_c(NULL, NULL), new identifier_c("MY_FB"),
+    &get_datatype_info_c::invalid_type_name,
+  };
+  int n = sizeof(types) / sizeof(types[0]);
+
+  BENCH("typeid:        is_ANY_INT",            typeid_datatype_info_c::is_ANY_INT);
+  BENCH("type_category: is_ANY_INT",            get_datatype_info_c::is_ANY_INT);
+  BENCH("typeid:        is_ANY_INT_compatible", typeid_datatype_info_c::is_ANY_INT_compatible);
+  BENCH("type_category: is_ANY_INT_compatible", get_datatype_info_c::is_ANY_INT_compatible);
+  BENCH("typeid:        is_ANY_NUM_compatible", typeid_datatype_info_c::is_ANY_NUM_compatible);
+  BENCH("type_category: is_ANY_NUM_compatible", get_datatype_info_c::is_ANY_NUM_compatible);
+  return 0;
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+# Microbenchmark of the data type predicates of get_datatype_info_c
+# (typeid() chains vs. type category bitmask). See datatype_predicates.cc
+#
+# Must be run after configure, as it requires config/config.h
+#
+# usage: ./datatype_predicates.sh [REPEAT]
+
+. ./common.sh datatype_predicates
+TOPDIR=../..
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2}
+
+$CXX $CXXFLAGS -w -I$TOPDIR -I$TOPDIR/absyntax -include $TOPDIR/config/config.h \
+     -o $OUTDIR/datatype_predicates datatype_predicates.cc \
+     $TOPDIR/absyntax/absyntax.cc $TOPDIR/absyntax/visitor.cc $TOPDIR/absyntax_utils/*.cc || exit 1
+$OUTDIR/datatype_predicates $1
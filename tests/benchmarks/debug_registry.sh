@@ -0,0 +1,43 @@
+#!/bin/bash
+# Measures the cost of tracing the variables through the registry generated with
+# the 'debug-registry' code generator option (VARIABLES.c, see lib/iec_debug.h):
+# every value of a program with TAGS REAL variables, an ARRAY [1..TAGS] OF REAL and
+# an array of structures is copied to the trace ring buffer once per cycle.
+# (uses debug_registry_main.c, which also checks the traced values)
+#
+# usage: ./debug_registry.sh [TAGS] [NUMBER_OF_CYCLES]
+
+TAGS=${1:-1000}
+CYCLES=${2:-10000}
+
+. ./common.sh debug_registry
+ST=$OUTDIR/debug_registry.st
+{
+  echo "TYPE point : STRUCT x : REAL; y : REAL; ok : BOOL; END_STRUCT; END_TYPE"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  for i in `seq $TAGS`; do echo "    t$i : REAL;"; done
+  echo "    buffer : ARRAY [1..$TAGS] OF REAL;"
+  echo "    points : ARRAY [1..10] OF point;"
+  echo "    i : INT;"
+  echo "  END_VAR"
+  for i in `seq $TAGS`; do echo "  t$i := t$i + 1.0;"; done
+  echo "  FOR i := 1 TO $TAGS DO buffer[i] := buffer[i] + 0.5; END_FOR;"
+  echo "  FOR i := 1 TO 10 DO points[i].x := points[i].x + 1.0; points[i].ok := NOT points[i].ok; END_FOR;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  VAR_GLOBAL cycles : DINT; END_VAR"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+rm -f $OUTDIR/*.c $OUTDIR/*.h
+$IEC2C -I $LIBDIR -T $OUTDIR -O debug-registry $ST > /dev/null || exit 1
+$CC $CFLAGS -D__IEC_TRACE_MAX_VARS=$((3 * TAGS + 100)) -D__IEC_TRACE_BUFFER_SIZE=$((1 << 20)) \
+    -I $LIBDIR -I $OUTDIR -o $OUTDIR/debug_registry \
+    debug_registry_main.c $OUTDIR/config.c $OUTDIR/resource1.c $OUTDIR/VARIABLES.c -lrt || exit 1
+printf "%10s %10s %14s %14s %14s %8s\n" "entries" "traced" "cycle (us)" "traced (us)" "sample (us)" "errors"
+$OUTDIR/debug_registry $CYCLES
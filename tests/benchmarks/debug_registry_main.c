@@ -0,0 +1,127 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Traces every value of the registry generated with 'iec2c -O debug-registry'
+ * (VARIABLES.c, see lib/iec_debug.h), and prints the time config_run__() takes
+ * without and with the tracing, and the time __IEC_trace_sample() takes.
+ * The trace is read after each cycle, so no sample is dropped. The values read are
+ * checked against the variables.
+ *
+ * usage: debug_registry [CYCLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "iec_std_lib.h"
+#include "accessor.h"
+#include "POUS.h"
+#include "iec_debug.h"
+
+void config_init__(void);
+void config_run__(unsigned long tick);
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+
+static __IEC_trace_t trace;
+static unsigned char sample[__IEC_TRACE_BUFFER_SIZE / 2];
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+int main(int argc, char **argv) {
+  int cycles = (argc > 1)? atoi(argv[1]) : 10000;
+  unsigned long tick;
+  unsigned int i, element, values, errors = 0;
+  int full = 0;
+  double start, plain, traced, sampling = 0;
+
+  config_init__();
+  /* warm up the caches */
+  for (tick = 0; tick < 100; tick++)
+    config_run__(tick);
+
+  start = now();
+  for (tick = 0; tick < (unsigned long)cycles; tick++)
+    config_run__(tick);
+  plain = (now() - start) * 1e6 / cycles;
+
+  /* trace every value, as long as there is room for them */
+  __IEC_trace_clear(&trace);
+  for (i = 0; i < __IEC_debug_vars_count && !full; i++)
+    for (element = 0; element < __IEC_debug_vars[i].count && !full; element++)
+      full = !__IEC_trace_add(&trace, i, element);
+  values = trace.count;
+  __IEC_trace_start(&trace);
+
+  start = now();
+  for (tick = 0; tick < (unsigned long)cycles; tick++) {
+    double s;
+    config_run__(tick);
+    s = now();
+    __IEC_trace_sample(&trace, tick);
+    sampling += now() - s;
+    if (__IEC_trace_read(&trace, sample, 1) != 1 || memcmp(sample, &tick, sizeof(tick)) != 0)
+      errors++;
+  }
+  traced = (now() - start) * 1e6 / cycles;
+
+  /* the traced variables may not change until the PLC task has seen the tracing stopped */
+  __IEC_trace_stop(&trace);
+  if (__IEC_trace_add(&trace, 0, 0) || __IEC_trace_clear(&trace))
+    errors++;
+  __IEC_trace_sample(&trace, tick);
+  if (!__IEC_trace_clear(&trace))
+    errors++;
+
+  /* the last sample holds the current values */
+  {
+    unsigned int offset = sizeof(unsigned long), n = 0;
+    for (i = 0; i < __IEC_debug_vars_count; i++)
+      for (element = 0; element < __IEC_debug_vars[i].count && n < values; element++, n++) {
+        if (memcmp(sample + offset, __IEC_debug_var_ptr(&__IEC_debug_vars[i], element), __IEC_debug_vars[i].size) != 0)
+          errors++;
+        offset += __IEC_debug_vars[i].size;
+      }
+  }
+
+  printf("%10u %10u %14.2f %14.2f %14.3f %8u\n", __IEC_debug_vars_count, values, plain, traced,
+         sampling * 1e6 / cycles, errors + trace.dropped);
+  return (errors + trace.dropped != 0);
+}
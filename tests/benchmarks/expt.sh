@@ -0,0 +1,50 @@
+#!/bin/bash
+# Checks the results of the functions computing EXPT and the ** operator against
+# pow() (expt_check.c), and measures the scan time of code using ** with and without
+# the computation in the data type of the result ('typed-expt' code generator option).
+# (uses soa_layout_main.c, which prints the size of the PID FB and times config_run__())
+#
+# usage: ./expt.sh [NUMBER_OF_FB_INSTANCES] [NUMBER_OF_CYCLES]
+
+INSTANCES=${1:-100}
+CYCLES=${2:-10000}
+
+. ./common.sh expt
+$CC $CFLAGS -I $LIBDIR -o $OUTDIR/expt_check expt_check.c -lm || exit 1
+$OUTDIR/expt_check || exit 1
+
+ST=$OUTDIR/expt.st
+{
+  echo "FUNCTION_BLOCK pid"
+  echo "  VAR_INPUT dp, t : REAL; order : INT; END_VAR"
+  echo "  VAR_OUTPUT flow, lin : REAL; poly : LREAL; END_VAR"
+  echo "  VAR c : ARRAY [0..4] OF REAL := [1.0, 0.5, 0.25, 0.125, 0.0625]; x : LREAL; END_VAR"
+  echo "  flow := 0.61 * dp ** 0.5 * (1.0 + 0.002 * t ** 2);"
+  echo "  lin := c[0] + c[1] * t + c[2] * t ** 2 + c[3] * t ** 3 + c[4] * t ** 4;"
+  echo "  x := REAL_TO_LREAL(t) / 100.0;"
+  echo "  poly := x ** order + x ** 2.0 - x ** -1;"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  echo "    t : REAL; total : REAL;"
+  for i in `seq $INSTANCES`; do echo "    f$i : pid;"; done
+  echo "  END_VAR"
+  echo "  t := t + 0.01;"
+  for i in `seq $INSTANCES`; do echo "  f$i(dp := 2.5, t := t, order := 5); total := total + f$i.flow;"; done
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+printf "%-20s %14s %14s\n" "" "instance (B)" "cycle (us)"
+for opt in no-typed-expt typed-expt; do
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O $opt $ST > /dev/null || exit 1
+  $CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/expt \
+      soa_layout_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt -lm || exit 1
+  printf "%-20s %s\n" $opt "`$OUTDIR/expt $CYCLES`"
+done
@@ -0,0 +1,94 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Checks the results of the functions used for EXPT and the ** operator
+ * (__expt_<type>(), __expt_int_<type>() and __expt_uint_<type>() in iec_std_lib.h) against pow().
+ * See expt.sh.
+ *
+ * usage: expt_check
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include "iec_std_lib.h"
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+static int failures = 0;
+
+/* relative error allowed for x ** n computed with about log2(n) roundings, in units of epsilon */
+static double allowed(LINT n) {
+  double ulps = 2;
+  for (n = (n < 0)? -n : n; n > 1; n >>= 1) ulps += 2;
+  return ulps;
+}
+
+/* Results in the subnormal range (below min_normal) are only checked to be that small,
+ * as x ** -n is computed as 1 / (x ** n), and x ** n may overflow.
+ */
+static void check(const char *what, double base, double exponent, double result, double expected, double tolerance, double min_normal) {
+  if (isnan(expected) && isnan(result)) return;
+  if (isinf(expected) && (result == expected)) return;
+  if (result == expected) return;
+  if (fabs(result - expected) <= tolerance * fabs(expected)) return;
+  if ((fabs(expected) < min_normal) && (fabs(result) < min_normal)) return;
+  printf("%s: %g ** %g = %.17g, expected %.17g\n", what, base, exponent, result, expected);
+  failures++;
+}
+
+int main(void) {
+  static const double bases[] = {0.0, -0.0, 0.5, -0.5, 1.0, -1.0, 1.5, -1.5, 2.0, -2.0, 3.0, 10.0, -10.0, 1e-3, 123.456, 1e10};
+  static const double real_exponents[] = {0.0, 0.5, -0.5, 1.0, 1.5, 2.0, -2.0, 2.5, 3.0, 1.0 / 3, 10.0, -10.0};
+  unsigned int i, j;
+  LINT n;
+
+  for (i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+    for (n = -12; n <= 12; n++) {
+      check("__expt_int_LREAL", bases[i], n, __expt_int_LREAL(bases[i], n), pow(bases[i], n), allowed(n) * DBL_EPSILON, DBL_MIN);
+      check("__expt_int_REAL",  bases[i], n, __expt_int_REAL((REAL)bases[i], n), (REAL)pow((REAL)bases[i], n), allowed(n) * FLT_EPSILON, FLT_MIN);
+      /* EXPT() calls pow() */
+      check("EXPT__LREAL__LREAL__SINT", bases[i], n, EXPT__LREAL__LREAL__SINT(__BOOL_LITERAL(TRUE), NULL, bases[i], (SINT)n), pow(bases[i], n), 0, DBL_MIN);
+    }
+    for (j = 0; j < sizeof(real_exponents) / sizeof(real_exponents[0]); j++) {
+      double e = real_exponents[j];
+      check("__expt_LREAL", bases[i], e, __expt_LREAL(bases[i], e), pow(bases[i], e), 0, DBL_MIN);
+      check("__expt_REAL",  bases[i], e, __expt_REAL((REAL)bases[i], (REAL)e), (REAL)pow((REAL)bases[i], (REAL)e), 2 * FLT_EPSILON, FLT_MIN);
+      check("EXPT__REAL__REAL__LREAL", bases[i], e, EXPT__REAL__REAL__LREAL(__BOOL_LITERAL(TRUE), NULL, (REAL)bases[i], e), (REAL)pow((REAL)bases[i], e), 0, FLT_MIN);
+    }
+  }
+  /* a few exact results */
+  check("__expt_int_LREAL", 0.0,  0, __expt_int_LREAL(0.0, 0), 1.0, 0, DBL_MIN);
+  check("__expt_int_LREAL", -2.0, 3, __expt_int_LREAL(-2.0, 3), -8.0, 0, DBL_MIN);
+  check("__expt_int_LREAL", 2.0, 62, __expt_int_LREAL(2.0, 62), 4611686018427387904.0, 0, DBL_MIN);
+  check("__expt_int_REAL",  2.0, -3, __expt_int_REAL(2.0f, -3), 0.125, 0, FLT_MIN);
+  /* the unsigned exponents above the largest LINT */
+  check("__expt_uint_LREAL", -1.0, 9223372036854775809.0, __expt_uint_LREAL(-1.0, 9223372036854775809ULL), -1.0, 0, DBL_MIN);
+  check("__expt_uint_LREAL", -1.0, 18446744073709551615.0, __expt_uint_LREAL(-1.0, 18446744073709551615ULL), -1.0, 0, DBL_MIN);
+  check("__expt_uint_REAL",  0.5, 9223372036854775808.0, __expt_uint_REAL(0.5f, 9223372036854775808ULL), 0.0, 0, FLT_MIN);
+
+  printf("%d failures\n", failures);
+  return (failures == 0)? 0 : 1;
+}
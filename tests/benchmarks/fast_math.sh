@@ -0,0 +1,18 @@
+#!/bin/bash
+# Accuracy and throughput of the math functions used by the REAL versions of the
+# standard functions of one numeric variable (SQRT, LN, EXP, SIN, ...): the double
+# precision libm functions, the single precision ones (the default), and the
+# approximations of iec_fast_math.h (used when compiling with -D__IEC_FAST_MATH).
+# Fails if an error is above the bound documented in iec_fast_math.h.
+# Run once with the usual CFLAGS, and once with the flags that let gcc vectorise.
+#
+# usage: ./fast_math.sh [SAMPLES]
+
+SAMPLES=${1:-1000000}
+
+. ./common.sh fast_math
+for flags in "$CFLAGS" "-O3 -fno-math-errno -fno-trapping-math"; do
+  echo "CFLAGS = $flags"
+  $CC $flags -I $LIBDIR -o $OUTDIR/fast_math_check fast_math_check.c -lm -lrt || exit 1
+  $OUTDIR/fast_math_check $SAMPLES || exit 1
+done
@@ -0,0 +1,162 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Accuracy and throughput of the math functions used by the REAL versions of
+ * SQRT, LN, LOG, EXP, SIN, COS, TAN, ASIN, ACOS and ATAN:
+ *   double   : the double precision libm function (what was used before, e.g. (REAL)sin(x))
+ *   float    : the single precision libm function (e.g. sinf(x), the default)
+ *   fast     : the approximations of iec_fast_math.h (with __IEC_FAST_MATH defined)
+ * The errors are measured against the double precision libm function, in units in the
+ * last place of the REAL result (ulp), or as an absolute error for SIN and COS. The
+ * program fails if an error is larger than the bound documented in iec_fast_math.h.
+ * See fast_math.sh.
+ *
+ * usage: fast_math_check [SAMPLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include "iec_fast_math.h"
+
+#define BATCH 4096
+
+typedef float (*float_func_t)(float);
+typedef double (*double_func_t)(double);
+
+typedef struct {
+  const char   *name;
+  double_func_t ref;
+  float_func_t  libm;
+  float_func_t  fast;
+  double      (*time)(int which, float *in, long reps);
+  float         lo, hi;    /* domain */
+  int           absolute;  /* measure the absolute error, not in ulp */
+  double        bound;     /* documented in iec_fast_math.h */
+} math_func_t;
+
+/* nanoseconds per call. The functions are called directly (not through the pointers
+ * above), so the C compiler may inline and vectorise them, as in the generated code.
+ */
+static double now(void);
+static volatile float sink;
+static float out[BATCH];
+#define __timing(NAME, REF, LIBM, FAST) \
+static double time_##NAME(int which, float *in, long reps) {\
+  double start = now();\
+  for (long r = 0; r < reps; r++) {\
+    switch (which) {\
+      case 0: for (int i = 0; i < BATCH; i++) out[i] = (float)REF(in[i]); break;\
+      case 1: for (int i = 0; i < BATCH; i++) out[i] = LIBM(in[i]);       break;\
+      case 2: for (int i = 0; i < BATCH; i++) out[i] = FAST(in[i]);       break;\
+    }\
+    sink = out[r % BATCH];\
+  }\
+  return (now() - start) * 1e9 / ((double)reps * BATCH);\
+}
+__timing(SQRT, sqrt,  sqrtf,  __fast_sqrtf)
+__timing(EXP,  exp,   expf,   __fast_expf)
+__timing(LN,   log,   logf,   __fast_logf)
+__timing(LOG,  log10, log10f, __fast_log10f)
+__timing(SIN,  sin,   sinf,   __fast_sinf)
+__timing(COS,  cos,   cosf,   __fast_cosf)
+__timing(TAN,  tan,   tanf,   __fast_tanf)
+__timing(ASIN, asin,  asinf,  __fast_asinf)
+__timing(ACOS, acos,  acosf,  __fast_acosf)
+__timing(ATAN, atan,  atanf,  __fast_atanf)
+
+static math_func_t funcs[] = {
+  {"SQRT", sqrt,  sqrtf,  __fast_sqrtf,  time_SQRT,    0.0f,  1e30f, 0, 0.5},
+  {"EXP",  exp,   expf,   __fast_expf,   time_EXP,   -87.3f,  88.7f, 0, 3},
+  {"LN",   log,   logf,   __fast_logf,   time_LN,   FLT_MIN,  1e30f, 0, 3},
+  {"LOG",  log10, log10f, __fast_log10f, time_LOG,  FLT_MIN,  1e30f, 0, 4},
+  {"SIN",  sin,   sinf,   __fast_sinf,   time_SIN,   -8192.0f, 8192.0f, 1, 1.5e-7},
+  {"COS",  cos,   cosf,   __fast_cosf,   time_COS,   -8192.0f, 8192.0f, 1, 1.5e-7},
+  {"TAN",  tan,   tanf,   __fast_tanf,   time_TAN,   -1.55f,  1.55f, 0, 4},
+  {"ASIN", asin,  asinf,  __fast_asinf,  time_ASIN,   -1.0f,   1.0f, 0, 4},
+  {"ACOS", acos,  acosf,  __fast_acosf,  time_ACOS,   -1.0f,   1.0f, 0, 4},
+  {"ATAN", atan,  atanf,  __fast_atanf,  time_ATAN,   -1e6f,   1e6f, 0, 3},
+  {NULL}
+};
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* The i-th of n samples of the domain. Domains covering several orders of
+ * magnitude are sampled logarithmically (on both signs when lo < 0).
+ */
+static float sample(const math_func_t *f, long i, long n) {
+  double t = (double)i / (n - 1);
+  if ((f->hi <= 1e3f) || (f->lo < 0 && f->lo > -1e3f))
+    return (float)(f->lo + t * ((double)f->hi - f->lo));
+  if (f->lo >= 0)
+    return (float)exp(log(f->lo > 0? f->lo : FLT_MIN) + t * (log(f->hi) - log(f->lo > 0? f->lo : FLT_MIN)));
+  /* [-hi, hi]: alternate signs */
+  return (float)((i & 1)? -1 : 1) * (float)exp(log(1e-6) + t * (log(f->hi) - log(1e-6)));
+}
+
+static double error(const math_func_t *f, float x, float res) {
+  double ref = f->ref(x);
+  if (isnan(ref) || isinf(ref))
+    return (isnan(ref) == isnan(res) && (isnan(ref) || (ref == res)))? 0 : HUGE_VAL;
+  if (f->absolute)
+    return fabs(res - ref);
+  float fref = (float)ref;
+  if (fabs(ref) < FLT_MIN) return fabs(res - ref) / ((double)FLT_MIN * FLT_EPSILON);
+  /* the ulp of the REAL result */
+  double ulp = nextafterf(fabsf(fref), HUGE_VALF) - fabsf(fref);
+  return fabs(res - ref) / ulp;
+}
+
+int main(int argc, char **argv) {
+  long samples = (argc > 1)? atol(argv[1]) : 1000000;
+  long reps = 200;
+  float in[BATCH];
+  int failures = 0;
+
+  printf("%-6s %14s %14s %8s %10s %10s %10s\n", "", "float error", "fast error", "bound", "double ns", "float ns", "fast ns");
+  for (math_func_t *f = funcs; f->name != NULL; f++) {
+    double err_libm = 0, err_fast = 0;
+    for (long i = 0; i < samples; i++) {
+      float x = sample(f, i, samples);
+      double e;
+      if ((e = error(f, x, f->libm(x))) > err_libm) err_libm = e;
+      if ((e = error(f, x, f->fast(x))) > err_fast) err_fast = e;
+    }
+    for (int i = 0; i < BATCH; i++)
+      in[i] = sample(f, (long)i * (samples / BATCH), samples);
+
+    printf("%-6s %14.3g %14.3g %8.3g %10.2f %10.2f %10.2f%s\n", f->name, err_libm, err_fast, f->bound,
+           f->time(0, in, reps), f->time(1, in, reps), f->time(2, in, reps),
+           (err_fast > f->bound)? "  <- above the bound" : "");
+    if (err_fast > f->bound) failures++;
+  }
+  return (failures == 0)? 0 : 1;
+}
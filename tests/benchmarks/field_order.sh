@@ -0,0 +1,52 @@
+#!/bin/bash
+# Compares the instance structs declared in source code order with the ones
+# declared by use and alignment ('reorder-fields' code generator option), in memory
+# used per instance and in scan cycle time.
+# The FB has interleaved BOOL/LREAL/INT variables, nested FB instances, and
+# diagnostic variables the FB never references.
+# (uses soa_layout_main.c, which prints the size of the PID FB and times config_run__())
+#
+# usage: ./field_order.sh [NUMBER_OF_FB_INSTANCES] [NUMBER_OF_CYCLES]
+
+INSTANCES=${1:-1000}
+CYCLES=${2:-10000}
+
+. ./common.sh field_order
+ST=$OUTDIR/field_order.st
+{
+  echo "FUNCTION_BLOCK pid"
+  echo "  VAR_INPUT auto : BOOL := TRUE; sp : LREAL; hold : BOOL; pv : LREAL; mode : INT; kp : LREAL := 1.5; END_VAR"
+  echo "  VAR_OUTPUT sat : BOOL; out : LREAL; alarm : BOOL; END_VAR"
+  echo "  VAR first : BOOL := TRUE; err : LREAL; cnt : SINT; prev_err : LREAL; state : INT; integ : LREAL;"
+  echo "      diag_max : LREAL; diag_flag : BOOL; diag_min : LREAL; diag_code : INT;"
+  echo "      lo : LREAL := -100.0; hi : LREAL := 100.0; edge : R_TRIG; END_VAR"
+  echo "  edge(CLK := hold);"
+  echo "  IF auto AND NOT edge.Q THEN"
+  echo "    err := sp - pv; integ := integ + 0.1 * err; prev_err := err; cnt := cnt + 1;"
+  echo "    out := kp * err + integ; first := FALSE; state := mode;"
+  echo "    sat := out > hi OR out < lo; alarm := sat AND NOT first;"
+  echo "    IF out > hi THEN out := hi; ELSIF out < lo THEN out := lo; END_IF;"
+  echo "  END_IF;"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  for i in `seq $INSTANCES`; do echo "    c$i : pid;"; done
+  echo "  END_VAR"
+  for i in `seq $INSTANCES`; do echo "  c$i(sp := 50.0, pv := c$i.out * 0.5);"; done
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+printf "%-20s %14s %14s\n" "" "instance (B)" "cycle (us)"
+for opt in no-reorder-fields reorder-fields; do
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O $opt $ST > /dev/null || exit 1
+  $CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/field_order \
+      soa_layout_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+  printf "%-20s %s\n" $opt "`$OUTDIR/field_order $CYCLES`"
+done
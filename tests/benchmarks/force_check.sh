@@ -0,0 +1,35 @@
+#!/bin/bash
+# Forces the EXTERNAL and located variables of a program (a STRING, a REAL and
+# an INT) through the forced values table of lib/iec_force.h, and checks that the
+# program reads the forced values, does not overwrite them, and gets back to the
+# original variables once they are released (see force_check_main.c).
+#
+# usage: ./force_check.sh
+
+. ./common.sh force_check
+ST=$OUTDIR/force_check.st
+{
+  echo "PROGRAM check"
+  echo "  VAR_EXTERNAL mode : STRING; pressure : REAL; END_VAR"
+  echo "  VAR"
+  echo "    level   AT %IW0   : INT;"
+  echo "    alarm   AT %QX0.0 : BOOL;"
+  echo "    doubled AT %QD0   : REAL;"
+  echo "  END_VAR"
+  echo "  doubled := pressure * 2.0;"
+  echo "  alarm := mode = 'AUTO' AND level > 100;"
+  echo "  pressure := pressure + 1.0;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  VAR_GLOBAL mode : STRING := 'AUTO'; pressure : REAL := 1.5; END_VAR"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : check;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+rm -f $OUTDIR/*.c $OUTDIR/*.h
+$IEC2C -I $LIBDIR -T $OUTDIR $ST > /dev/null || exit 1
+$CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/force_check force_check_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lm || exit 1
+$OUTDIR/force_check
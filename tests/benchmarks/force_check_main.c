@@ -0,0 +1,100 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Forces and releases the EXTERNAL and located variables of the program of
+ * force_check.sh through the forced values table (lib/iec_force.h), and checks
+ * the outputs of the scans run in between.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "iec_std_lib.h"
+#include "accessor.h"
+#include "iec_force.h"
+#include "POUS.h"
+
+void config_init__(void);
+void config_run__(unsigned long tick);
+
+TIME __CURRENT_TIME;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+extern CHECK RESOURCE1__INSTANCE0;
+
+/* the numbers of the forced variables (any unique number will do) */
+enum {PRESSURE_IDX, MODE_IDX, LEVEL_IDX};
+
+static __IEC_force_table_t force_table;
+static unsigned long tick = 0;
+static int errors = 0;
+
+static void scan(const char *step, IEC_REAL doubled, IEC_BOOL alarm) {
+  config_run__(tick++);
+  if (*__QD0 != doubled || *__QX0_0 != alarm) {
+    printf("%-36s doubled = %g (expected %g), alarm = %d (expected %d)\n",
+           step, (double)*__QD0, (double)doubled, *__QX0_0, alarm);
+    errors++;
+  }
+}
+
+int main(int argc, char **argv) {
+  IEC_REAL  pressure = 10.0;
+  IEC_INT   level = 50;
+  IEC_STRING mode = {6, "MANUAL"};
+
+  config_init__();
+  *__IW0 = 150;
+  /* pressure starts at 1.5, and the program adds 1 to it after each scan */
+  scan("not forced", 3.0, 1);
+
+  if (!__IEC_force_pointer_var(&force_table, PRESSURE_IDX, &RESOURCE1__INSTANCE0.PRESSURE, &pressure, sizeof(pressure)))
+    errors++;
+  scan("pressure forced", 20.0, 1);
+  /* the program does not write the forced variable, nor the global variable */
+  scan("pressure forced", 20.0, 1);
+  if (*(IEC_REAL *)__IEC_find_forced_var(&force_table, PRESSURE_IDX)->value != 2.5)
+    errors++;
+
+  if (!__IEC_force_pointer_var(&force_table, MODE_IDX, &RESOURCE1__INSTANCE0.MODE, &mode, sizeof(mode)) ||
+      !__IEC_force_pointer_var(&force_table, LEVEL_IDX, &RESOURCE1__INSTANCE0.LEVEL, &level, sizeof(level)))
+    errors++;
+  scan("pressure, mode and level forced", 20.0, 0);
+  __IEC_release_pointer_var(&force_table, MODE_IDX);
+  scan("pressure and level forced", 20.0, 0);
+  __IEC_release_pointer_var(&force_table, LEVEL_IDX);
+  scan("pressure forced", 20.0, 1);
+
+  __IEC_release_pointer_var(&force_table, PRESSURE_IDX);
+  scan("released", 5.0, 1);
+  scan("released", 7.0, 1);
+  if (force_table.count != 0)
+    errors++;
+
+  printf("%d error(s)\n", errors);
+  return errors > 0;
+}
@@ -0,0 +1,50 @@
+#!/bin/bash
+# Memory used by the instances of a configuration with many EXTERNAL and
+# located variables, with the forced values kept in every __IEC_<type>_p
+# struct (as was done before lib/iec_force.h) and kept in the forced values table.
+#
+# usage: ./force_table_size.sh [NUMBER_OF_FB_INSTANCES]
+
+INSTANCES=${1:-200}
+
+. ./common.sh force_table_size
+
+mkdir -p $OUTDIR/fvalue
+ST=$OUTDIR/force_table_size.st
+{
+  echo "TYPE recipe : STRUCT name : STRING; setpoint : REAL; duration : TIME; END_STRUCT; END_TYPE"
+  echo "FUNCTION_BLOCK valve"
+  echo "  VAR_INPUT open_cmd : BOOL; END_VAR"
+  echo "  VAR_OUTPUT is_open : BOOL; END_VAR"
+  echo "  VAR_EXTERNAL mode : STRING; batch : recipe; t_open : TIME; pressure : REAL; END_VAR"
+  echo "  VAR fb_open AT %IX0.0 : BOOL; out_open AT %QX0.0 : BOOL; position AT %IW0 : INT; END_VAR"
+  echo "  out_open := open_cmd AND mode = 'AUTO' AND pressure < batch.setpoint;"
+  echo "  is_open := fb_open AND position > 100;"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  for i in `seq $INSTANCES`; do echo "    v$i : valve;"; done
+  echo "  END_VAR"
+  echo "  v1(open_cmd := TRUE);"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  VAR_GLOBAL mode : STRING := 'AUTO'; batch : recipe; t_open : TIME; pressure : REAL; END_VAR"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+# the library headers, with the forced value back in every __IEC_<type>_p struct
+cp $LIBDIR/*.h $OUTDIR/fvalue
+perl -0pi -e 's/(  ((?:IEC_##)?type) \*value;\\\n  IEC_BYTE flags;\\\n)/$1  $2 fvalue;\\\n/g' $OUTDIR/fvalue/iec_types_all.h
+
+$IEC2C -I $LIBDIR -T $OUTDIR $ST > /dev/null || exit 1
+printf "%-16s %14s %14s\n" "" "VALVE (B)" "PLANT (B)"
+for headers in fvalue force-table; do
+  INCDIR=$LIBDIR
+  [ $headers = fvalue ] && INCDIR=$OUTDIR/fvalue
+  $CC $CFLAGS -I $INCDIR -I $OUTDIR -o $OUTDIR/force_table_size force_table_size_main.c || exit 1
+  printf "%-16s %s\n" $headers "`$OUTDIR/force_table_size`"
+done
@@ -0,0 +1,132 @@
+#!/bin/bash
+# Generates a synthetic IEC 61131-3 project, to benchmark the compiler on large
+# sources (see compiler_suite.sh). For each of the POUS units, it contains:
+#   - a function in ST, with VARS local variables, computed with the overloaded
+#     standard functions (ADD, MUL, MAX, LIMIT, SEL, ...) and conversions;
+#   - a function block in ST, with a CASE statement of CASES elements, a
+#     structure nested DEPTH levels deep and an array of ARRAY_SIZE elements;
+#   - a function block in IL, with a chain of JUMPS conditional jumps;
+#   - a program in SFC, with STEPS steps, whose actions call the above;
+# and a configuration running every program.
+#
+# usage: ./gen_project.sh OUTPUT_FILE [POUS] [VARS] [DEPTH] [ARRAY_SIZE] [CASES] [JUMPS] [STEPS]
+
+if [ -z "$1" ]; then
+  echo "usage: $0 OUTPUT_FILE [POUS] [VARS] [DEPTH] [ARRAY_SIZE] [CASES] [JUMPS] [STEPS]"
+  exit 1
+fi
+OUT=$1
+POUS=${2:-10}
+VARS=${3:-20}
+DEPTH=${4:-4}
+ARRAY_SIZE=${5:-100}
+CASES=${6:-50}
+JUMPS=${7:-50}
+STEPS=${8:-10}
+
+if [ $DEPTH -lt 1 ] || [ $ARRAY_SIZE -lt 1 ] || [ $STEPS -lt 2 ] || [ $CASES -gt 32767 ]; then
+  echo "DEPTH and ARRAY_SIZE must be at least 1, STEPS at least 2, and CASES at most 32767"
+  exit 1
+fi
+
+{
+  echo "(* generated by gen_project.sh $POUS $VARS $DEPTH $ARRAY_SIZE $CASES $JUMPS $STEPS *)"
+  echo "TYPE"
+  echo "  nest0_t : STRUCT v0 : INT; r0 : REAL; END_STRUCT;"
+  for ((d = 1; d < DEPTH; d++)); do
+    echo "  nest${d}_t : STRUCT inner : nest$((d-1))_t; v$d : INT; END_STRUCT;"
+  done
+  echo "  big_array_t : ARRAY [0..$((ARRAY_SIZE-1))] OF DINT;"
+  echo "END_TYPE"
+  echo
+
+  # the path to the innermost fields of the nested structure
+  NEST=n
+  for ((d = 1; d < DEPTH; d++)); do NEST=$NEST.inner; done
+
+  for ((i = 0; i < POUS; i++)); do
+    echo "FUNCTION f_$i : REAL"
+    echo "  VAR_INPUT a : INT; b : REAL; c : DINT; END_VAR"
+    echo "  VAR"
+    for ((v = 0; v < VARS; v++)); do echo "    t$v : REAL;"; done
+    echo "    ic : DINT;"
+    echo "  END_VAR"
+    echo "  t0 := ADD(INT_TO_REAL(a), b, 1.0);"
+    for ((v = 1; v < VARS; v++)); do
+      case $((v % 5)) in
+        0) echo "  t$v := MAX(b, t$((v-1)), 2.5) * MUL(b, 2.0, t$((v-1)));";;
+        1) echo "  t$v := LIMIT(-100.0, t$((v-1)) - b, 100.0);";;
+        2) echo "  t$v := SEL(a > $v, t$((v-1)), -t$((v-1))) + ABS(b);";;
+        3) echo "  t$v := MIN(t$((v-1)), DINT_TO_REAL(c), 1.0E6) / 2.0;";;
+        4) echo "  t$v := SQRT(ABS(t$((v-1)))) + INT_TO_REAL(MUX(a MOD 3, 1, 2, 3));";;
+      esac
+    done
+    echo "  ic := MAX(c, DINT#10) + ABS(c) MOD 7;"
+    echo "  f_$i := t$((VARS-1)) + DINT_TO_REAL(ic);"
+    echo "END_FUNCTION"
+    echo
+
+    echo "FUNCTION_BLOCK fb_case_$i"
+    echo "  VAR_INPUT sel : INT; END_VAR"
+    echo "  VAR_OUTPUT out : DINT; END_VAR"
+    echo "  VAR n : nest$((DEPTH-1))_t; arr : big_array_t; k : INT; END_VAR"
+    echo "  CASE sel OF"
+    for ((c = 0; c < CASES; c++)); do
+      echo "    $c: out := arr[$((c % ARRAY_SIZE))] + $c;"
+    done
+    echo "  ELSE"
+    echo "    out := -1;"
+    echo "  END_CASE;"
+    echo "  $NEST.v0 := sel;"
+    echo "  $NEST.r0 := $NEST.r0 + INT_TO_REAL(sel);"
+    echo "  FOR k := 0 TO $((ARRAY_SIZE-1)) DO arr[k] := arr[k] + out; END_FOR;"
+    echo "  out := out + REAL_TO_DINT(f_$i(a := sel, b := $NEST.r0, c := out));"
+    echo "END_FUNCTION_BLOCK"
+    echo
+
+    echo "FUNCTION_BLOCK fb_il_$i"
+    echo "  VAR_INPUT x : DINT; END_VAR"
+    echo "  VAR_OUTPUT y : DINT; END_VAR"
+    echo "      LD x"
+    echo "      ST y"
+    for ((j = 0; j < JUMPS; j++)); do
+      echo "l$j:  LD y"
+      echo "      ADD $j"
+      echo "      ST y"
+      echo "      LT 1000"
+      echo "      JMPC l$((j+1))"
+      echo "      LD 0"
+      echo "      ST y"
+    done
+    echo "l$JUMPS:  LD y"
+    echo "      ST y"
+    echo "END_FUNCTION_BLOCK"
+    echo
+
+    echo "PROGRAM p_sfc_$i"
+    echo "  VAR c : DINT; out : DINT; fb_a : fb_case_$i; fb_b : fb_il_$i; END_VAR"
+    echo "  INITIAL_STEP s0: END_STEP"
+    echo "  TRANSITION FROM s0 TO s1 := c >= 0; END_TRANSITION"
+    for ((s = 1; s < STEPS; s++)); do
+      echo "  STEP s$s: a$s(N); END_STEP"
+      echo "  TRANSITION FROM s$s TO s$(( (s + 1) % STEPS )) := c > $s; END_TRANSITION"
+      echo "  ACTION a$s:"
+      echo "    c := c + 1;"
+      echo "    fb_a(sel := DINT_TO_INT(c));"
+      echo "    fb_b(x := fb_a.out);"
+      echo "    out := fb_b.y;"
+      echo "  END_ACTION"
+    done
+    echo "END_PROGRAM"
+    echo
+  done
+
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  for ((i = 0; i < POUS; i++)); do
+    echo "    PROGRAM inst_$i WITH task0 : p_sfc_$i;"
+  done
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $OUT
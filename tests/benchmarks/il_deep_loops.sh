@@ -0,0 +1,42 @@
+#!/bin/bash
+# Benchmark of the stage 3 IL data flow analysis.
+#
+# Generates a function block whose IL body contains DEPTH nested loops
+# (each loop being closed by a backward JMPC to its label), repeated
+# COUNT times, and measures how long iec2c takes to compile it.
+#
+# usage: ./il_deep_loops.sh [DEPTH] [COUNT]
+
+DEPTH=${1:-50}
+COUNT=${2:-20}
+
+. ./common.sh il_deep_loops
+SRC=$OUTDIR/il_deep_loops.txt
+
+{
+  echo "FUNCTION_BLOCK deep_loops"
+  echo "VAR"
+  for ((d = 0; d < DEPTH; d++)); do echo "  i$d : INT;"; done
+  echo "  acc : LREAL;"
+  echo "END_VAR"
+  for ((c = 0; c < COUNT; c++)); do
+    for ((d = 0; d < DEPTH; d++)); do
+      echo "        LD 0"
+      echo "        ST i$d"
+      echo "l${c}_$d: LD acc"
+      echo "        ADD 1.0"
+      echo "        ST acc"
+    done
+    for ((d = DEPTH - 1; d >= 0; d--)); do
+      echo "        LD i$d"
+      echo "        ADD 1"
+      echo "        ST i$d"
+      echo "        LT 10"
+      echo "        JMPC l${c}_$d"
+    done
+  done
+  echo "END_FUNCTION_BLOCK"
+} > $SRC
+
+echo "IL deep loops: depth=$DEPTH, count=$COUNT, `wc -l < $SRC` lines"
+time $IEC2C -I $LIBDIR -T $OUTDIR $SRC
@@ -0,0 +1,49 @@
+#!/bin/bash
+# Measures the overhead of FB calls with large inputs: copying the inputs into the
+# FB instance on each call, against passing them by reference ('inputs-by-ref'
+# code generator option).
+# Each call passes an ARRAY [1..SIZE] OF REAL and a STRING to a FB that only reads them.
+# (uses soa_layout_main.c, which prints the size of the PID FB and times config_run__())
+#
+# usage: ./inputs_by_ref.sh [NUMBER_OF_CALLS] [ARRAY_SIZE] [NUMBER_OF_CYCLES]
+
+CALLS=${1:-100}
+SIZE=${2:-256}
+CYCLES=${3:-10000}
+
+. ./common.sh inputs_by_ref
+ST=$OUTDIR/inputs_by_ref.st
+{
+  echo "FUNCTION_BLOCK pid"
+  echo "  VAR_INPUT samples : ARRAY [1..$SIZE] OF REAL; tag : STRING; gain : REAL := 1.0; END_VAR"
+  echo "  VAR_OUTPUT avg : REAL; named : BOOL; END_VAR"
+  echo "  VAR i : INT; sum : REAL; END_VAR"
+  echo "  sum := 0.0;"
+  echo "  FOR i := 1 TO $SIZE BY 16 DO sum := sum + samples[i]; END_FOR;"
+  echo "  avg := gain * sum;"
+  echo "  named := tag <> '';"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  echo "    buffer : ARRAY [1..$SIZE] OF REAL; name : STRING := 'loop'; total : REAL;"
+  for i in `seq $CALLS`; do echo "    f$i : pid;"; done
+  echo "  END_VAR"
+  echo "  buffer[1] := buffer[1] + 1.0;"
+  for i in `seq $CALLS`; do echo "  f$i(samples := buffer, tag := name, gain := 0.5); total := total + f$i.avg;"; done
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+printf "%-20s %14s %14s\n" "" "instance (B)" "cycle (us)"
+for opt in no-inputs-by-ref inputs-by-ref; do
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O $opt $ST > /dev/null || exit 1
+  $CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/inputs_by_ref \
+      soa_layout_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+  printf "%-20s %s\n" $opt "`$OUTDIR/inputs_by_ref $CYCLES`"
+done
@@ -0,0 +1,18 @@
+#!/bin/bash
+# Measures the time the PLC thread spends exchanging the process images with 1 to
+# MAX_DRIVERS driver threads that keep accessing them, with the lock-free channels
+# of lib/iec_io_exchange.h and with a single mutex.
+# (uses io_exchange_main.c, which also counts the inconsistent snapshots)
+#
+# usage: ./io_exchange.sh [MAX_DRIVERS] [BYTES_PER_DRIVER] [NUMBER_OF_CYCLES]
+
+MAX_DRIVERS=${1:-8}
+BYTES=${2:-1024}
+CYCLES=${3:-100000}
+
+. ./common.sh io_exchange
+$CC $CFLAGS -I $LIBDIR -o $OUTDIR/io_exchange io_exchange_main.c -lpthread -lrt || exit 1
+printf "%10s %10s %10s %14s %14s %8s\n" "exchange" "drivers" "bytes" "average (us)" "worst (us)" "torn"
+for DRIVERS in `seq $MAX_DRIVERS`; do
+  $OUTDIR/io_exchange $DRIVERS $BYTES $CYCLES
+done
@@ -0,0 +1,188 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Exchanges the process images between a PLC thread and DRIVERS driver threads,
+ * which all keep writing new inputs and reading the outputs as fast as they can,
+ * either with the lock-free channels of lib/iec_io_exchange.h, or with a single
+ * mutex around every access to the images. Prints the average and the worst time
+ * the PLC thread spends exchanging the images in each cycle.
+ *
+ * Each driver fills its inputs with the same counter value, and the "program" copies
+ * the inputs to the outputs, so any torn (inconsistent) snapshot is detected by the
+ * PLC thread, and by the drivers. Their number is printed in the last column.
+ *
+ * usage: io_exchange [DRIVERS] [BYTES_PER_DRIVER] [CYCLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "iec_std_lib.h"
+#include "iec_io_exchange.h"
+
+#define MAX_DRIVERS 64
+#define MAX_BYTES   (1 << 16)
+
+/* the images, as generated in PROCESS_IMAGE.c */
+IEC_LWORD __IEC_input_image [MAX_DRIVERS * MAX_BYTES / 8];
+IEC_LWORD __IEC_output_image[MAX_DRIVERS * MAX_BYTES / 8];
+
+static unsigned int drivers, size;
+static __IEC_io_channel_t inputs[MAX_DRIVERS], outputs[MAX_DRIVERS];
+static int stop;
+static unsigned long torn;
+
+/* the mutex variant: the drivers access the images directly */
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static IEC_LWORD shared_inputs [MAX_DRIVERS * MAX_BYTES / 8];
+static IEC_LWORD shared_outputs[MAX_DRIVERS * MAX_BYTES / 8];
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* whether all the words of a buffer hold the same value */
+static int consistent(const void *buffer) {
+  const unsigned int *words = (const unsigned int *)buffer;
+  unsigned int i;
+  for (i = 1; i < size / sizeof(unsigned int); i++)
+    if (words[i] != words[0])
+      return 0;
+  return 1;
+}
+
+static void fill(void *buffer, unsigned int value) {
+  unsigned int *words = (unsigned int *)buffer;
+  unsigned int i;
+  for (i = 0; i < size / sizeof(unsigned int); i++)
+    words[i] = value;
+}
+
+
+static void *lock_free_driver(void *arg) {
+  unsigned int d = (unsigned int)(long)arg, counter = 0;
+  while (!__atomic_load_n(&stop, __ATOMIC_RELAXED)) {
+    fill(__IEC_io_write_buffer(&inputs[d]), ++counter);
+    __IEC_io_publish(&inputs[d]);
+    if (!consistent(__IEC_io_acquire(&outputs[d])))
+      __atomic_fetch_add(&torn, 1, __ATOMIC_RELAXED);
+  }
+  return NULL;
+}
+
+static void *mutex_driver(void *arg) {
+  unsigned int d = (unsigned int)(long)arg, counter = 0;
+  unsigned char *in  = (unsigned char *)shared_inputs  + d * size;
+  unsigned char *out = (unsigned char *)shared_outputs + d * size;
+  while (!__atomic_load_n(&stop, __ATOMIC_RELAXED)) {
+    pthread_mutex_lock(&mutex);
+    fill(in, ++counter);
+    if (!consistent(out))
+      __atomic_fetch_add(&torn, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&mutex);
+  }
+  return NULL;
+}
+
+
+static void program(void) {
+  unsigned int d;
+  memcpy(__IEC_output_image, __IEC_input_image, drivers * size);
+  for (d = 0; d < drivers; d++)
+    if (!consistent((unsigned char *)__IEC_input_image + d * size))
+      __atomic_fetch_add(&torn, 1, __ATOMIC_RELAXED);
+}
+
+static void run(int lock_free, int cycles) {
+  pthread_t threads[MAX_DRIVERS];
+  double start, t, total = 0, worst = 0;
+  unsigned int d;
+  int c;
+
+  stop = 0;
+  torn = 0;
+  for (d = 0; d < drivers; d++)
+    pthread_create(&threads[d], NULL, lock_free? lock_free_driver : mutex_driver, (void *)(long)d);
+
+  for (c = 0; c < cycles; c++) {
+    start = now();
+    if (lock_free) {
+      __IEC_io_read_inputs(inputs, drivers);
+    } else {
+      pthread_mutex_lock(&mutex);
+      memcpy(__IEC_input_image, shared_inputs, drivers * size);
+      pthread_mutex_unlock(&mutex);
+    }
+    t = now() - start;
+
+    program();
+
+    start = now();
+    if (lock_free) {
+      __IEC_io_write_outputs(outputs, drivers);
+    } else {
+      pthread_mutex_lock(&mutex);
+      memcpy(shared_outputs, __IEC_output_image, drivers * size);
+      pthread_mutex_unlock(&mutex);
+    }
+    t += now() - start;
+    total += t;
+    if (t > worst) worst = t;
+  }
+
+  __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+  for (d = 0; d < drivers; d++)
+    pthread_join(threads[d], NULL);
+
+  printf("%10s %10u %10u %14.3f %14.3f %8lu\n", lock_free? "lock-free" : "mutex",
+         drivers, size, total * 1e6 / cycles, worst * 1e6, torn);
+}
+
+
+int main(int argc, char **argv) {
+  static unsigned char storage[2][MAX_DRIVERS][3 * MAX_BYTES];
+  int cycles;
+  unsigned int d;
+
+  drivers = (argc > 1)? atoi(argv[1]) : 4;
+  size    = (argc > 2)? atoi(argv[2]) : 1024;
+  cycles  = (argc > 3)? atoi(argv[3]) : 100000;
+  if (drivers < 1 || drivers > MAX_DRIVERS || size < 4 || size > MAX_BYTES || size % 8 != 0) {
+    fprintf(stderr, "1 to %d drivers, of 8 to %d bytes (a multiple of 8)\n", MAX_DRIVERS, MAX_BYTES);
+    return 1;
+  }
+  for (d = 0; d < drivers; d++) {
+    __IEC_io_channel_init(&inputs[d],  d * size, size, storage[0][d]);
+    __IEC_io_channel_init(&outputs[d], d * size, size, storage[1][d]);
+  }
+
+  run(0, cycles);
+  run(1, cycles);
+  return 0;
+}
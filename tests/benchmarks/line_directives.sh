@@ -0,0 +1,52 @@
+#!/bin/bash
+# Checks the '-O line-directives' code generator option: a program in ST and a FB
+# in IL are compiled with debug information, and the lines of the IEC 61131-3
+# source code found in it are listed, along with the source map POUS.map.
+# The lines of POUS.c generated from each statement may then be profiled with e.g.
+#   perf record line_directives.out/line_directives; perf annotate
+# (uses profile_main.c as the runtime)
+#
+# usage: ./line_directives.sh
+
+CFLAGS=${CFLAGS:--O0}
+. ./common.sh line_directives
+ST=$OUTDIR/line_directives.st
+{
+  echo "FUNCTION_BLOCK accumulate"
+  echo "  VAR_INPUT x : DINT; END_VAR"
+  echo "  VAR_OUTPUT sum : DINT; END_VAR"
+  echo "  LD sum"
+  echo "  ADD x"
+  echo "  ST sum"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  echo "    acc : accumulate;"
+  echo "    i : INT;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO 10 DO"
+  echo "    acc(x := i);"
+  echo "  END_FOR;"
+  echo "  IF acc.sum > 1000 THEN"
+  echo "    acc.sum := 0;"
+  echo "  END_IF;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+rm -f $OUTDIR/*.c $OUTDIR/*.h $OUTDIR/*.map
+$IEC2C -I $LIBDIR -T $OUTDIR -O line-directives $ST > /dev/null || exit 1
+$CC $CFLAGS -g -I $LIBDIR -I $OUTDIR -o $OUTDIR/line_directives \
+    profile_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+
+echo "POUS.map:"
+cat $OUTDIR/POUS.map
+echo
+echo "lines of `basename $ST` in the debug information:"
+objdump --dwarf=decodedline $OUTDIR/line_directives | grep "`basename $ST`" | awk '{print $2}' | sort -n | uniq | tr '\n' ' '
+echo
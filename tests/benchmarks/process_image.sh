@@ -0,0 +1,40 @@
+#!/bin/bash
+# Measures the time taken to exchange the located variables with a driver, with and
+# without the contiguous process images generated with the 'process-image' code
+# generator option (PROCESS_IMAGE.c, see lib/iec_process_image.h): a program reads
+# TAGS %IW words and TAGS %IX bits, and writes as many %QW words and %QX bits.
+# (uses process_image_main.c, which also checks that both exchanges give the same outputs)
+#
+# usage: ./process_image.sh [TAGS] [NUMBER_OF_CYCLES]
+
+TAGS=${1:-1000}
+CYCLES=${2:-10000}
+
+. ./common.sh process_image
+ST=$OUTDIR/process_image.st
+{
+  echo "PROGRAM plant"
+  echo "  VAR"
+  for i in `seq 0 $((TAGS - 1))`; do
+    echo "    in_w$i AT %IW$i : INT; in_x$i AT %IX$((i / 16)).$((i % 16)) : BOOL;"
+    echo "    out_w$i AT %QW$i : INT; out_x$i AT %QX$((i / 16)).$((i % 16)) : BOOL;"
+  done
+  echo "  END_VAR"
+  for i in `seq 0 $((TAGS - 1))`; do
+    echo "  out_w$i := in_w$i + 1; out_x$i := NOT in_x$i;"
+  done
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+rm -f $OUTDIR/*.c $OUTDIR/*.h
+$IEC2C -I $LIBDIR -T $OUTDIR -O process-image $ST > /dev/null || exit 1
+$CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/process_image \
+    process_image_main.c $OUTDIR/config.c $OUTDIR/resource1.c $OUTDIR/PROCESS_IMAGE.c -lrt || exit 1
+printf "%10s %10s %14s %14s %8s\n" "variables" "bytes" "per var (us)" "image (us)" "errors"
+$OUTDIR/process_image $CYCLES
@@ -0,0 +1,174 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Exchanges the %I and %Q located variables generated with 'iec2c -O process-image'
+ * (PROCESS_IMAGE.c, see lib/iec_process_image.h) with a simulated driver, whose
+ * buffers have the layout of the images, and prints the time a scan cycle takes:
+ *   - when the driver copies each located variable on its own (as a runtime must
+ *     when the located variables are scattered in memory);
+ *   - when the driver copies each image with a single memcpy().
+ * Both must give the same outputs, which is checked.
+ *
+ * usage: process_image [CYCLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "iec_std_lib.h"
+#include "iec_process_image.h"
+
+void config_init__(void);
+void config_run__(unsigned long tick);
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+/* the located variables themselves are defined in PROCESS_IMAGE.c */
+#define __LOCATED_VAR(type, name, ...) extern type *name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+static struct {
+  const char *name;
+  void **ptr;
+} located_vars[] = {
+#define __LOCATED_VAR(type, name, ...) {#name, (void **)&name},
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+  {NULL, NULL}
+};
+
+/* a located variable, as seen by the driver */
+typedef struct {
+  unsigned char *var;
+  unsigned int offset;
+  unsigned char bit;
+  unsigned char size;
+} io_t;
+
+static io_t inputs[1 << 16], outputs[1 << 16];
+static unsigned int inputs_count, outputs_count;
+
+static unsigned char driver_in[1 << 20], driver_out[1 << 20], expected_out[1 << 20];
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* "%IX2.3" -> the variable __IX2_3 */
+static unsigned char *find_var(const char *location) {
+  char name[64] = "__";
+  unsigned int i, j;
+  for (i = 1, j = 2; location[i] != '\0' && j < sizeof(name) - 1; i++, j++)
+    name[j] = (location[i] == '.')? '_' : location[i];
+  name[j] = '\0';
+  for (i = 0; located_vars[i].name != NULL; i++)
+    if (strcmp(located_vars[i].name, name) == 0)
+      return (unsigned char *)*located_vars[i].ptr;
+  fprintf(stderr, "%s is not in LOCATED_VARIABLES.h\n", location);
+  exit(1);
+}
+
+static unsigned int list_io(io_t *io, const __IEC_image_location_t *locations, unsigned int count) {
+  unsigned int i;
+  for (i = 0; i < count; i++) {
+    io[i].var    = find_var(locations[i].location);
+    io[i].offset = locations[i].offset;
+    io[i].bit    = locations[i].bit;
+    io[i].size   = locations[i].size;
+  }
+  return count;
+}
+
+
+static void cycle_scattered(unsigned long tick) {
+  unsigned int i;
+  for (i = 0; i < inputs_count; i++)
+    if (inputs[i].size == 0)
+      *inputs[i].var = (driver_in[inputs[i].offset] >> inputs[i].bit) & 1;
+    else
+      memcpy(inputs[i].var, &driver_in[inputs[i].offset], inputs[i].size);
+  config_run__(tick);
+  for (i = 0; i < outputs_count; i++)
+    if (outputs[i].size == 0)
+      driver_out[outputs[i].offset] = (driver_out[outputs[i].offset] & ~(1 << outputs[i].bit))
+                                    | ((*outputs[i].var != 0) << outputs[i].bit);
+    else
+      memcpy(&driver_out[outputs[i].offset], outputs[i].var, outputs[i].size);
+}
+
+static void cycle_image(unsigned long tick) {
+  memcpy(__IEC_input_image, driver_in, __IEC_input_image_size);
+  __IEC_unpack_input_image();
+  config_run__(tick);
+  __IEC_pack_output_image();
+  memcpy(driver_out, __IEC_output_image, __IEC_output_image_size);
+}
+
+
+int main(int argc, char **argv) {
+  int cycles = (argc > 1)? atoi(argv[1]) : 10000;
+  unsigned long tick;
+  unsigned int i, errors = 0;
+  double scattered, image;
+
+  if (__IEC_input_image_size > sizeof(driver_in) || __IEC_output_image_size > sizeof(driver_out)
+      || __IEC_input_locations_count > sizeof(inputs) / sizeof(inputs[0])
+      || __IEC_output_locations_count > sizeof(outputs) / sizeof(outputs[0])) {
+    fprintf(stderr, "too many located variables\n");
+    return 1;
+  }
+  inputs_count  = list_io(inputs,  __IEC_input_locations,  __IEC_input_locations_count);
+  outputs_count = list_io(outputs, __IEC_output_locations, __IEC_output_locations_count);
+  for (i = 0; i < __IEC_input_image_size; i++)
+    driver_in[i] = (unsigned char)(i * 7 + 3);
+
+  config_init__();
+  /* warm up the caches, and get the expected outputs */
+  for (tick = 0; tick < 100; tick++)
+    cycle_scattered(tick);
+  memcpy(expected_out, driver_out, __IEC_output_image_size);
+
+  scattered = now();
+  for (tick = 0; tick < (unsigned long)cycles; tick++)
+    cycle_scattered(tick);
+  scattered = now() - scattered;
+
+  memset(driver_out, 0, __IEC_output_image_size);
+  image = now();
+  for (tick = 0; tick < (unsigned long)cycles; tick++)
+    cycle_image(tick);
+  image = now() - image;
+  errors += (memcmp(expected_out, driver_out, __IEC_output_image_size) != 0);
+
+  printf("%10u %10u %14.3f %14.3f %8u\n", inputs_count + outputs_count,
+         __IEC_input_image_size + __IEC_output_image_size,
+         scattered * 1e6 / cycles, image * 1e6 / cycles, errors);
+  return errors != 0;
+}
@@ -0,0 +1,49 @@
+#!/bin/bash
+# Measures the overhead of the POU profiling of the 'profile' code generator option
+# (see lib/iec_profile.h), and prints the profile: a program calls INSTANCES
+# instances of a FB, which calls a function. The code is generated once with
+# '-O profile', and compiled without and with __IEC_PROFILE defined.
+# (uses profile_main.c)
+#
+# usage: ./profile.sh [INSTANCES] [NUMBER_OF_CYCLES]
+
+INSTANCES=${1:-100}
+CYCLES=${2:-10000}
+
+. ./common.sh profile
+ST=$OUTDIR/profile.st
+{
+  echo "FUNCTION scale : REAL"
+  echo "  VAR_INPUT x, gain : REAL; END_VAR"
+  echo "  scale := x * gain;"
+  echo "END_FUNCTION"
+  echo "FUNCTION_BLOCK filter"
+  echo "  VAR_INPUT x : REAL; END_VAR"
+  echo "  VAR_OUTPUT y : REAL; END_VAR"
+  echo "  y := y + scale(x := x - y, gain := 0.1);"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  echo "    filters : ARRAY [1..$INSTANCES] OF filter;"
+  echo "    i : INT;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO $INSTANCES DO filters[i](x := INT_TO_REAL(i)); END_FOR;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+rm -f $OUTDIR/*.c $OUTDIR/*.h
+$IEC2C -I $LIBDIR -T $OUTDIR -O profile $ST > /dev/null || exit 1
+
+printf "%16s %14s\n" "" "cycle (us)"
+for DEFINE in "" "-D__IEC_PROFILE"; do
+  $CC $CFLAGS $DEFINE -I $LIBDIR -I $OUTDIR -o $OUTDIR/profile \
+      profile_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+  printf "%16s " "${DEFINE:-no __IEC_PROFILE}"
+  $OUTDIR/profile $CYCLES
+done
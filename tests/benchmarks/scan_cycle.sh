@@ -0,0 +1,104 @@
+#!/bin/bash
+# Scan cycle benchmark of the code generated for the standard library: each
+# workload is a program running INSTANCES instances of some of its function blocks
+# (or calls of its functions) every scan, with inputs fed by the harness. Prints the
+# percentiles of the scan time of each workload, and the time spent in each POU
+# (the code is generated with '-O profile', and compiled a second time with
+# __IEC_PROFILE defined). Compare the results before and after a change to the
+# runtime library.
+# (uses scan_cycle_main.c)
+#
+# usage: ./scan_cycle.sh [INSTANCES] [NUMBER_OF_CYCLES] [WORKLOAD...]
+#   WORKLOAD: ton ctu pid ramp strings (default: all of them)
+
+INSTANCES=${1:-100}
+CYCLES=${2:-100000}
+shift $(( ($# < 2)? $# : 2 ))
+WORKLOADS=${*:-ton ctu pid ramp strings}
+
+. ./common.sh scan_cycle
+
+# The body of the program of each workload. start, reset, run : BOOL, n : INT and
+# pv, sp : REAL are fed by the harness; i : INT is the loop counter.
+workload_ton() {
+  echo "    t : ARRAY [1..$INSTANCES] OF TON;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO $INSTANCES DO t[i](IN := start, PT := T#50ms); END_FOR;"
+  echo "  done := t[$INSTANCES].Q;"
+}
+workload_ctu() {
+  echo "    c : ARRAY [1..$INSTANCES] OF CTU;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO $INSTANCES DO c[i](CU := start, R := reset, PV := 100); END_FOR;"
+  echo "  done := c[$INSTANCES].Q;"
+}
+workload_pid() {
+  echo "    p : ARRAY [1..$INSTANCES] OF PID;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO $INSTANCES DO"
+  echo "    p[i](AUTO := TRUE, PV := pv, SP := sp, X0 := 0.0, KP := 1.0, TR := 10.0, TD := 0.1, CYCLE := T#10ms);"
+  echo "  END_FOR;"
+  echo "  xout := p[$INSTANCES].XOUT;"
+}
+workload_ramp() {
+  echo "    r : ARRAY [1..$INSTANCES] OF RAMP;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO $INSTANCES DO r[i](RUN := run, X0 := 0.0, X1 := pv, TR := T#1s, CYCLE := T#10ms); END_FOR;"
+  echo "  xout := r[$INSTANCES].XOUT;"
+}
+workload_strings() {
+  echo "    s, s2, s3 : STRING;"
+  echo "    p : INT;"
+  echo "  END_VAR"
+  echo "  FOR i := 1 TO $INSTANCES DO"
+  echo "    s := CONCAT('value=', INT_TO_STRING(n + i));"
+  echo "    p := FIND(s, '=');"
+  echo "    s2 := MID(s, 2, p + 1);"
+  echo "    s3 := REPLACE(s, s2, 1, p);"
+  echo "    s3 := INSERT(s3, LEFT(s, 3), LEN(s3));"
+  echo "    s3 := DELETE(s3, 2, 1);"
+  echo "    done := (s3 = RIGHT(s, 2)) OR (LEN(s3) > 20);"
+  echo "  END_FOR;"
+}
+printf "%-10s %10s %10s %10s %10s %10s %10s\n" "workload" "mean (us)" "p50" "p90" "p99" "p99.9" "max"
+for WORKLOAD in $WORKLOADS; do
+  ST=$OUTDIR/$WORKLOAD.st
+  {
+    echo "PROGRAM bench"
+    echo "  VAR"
+    echo "    start AT %IX0.0 : BOOL;"
+    echo "    reset AT %IX0.1 : BOOL;"
+    echo "    run   AT %IX0.2 : BOOL;"
+    echo "    n     AT %IW0   : INT;"
+    echo "    pv    AT %ID1   : REAL;"
+    echo "    sp    AT %ID2   : REAL;"
+    echo "    done  AT %QX0.0 : BOOL;"
+    echo "    xout  AT %QD0   : REAL;"
+    echo "    i : INT;"
+    workload_$WORKLOAD
+    echo "END_PROGRAM"
+    echo "CONFIGURATION config"
+    echo "  RESOURCE resource1 ON PLC"
+    echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+    echo "    PROGRAM instance0 WITH task0 : bench;"
+    echo "  END_RESOURCE"
+    echo "END_CONFIGURATION"
+  } > $ST
+
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O profile $ST > /dev/null || exit 1
+  for DEFINE in "" "-D__IEC_PROFILE"; do
+    $CC $CFLAGS $DEFINE -I $LIBDIR -I $OUTDIR -o $OUTDIR/scan_cycle_$WORKLOAD$DEFINE \
+        scan_cycle_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt -lm || exit 1
+  done
+  printf "%-10s " $WORKLOAD
+  $OUTDIR/scan_cycle_$WORKLOAD $CYCLES
+  # the time spent in each POU, without the first line (the scan times, with the profiling overhead)
+  $OUTDIR/scan_cycle_$WORKLOAD-D__IEC_PROFILE $CYCLES | tail -n +2 > $OUTDIR/$WORKLOAD.profile
+done
+
+echo
+for WORKLOAD in $WORKLOADS; do
+  echo "$WORKLOAD:"
+  cat $OUTDIR/$WORKLOAD.profile
+done
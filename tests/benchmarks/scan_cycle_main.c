@@ -0,0 +1,159 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Scan cycle benchmark harness. Runs config_run__() in a tight loop, advancing
+ * __CURRENT_TIME by common_ticktime__ before each scan (virtual time: the timers
+ * of the program see the time passing at the rate of the task, without waiting),
+ * and feeding synthetic values to the located input variables (%I): square waves
+ * of different periods for the BOOLs, and sawtooth waves for the other types.
+ *
+ * Prints the mean, the 50th, 90th, 99th and 99.9th percentiles, and the maximum
+ * of the time of each scan (in us). When the code generated with 'iec2c -O profile'
+ * is compiled with __IEC_PROFILE defined, also prints the time spent in each POU
+ * (see lib/iec_profile.h: in CPU cycles on x86). See scan_cycle.sh.
+ *
+ * usage: scan_cycle [CYCLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "iec_std_lib.h"
+#include "accessor.h"
+#include "POUS.h"
+
+void config_init__(void);
+void config_run__(unsigned long tick);
+extern unsigned long long common_ticktime__;
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+
+/* The synthetic value of the input number 'input', at scan 'cycle' */
+#define __SYNTH_BOOL(cycle, input)  (((cycle) / (8 + (input))) & 1)
+#define __SYNTH_INT_TYPE(type, cycle, input)  ((type)(((cycle) + 13 * (input)) % 100))
+#define __SYNTH_SINT(cycle, input)  __SYNTH_INT_TYPE(SINT,  cycle, input)
+#define __SYNTH_INT(cycle, input)   __SYNTH_INT_TYPE(INT,   cycle, input)
+#define __SYNTH_DINT(cycle, input)  __SYNTH_INT_TYPE(DINT,  cycle, input)
+#define __SYNTH_LINT(cycle, input)  __SYNTH_INT_TYPE(LINT,  cycle, input)
+#define __SYNTH_USINT(cycle, input) __SYNTH_INT_TYPE(USINT, cycle, input)
+#define __SYNTH_UINT(cycle, input)  __SYNTH_INT_TYPE(UINT,  cycle, input)
+#define __SYNTH_UDINT(cycle, input) __SYNTH_INT_TYPE(UDINT, cycle, input)
+#define __SYNTH_ULINT(cycle, input) __SYNTH_INT_TYPE(ULINT, cycle, input)
+#define __SYNTH_BYTE(cycle, input)  __SYNTH_INT_TYPE(BYTE,  cycle, input)
+#define __SYNTH_WORD(cycle, input)  __SYNTH_INT_TYPE(WORD,  cycle, input)
+#define __SYNTH_DWORD(cycle, input) __SYNTH_INT_TYPE(DWORD, cycle, input)
+#define __SYNTH_LWORD(cycle, input) __SYNTH_INT_TYPE(LWORD, cycle, input)
+#define __SYNTH_REAL(cycle, input)  ((REAL)(((cycle) + 13 * (input)) % 200) * 0.5f)
+#define __SYNTH_LREAL(cycle, input) ((LREAL)(((cycle) + 13 * (input)) % 200) * 0.5)
+
+#define __FEED_I(type, name) __##name = __SYNTH_##type(cycle, input); input++;
+#define __FEED_Q(type, name)
+#define __FEED_M(type, name)
+
+static void feed_inputs(unsigned long cycle) {
+  unsigned long input = 0;
+#define __LOCATED_VAR(type, name, direction, ...) __FEED_##direction(type, name)
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+  (void)input;
+}
+
+static void advance_time(void) {
+  __CURRENT_TIME.tv_nsec += common_ticktime__ % 1000000000ULL;
+  __CURRENT_TIME.tv_sec  += common_ticktime__ / 1000000000ULL;
+  if (__CURRENT_TIME.tv_nsec >= 1000000000) {
+    __CURRENT_TIME.tv_nsec -= 1000000000;
+    __CURRENT_TIME.tv_sec++;
+  }
+}
+
+static unsigned long long now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int compare(const void *a, const void *b) {
+  unsigned long long x = *(const unsigned long long *)a, y = *(const unsigned long long *)b;
+  return (x > y) - (x < y);
+}
+
+/* the p-th percentile of the sorted scan times, in us */
+static double percentile(const unsigned long long *times, unsigned long count, double p) {
+  unsigned long i = (unsigned long)(p / 100.0 * count);
+  return times[(i < count)? i : count - 1] * 1e-3;
+}
+
+
+int main(int argc, char **argv) {
+  unsigned long cycles = (argc > 1)? strtoul(argv[1], NULL, 10) : 100000;
+  unsigned long long *times, start, total = 0;
+  unsigned long tick;
+
+  if (cycles == 0 || (times = malloc(cycles * sizeof(*times))) == NULL) {
+    fprintf(stderr, "usage: %s [CYCLES]\n", argv[0]);
+    return 1;
+  }
+
+  config_init__();
+  /* warm up the caches */
+  for (tick = 0; tick < 100; tick++) {
+    advance_time();
+    feed_inputs(tick);
+    config_run__(tick);
+  }
+#ifdef __IEC_PROFILE
+  __IEC_profile_reset();
+#endif
+
+  for (tick = 0; tick < cycles; tick++) {
+    advance_time();
+    feed_inputs(tick);
+    start = now();
+    config_run__(tick);
+    times[tick] = now() - start;
+    total += times[tick];
+  }
+  qsort(times, cycles, sizeof(*times), compare);
+  printf("%10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", total * 1e-3 / cycles,
+         percentile(times, cycles, 50), percentile(times, cycles, 90), percentile(times, cycles, 99),
+         percentile(times, cycles, 99.9), times[cycles - 1] * 1e-3);
+
+#ifdef __IEC_PROFILE
+  printf("\n");
+  __IEC_profile_print(stdout);
+  printf("\n");
+#endif
+  free(times);
+  return 0;
+}
@@ -0,0 +1,62 @@
+#!/bin/bash
+# Runs a sequence spanning HOURS hours of PLC time with the simulation runtime
+# (tests/sim.c), which advances the clock by the task period after each scan instead
+# of waiting: a TON of 1 hour, restarted every 90 minutes by the input script.
+# Prints how much faster than real time it runs, and checks that a second run
+# records exactly the same outputs.
+#
+# usage: ./simulation.sh [HOURS]
+
+HOURS=${1:-24}
+
+. ./common.sh simulation
+ST=$OUTDIR/simulation.st
+{
+  echo "PROGRAM sequence"
+  echo "  VAR"
+  echo "    start AT %IX0.0 : BOOL;"
+  echo "    done  AT %QX0.0 : BOOL;"
+  echo "    count AT %QW0   : INT;"
+  echo "    delay : TON;"
+  echo "    edge : R_TRIG;"
+  echo "  END_VAR"
+  echo "  delay(IN := start, PT := T#1h);"
+  echo "  done := delay.Q;"
+  echo "  edge(CLK := delay.Q);"
+  echo "  IF edge.Q THEN count := count + 1; END_IF;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : sequence;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+SCRIPT=$OUTDIR/simulation.in
+{
+  echo "# start the TON every 90 minutes, for 80 minutes"
+  for ((m = 0; m < HOURS * 60; m += 90)); do
+    echo "${m}m %IX0.0 1"
+    echo "$((m + 80))m %IX0.0 0"
+  done
+} > $SCRIPT
+
+rm -f $OUTDIR/*.c $OUTDIR/*.h
+$IEC2C -I $LIBDIR -T $OUTDIR $ST > /dev/null || exit 1
+$CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/sim ../sim.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+
+START=`date +%s.%N`
+$OUTDIR/sim -s $SCRIPT -t ${HOURS}h -o $OUTDIR/run1.out || exit 1
+END=`date +%s.%N`
+$OUTDIR/sim -s $SCRIPT -t ${HOURS}h -o $OUTDIR/run2.out 2> /dev/null || exit 1
+
+echo "$HOURS h of PLC time in `echo "$END - $START" | bc -l | xargs printf "%.3f"` s:" \
+     "`echo "$HOURS * 3600 / ($END - $START)" | bc -l | xargs printf "%.0f"` times faster than real time"
+echo "`grep -c QX0.0 $OUTDIR/run1.out` changes of %QX0.0 recorded, last count: `grep QW0 $OUTDIR/run1.out | tail -1`"
+if cmp -s $OUTDIR/run1.out $OUTDIR/run2.out; then
+  echo "the outputs of the two runs are identical"
+else
+  echo "the outputs of the two runs differ!"
+  exit 1
+fi
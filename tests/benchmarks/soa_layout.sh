@@ -0,0 +1,48 @@
+#!/bin/bash
+# Compares the default layout of the variables of FB instances (value and flags
+# of each variable together) with the struct of arrays layout ('soa-layout' code
+# generator option), in memory used per instance and in scan cycle time.
+#
+# usage: ./soa_layout.sh [NUMBER_OF_FB_INSTANCES] [NUMBER_OF_CYCLES]
+
+INSTANCES=${1:-1000}
+CYCLES=${2:-10000}
+
+. ./common.sh soa_layout
+ST=$OUTDIR/soa_layout.st
+{
+  echo "FUNCTION_BLOCK pid"
+  echo "  VAR_INPUT sp, pv : REAL; kp : REAL := 1.5; ki : REAL := 0.1; kd : REAL := 0.01; auto : BOOL := TRUE; END_VAR"
+  echo "  VAR_OUTPUT out : REAL; sat : BOOL; END_VAR"
+  echo "  VAR err, prev_err, integ, deriv : REAL; lo : REAL := -100.0; hi : REAL := 100.0; END_VAR"
+  echo "  IF auto THEN"
+  echo "    err := sp - pv; integ := integ + ki * err; deriv := err - prev_err; prev_err := err;"
+  echo "    out := kp * err + integ + kd * deriv;"
+  echo "    sat := out > hi OR out < lo;"
+  echo "    IF out > hi THEN out := hi; ELSIF out < lo THEN out := lo; END_IF;"
+  echo "  END_IF;"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  for i in `seq $INSTANCES`; do echo "    c$i : pid;"; done
+  echo "  END_VAR"
+  for i in `seq $INSTANCES`; do echo "  c$i(sp := 50.0, pv := c$i.out * 0.5);"; done
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+printf "%-16s %14s %14s\n" "" "instance (B)" "cycle (us)"
+for opt in no-soa-layout soa-layout; do
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O $opt $ST > /dev/null || exit 1
+  DEFS=""
+  [ $opt = soa-layout ] && DEFS="-D__IEC_SOA_LAYOUT"
+  $CC $CFLAGS $DEFS -I $LIBDIR -I $OUTDIR -o $OUTDIR/soa_layout \
+      soa_layout_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+  printf "%-16s %s\n" $opt "`$OUTDIR/soa_layout $CYCLES`"
+done
@@ -0,0 +1,75 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Prints the size of a FB instance and the time config_run__() takes (i.e. one
+ * scan cycle). See soa_layout.sh, which defines __IEC_SOA_LAYOUT when needed.
+ *
+ * usage: soa_layout [CYCLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "iec_std_lib.h"
+#include "accessor.h"
+#include "POUS.h"
+
+void config_init__(void);
+void config_run__(unsigned long tick);
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+int main(int argc, char **argv) {
+  int cycles = (argc > 1)? atoi(argv[1]) : 10000;
+  unsigned long tick;
+  double start;
+
+  config_init__();
+  /* warm up the caches */
+  for (tick = 0; tick < 100; tick++)
+    config_run__(tick);
+
+  start = now();
+  for (tick = 0; tick < (unsigned long)cycles; tick++)
+    config_run__(tick);
+
+  printf("%14d %14.2f\n", (int)sizeof(PID), (now() - start) * 1e6 / cycles);
+  return 0;
+}
@@ -0,0 +1,50 @@
+#!/bin/bash
+# Measures the scan time of code calling the extensible standard functions
+# (ADD, MUL, MAX, MIN, AND, GT, ...) without EN/ENO, with and without their
+# EN/ENO-free variants ('fast-std-calls' code generator option).
+# (uses soa_layout_main.c, which prints the size of the PID FB and times config_run__())
+#
+# usage: ./std_fast_calls.sh [NUMBER_OF_FB_INSTANCES] [NUMBER_OF_CYCLES]
+
+INSTANCES=${1:-100}
+CYCLES=${2:-10000}
+
+. ./common.sh std_fast_calls
+ST=$OUTDIR/std_fast_calls.st
+{
+  echo "FUNCTION_BLOCK pid"
+  echo "  VAR_INPUT sp, pv : REAL; lo, hi : REAL; enable : BOOL; END_VAR"
+  echo "  VAR_OUTPUT out : REAL; alarm : BOOL; END_VAR"
+  echo "  VAR err, i_term : REAL; t : TIME; count : INT; END_VAR"
+  echo "  err := SUB(sp, pv);"
+  echo "  i_term := MIN(MAX(ADD(i_term, MUL(err, 0.01)), lo), hi);"
+  echo "  out := MIN(MAX(ADD(MUL(err, 2.0), i_term, 0.5), lo, -100.0), hi, 100.0);"
+  echo "  alarm := AND(enable, OR(GT(err, 10.0), LT(err, -10.0)), NOT alarm) OR XOR(enable, alarm);"
+  echo "  count := ADD(count, 1, MUL(2, 3)) MOD 1000;"
+  echo "  t := ADD(t, T#10ms);"
+  echo "  IF GE(t, T#1h) OR EQ(count, 999) THEN t := T#0s; END_IF;"
+  echo "END_FUNCTION_BLOCK"
+  echo "PROGRAM plant"
+  echo "  VAR"
+  echo "    pv : REAL; fault : BOOL;"
+  for i in `seq $INSTANCES`; do echo "    f$i : pid;"; done
+  echo "  END_VAR"
+  echo "  pv := pv + 0.1;"
+  for i in `seq $INSTANCES`; do echo "  f$i(sp := 50.0, pv := pv, lo := 0.0, hi := 80.0, enable := TRUE); fault := fault OR f$i.alarm;"; done
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  echo "    TASK task0(INTERVAL := T#10ms, PRIORITY := 0);"
+  echo "    PROGRAM instance0 WITH task0 : plant;"
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+printf "%-20s %14s %14s\n" "" "instance (B)" "cycle (us)"
+for opt in no-fast-std-calls fast-std-calls; do
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR -O $opt $ST > /dev/null || exit 1
+  $CC $CFLAGS -I $LIBDIR -I $OUTDIR -o $OUTDIR/std_fast_calls \
+      soa_layout_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+  printf "%-20s %s\n" $opt "`$OUTDIR/std_fast_calls $CYCLES`"
+done
@@ -0,0 +1,47 @@
+#!/bin/bash
+# Measures the overhead of the task instrumentation of the 'task-stats' code
+# generator option (see lib/iec_task_stats.h): a configuration with TASKS tasks,
+# each running a small program every cycle, is compiled with and without it.
+# Then runs the instrumented version in real time for PACED_CYCLES cycles, and
+# prints the statistics collected.
+# (uses task_stats_main.c)
+#
+# usage: ./task_stats.sh [TASKS] [NUMBER_OF_CYCLES] [PACED_CYCLES]
+
+TASKS=${1:-10}
+CYCLES=${2:-100000}
+PACED=${3:-1000}
+
+. ./common.sh task_stats
+ST=$OUTDIR/task_stats.st
+{
+  echo "PROGRAM counter"
+  echo "  VAR count : DINT; END_VAR"
+  echo "  count := count + 1;"
+  echo "END_PROGRAM"
+  echo "CONFIGURATION config"
+  echo "  RESOURCE resource1 ON PLC"
+  for i in `seq $TASKS`; do
+    echo "    TASK task$i(INTERVAL := T#$((i))ms, PRIORITY := $i);"
+  done
+  for i in `seq $TASKS`; do
+    echo "    PROGRAM instance$i WITH task$i : counter;"
+  done
+  echo "  END_RESOURCE"
+  echo "END_CONFIGURATION"
+} > $ST
+
+build() {
+  rm -f $OUTDIR/*.c $OUTDIR/*.h
+  $IEC2C -I $LIBDIR -T $OUTDIR $1 $ST > /dev/null || exit 1
+  $CC $CFLAGS $2 -I $LIBDIR -I $OUTDIR -o $OUTDIR/task_stats \
+      task_stats_main.c $OUTDIR/config.c $OUTDIR/resource1.c -lrt || exit 1
+}
+
+printf "%12s %14s\n" "" "cycle (us)"
+build "" ""
+printf "%12s " "plain"
+$OUTDIR/task_stats $CYCLES
+build "-O task-stats" "-DTASK_STATS"
+printf "%12s " "task-stats"
+$OUTDIR/task_stats $CYCLES $PACED
@@ -0,0 +1,110 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Prints the time config_run__() takes (i.e. one scan cycle), running the cycles
+ * back to back. See task_stats.sh, which defines TASK_STATS when the program was
+ * compiled with 'iec2c -O task-stats'.
+ * With PACED_CYCLES > 0, then runs as many cycles more, each one released on time
+ * (every common_ticktime__ ns), while sharing the task statistics in the shared
+ * memory object /matiec_task_stats (see tests/task_stats_dump.c), and prints them.
+ *
+ * usage: task_stats [CYCLES] [PACED_CYCLES]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "iec_std_lib.h"
+#include "accessor.h"
+#include "POUS.h"
+#ifdef TASK_STATS
+#define __IEC_TASK_STATS_SHM
+#include "iec_task_stats.h"
+#endif
+
+void config_init__(void);
+void config_run__(unsigned long tick);
+extern unsigned long long common_ticktime__;
+
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+int main(int argc, char **argv) {
+  int cycles = (argc > 1)? atoi(argv[1]) : 10000;
+  int paced  = (argc > 2)? atoi(argv[2]) : 0;
+  unsigned long tick;
+  double start;
+
+  config_init__();
+  /* warm up the caches */
+  for (tick = 0; tick < 100; tick++)
+    config_run__(tick);
+
+  start = now();
+  for (tick = 0; tick < (unsigned long)cycles; tick++)
+    config_run__(tick);
+  printf("%14.3f\n", (now() - start) * 1e6 / cycles);
+
+#ifdef TASK_STATS
+  if (paced > 0) {
+    struct timespec release;
+    __IEC_task_stats_block_t *shared = __IEC_task_stats_share("/matiec_task_stats");
+    if (shared != NULL)
+      __IEC_task_stats = shared;
+    config_init__();
+    clock_gettime(CLOCK_MONOTONIC, &release);
+    for (tick = 0; tick < (unsigned long)paced; tick++) {
+      release.tv_nsec += common_ticktime__;
+      while (release.tv_nsec >= 1000000000) {
+        release.tv_nsec -= 1000000000;
+        release.tv_sec++;
+      }
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &release, NULL);
+      config_run__(tick);
+    }
+    printf("\n");
+    __IEC_task_stats_print(stdout, __IEC_task_stats);
+    if (shared != NULL)
+      shm_unlink("/matiec_task_stats");
+  }
+#else
+  (void)paced;
+#endif
+  return 0;
+}
@@ -0,0 +1,389 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *  Copyright (C) 2007-2011  Laurent Bessard and Edouard Tisserant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ *
+ *
+ * Simulation runtime: runs the generated PLC code with a virtual clock.
+ *
+ * Instead of waiting for a timer, config_run__() is called in a loop as fast as the
+ * CPU allows, and __CURRENT_TIME (read by the timers, the SFC step times and RTC)
+ * advances by common_ticktime__ before each call, starting from 0. A sequence that
+ * spans hours of PLC time therefore runs in seconds, and, as nothing depends on the
+ * wall clock, runs the same way every time: the outputs recorded may be compared
+ * with those of a previous run (e.g. with diff) as a regression test.
+ *
+ * The located input (and memory) variables are set by an input script, a text file
+ * with one change per line, in order of time:
+ *     <time> <location> <value>
+ * e.g.
+ *     # start the pump, and stop it 2 hours later
+ *     0s      %IX0.0  1
+ *     2h      %IX0.0  0
+ *     2h30m   %IW4    150
+ * The time is a duration as in IEC 61131-3 (an optional T# followed by numbers
+ * with the units d, h, m, s, ms, us and ns), the value a number (BOOL: 0 or 1).
+ * The changes of a line are applied before the first scan at or after its time.
+ *
+ * The output variables (%Q, and %M with -m) are recorded in the same format, at
+ * the time of the scan that changed them (every scan with -a), e.g.
+ *     7200.010000000 %QX0.0 1
+ *
+ * usage: sim [-s <input_script>] [-o <output_file>] [-t <duration>] [-a] [-m]
+ *   -s : the input script (default: none)
+ *   -o : where to record the outputs (default: stdout)
+ *   -t : how long to run (default: up to the time of the last line of the script)
+ *   -a : record every output variable after every scan, not only those that changed
+ *   -m : also record the %M variables
+ *
+ * Build, with the files generated by iec2c in the current directory:
+ *     gcc -I ../lib sim.c config.c resource1.c -lrt -o sim
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "iec_std_lib.h"
+
+/*
+ * Functions and variables provided by the generated C softPLC
+ **/ 
+void config_run__(unsigned long tick);
+void config_init__(void);
+extern unsigned long long common_ticktime__;
+
+/*
+ *  Functions and variables to export to generated C softPLC
+ **/
+TIME __CURRENT_TIME;
+BOOL __DEBUG;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+
+/* The located variables, e.g. {"BOOL", "I,X,0,0", &____IX0_0, 1} */
+typedef struct {
+  const char *type;
+  const char *address;
+  void       *value;
+  size_t      size;
+  char        location[64];   /* %IX0.0 */
+  unsigned char last[8];      /* the value last recorded */
+} located_t;
+
+#define __LOCATED_VAR(type, name, ...) {#type, #__VA_ARGS__, &__##name, sizeof(type), "", {0}},
+static located_t located[] = {
+#include "LOCATED_VARIABLES.h"
+  {NULL, NULL, NULL, 0, "", {0}}
+};
+#undef __LOCATED_VAR
+
+/* An input change of the script */
+typedef struct {
+  unsigned long long time;   /* ns */
+  located_t *var;
+  char value[64];
+  int line;
+} event_t;
+
+
+/* "I,X,0,0" -> "%IX0.0" */
+static void location_name(located_t *var) {
+  const char *a;
+  char *l = var->location, *end = var->location + sizeof(var->location) - 1;
+  int commas = 0;
+  *l++ = '%';
+  for (a = var->address; *a != '\0' && l < end; a++) {
+    if (isspace((unsigned char)*a))
+      continue;
+    if (*a != ',') {
+      *l++ = *a;
+      continue;
+    }
+    /* no '.' after the direction, nor after the size (if any: "I,0,1" is %I0.1) */
+    commas++;
+    if (commas > 2 || (commas == 2 && isdigit((unsigned char)var->location[2])))
+      *l++ = '.';
+  }
+  *l = '\0';
+}
+
+static located_t *find_location(const char *name) {
+  located_t *var;
+  for (var = located; var->type != NULL; var++)
+    if (strcasecmp(var->location, name) == 0)
+      return var;
+  return NULL;
+}
+
+
+/* Parses a duration ("T#1h30m", "2.5s", "100ms", ...), in ns. Returns -1 on error. */
+static int parse_duration(const char *str, unsigned long long *ns) {
+  static const struct {const char *unit; double ns;} units[] = {
+    {"ms", 1e6}, {"us", 1e3}, {"ns", 1}, {"d", 86400e9}, {"h", 3600e9}, {"m", 60e9}, {"s", 1e9}
+  };
+  double total = 0;
+  char *end;
+  unsigned int u;
+
+  if (strncasecmp(str, "T#", 2) == 0) str += 2;
+  else if (strncasecmp(str, "TIME#", 5) == 0) str += 5;
+  if (*str == '\0') return -1;
+  while (*str != '\0') {
+    double number = strtod(str, &end);
+    if (end == str) return -1;
+    for (u = 0; u < sizeof(units) / sizeof(units[0]); u++)
+      if (strncasecmp(end, units[u].unit, strlen(units[u].unit)) == 0)
+        break;
+    if (u == sizeof(units) / sizeof(units[0])) return -1;
+    total += number * units[u].ns;
+    str = end + strlen(units[u].unit);
+    while (*str == '_') str++;
+  }
+  *ns = (unsigned long long)(total + 0.5);
+  return 0;
+}
+
+
+#define __IS_TYPE(var, name) (strcmp((var)->type, #name) == 0)
+#define __IS_SIGNED(var)   (__IS_TYPE(var, SINT) || __IS_TYPE(var, INT) || __IS_TYPE(var, DINT) || __IS_TYPE(var, LINT))
+#define __IS_UNSIGNED(var) (__IS_TYPE(var, USINT) || __IS_TYPE(var, UINT) || __IS_TYPE(var, UDINT) || __IS_TYPE(var, ULINT) || \
+                            __IS_TYPE(var, BYTE) || __IS_TYPE(var, WORD) || __IS_TYPE(var, DWORD) || __IS_TYPE(var, LWORD) || \
+                            __IS_TYPE(var, BOOL))
+#define __IS_FLOAT(var)    (__IS_TYPE(var, REAL) || __IS_TYPE(var, LREAL))
+
+/* Sets a located variable from the text of a value. Returns -1 on error. */
+static int set_value(located_t *var, const char *text) {
+  char *end;
+  if (__IS_FLOAT(var)) {
+    double d = strtod(text, &end);
+    if (*end != '\0') return -1;
+    if (__IS_TYPE(var, REAL)) *(REAL *)var->value = (REAL)d;
+    else                      *(LREAL *)var->value = (LREAL)d;
+    return 0;
+  }
+  if (__IS_SIGNED(var) || __IS_UNSIGNED(var)) {
+    long long i;
+    if      (strcasecmp(text, "TRUE") == 0)  i = 1;
+    else if (strcasecmp(text, "FALSE") == 0) i = 0;
+    else {
+      i = (long long)strtoull(text, &end, 0);
+      if (*end != '\0') return -1;
+    }
+    if (__IS_TYPE(var, BOOL)) i = (i != 0);
+    /* little or big endian: copy the value through a variable of the right size */
+    switch (var->size) {
+      case 1: {uint8_t  v = (uint8_t) i; memcpy(var->value, &v, 1); return 0;}
+      case 2: {uint16_t v = (uint16_t)i; memcpy(var->value, &v, 2); return 0;}
+      case 4: {uint32_t v = (uint32_t)i; memcpy(var->value, &v, 4); return 0;}
+      case 8: {uint64_t v = (uint64_t)i; memcpy(var->value, &v, 8); return 0;}
+    }
+  }
+  return -1;  /* TIME, STRING, ... */
+}
+
+static void print_value(FILE *f, located_t *var) {
+  if      (__IS_TYPE(var, REAL))  fprintf(f, "%.9g",  (double)*(REAL *)var->value);
+  else if (__IS_TYPE(var, LREAL)) fprintf(f, "%.17g", (double)*(LREAL *)var->value);
+  else if (__IS_SIGNED(var) || __IS_UNSIGNED(var)) {
+    uint64_t u = 0; int64_t s = 0;
+    switch (var->size) {
+      case 1: u = *(uint8_t  *)var->value; s = *(int8_t  *)var->value; break;
+      case 2: u = *(uint16_t *)var->value; s = *(int16_t *)var->value; break;
+      case 4: u = *(uint32_t *)var->value; s = *(int32_t *)var->value; break;
+      case 8: u = *(uint64_t *)var->value; s = *(int64_t *)var->value; break;
+    }
+    if (__IS_SIGNED(var)) fprintf(f, "%lld", (long long)s);
+    else                  fprintf(f, "%llu", (unsigned long long)u);
+  }
+  else fprintf(f, "?");
+}
+
+
+/* Reads the input script. Returns the number of changes, or -1 on error. */
+static int read_script(const char *filename, event_t **events) {
+  FILE *f = fopen(filename, "r");
+  char line[256], time[64], location[64], value[64];
+  int count = 0, allocated = 0, line_no = 0;
+  unsigned long long last = 0;
+
+  if (f == NULL) {
+    perror(filename);
+    return -1;
+  }
+  *events = NULL;
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char *comment = strchr(line, '#');
+    line_no++;
+    /* a '#' starts a comment, unless it is part of a T# */
+    while (comment != NULL && comment > line && isalpha((unsigned char)comment[-1]))
+      comment = strchr(comment + 1, '#');
+    if (comment != NULL) *comment = '\0';
+    if (sscanf(line, "%63s", time) != 1)
+      continue;
+    if (sscanf(line, "%63s %63s %63s", time, location, value) != 3) {
+      fprintf(stderr, "%s:%d: expected <time> <location> <value>\n", filename, line_no);
+      return -1;
+    }
+    if (count == allocated) {
+      allocated = allocated? 2 * allocated : 64;
+      *events = realloc(*events, allocated * sizeof(event_t));
+      if (*events == NULL) {fprintf(stderr, "out of memory\n"); return -1;}
+    }
+    event_t *e = &(*events)[count];
+    e->line = line_no;
+    if (parse_duration(time, &e->time) < 0) {
+      fprintf(stderr, "%s:%d: invalid time %s\n", filename, line_no, time);
+      return -1;
+    }
+    if (e->time < last) {
+      fprintf(stderr, "%s:%d: the lines must be in order of time\n", filename, line_no);
+      return -1;
+    }
+    last = e->time;
+    if ((e->var = find_location(location)) == NULL) {
+      fprintf(stderr, "%s:%d: %s is not a located variable of the program\n", filename, line_no, location);
+      return -1;
+    }
+    strcpy(e->value, value);
+    count++;
+  }
+  fclose(f);
+  return count;
+}
+
+
+static void print_time(FILE *f, unsigned long long ns) {
+  fprintf(f, "%llu.%09llu", ns / 1000000000ULL, ns % 1000000000ULL);
+}
+
+static double wall_time(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+int main(int argc, char **argv) {
+  const char *script = NULL, *output = NULL;
+  unsigned long long duration = 0, now = 0;
+  int has_duration = 0, record_all = 0, record_memory = 0;
+  event_t *events = NULL;
+  int events_count = 0, next_event = 0, opt;
+  unsigned long tick = 0;
+  located_t *var;
+  FILE *out = stdout;
+  double start;
+
+  while ((opt = getopt(argc, argv, "s:o:t:am")) != -1) {
+    switch (opt) {
+      case 's': script = optarg; break;
+      case 'o': output = optarg; break;
+      case 't':
+        if (parse_duration(optarg, &duration) < 0) {
+          fprintf(stderr, "invalid duration %s\n", optarg);
+          return 1;
+        }
+        has_duration = 1;
+        break;
+      case 'a': record_all = 1; break;
+      case 'm': record_memory = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-s <input_script>] [-o <output_file>] [-t <duration>] [-a] [-m]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  for (var = located; var->type != NULL; var++)
+    location_name(var);
+  if (script != NULL && (events_count = read_script(script, &events)) < 0)
+    return 1;
+  if (!has_duration) {
+    if (events_count == 0) {
+      fprintf(stderr, "%s: give the duration of the simulation (-t), or an input script (-s)\n", argv[0]);
+      return 1;
+    }
+    duration = events[events_count - 1].time;
+  }
+  if (common_ticktime__ == 0) {
+    /* the simulated time would never advance */
+    fprintf(stderr, "%s: the configuration has no cyclic task (common_ticktime__ is 0)\n", argv[0]);
+    return 1;
+  }
+  if (output != NULL && (out = fopen(output, "w")) == NULL) {
+    perror(output);
+    return 1;
+  }
+
+  start = wall_time();
+  __CURRENT_TIME.tv_sec = 0;
+  __CURRENT_TIME.tv_nsec = 0;
+  config_init__();
+  /* the values before the first scan are not recorded: record only what the program changes */
+  for (var = located; var->type != NULL; var++)
+    memcpy(var->last, var->value, var->size <= sizeof(var->last)? var->size : sizeof(var->last));
+
+  while (now <= duration) {
+    for (; next_event < events_count && events[next_event].time <= now; next_event++)
+      if (set_value(events[next_event].var, events[next_event].value) < 0) {
+        fprintf(stderr, "%s:%d: invalid value %s for %s (%s)\n", script, events[next_event].line,
+                events[next_event].value, events[next_event].var->location, events[next_event].var->type);
+        return 1;
+      }
+
+    config_run__(tick);
+
+    for (var = located; var->type != NULL; var++) {
+      size_t size = (var->size <= sizeof(var->last))? var->size : sizeof(var->last);
+      if (var->location[1] != 'Q' && !(record_memory && var->location[1] == 'M'))
+        continue;
+      if (!record_all && memcmp(var->last, var->value, size) == 0)
+        continue;
+      memcpy(var->last, var->value, size);
+      print_time(out, now);
+      fprintf(out, " %s ", var->location);
+      print_value(out, var);
+      fprintf(out, "\n");
+    }
+
+    tick++;
+    now += common_ticktime__;
+    __CURRENT_TIME.tv_sec  = now / 1000000000ULL;
+    __CURRENT_TIME.tv_nsec = now % 1000000000ULL;
+  }
+
+  if (out != stdout)
+    fclose(out);
+  fprintf(stderr, "%lu scans, ", tick);
+  print_time(stderr, now);
+  fprintf(stderr, " s of PLC time in %.3f s\n", wall_time() - start);
+  free(events);
+  return 0;
+}
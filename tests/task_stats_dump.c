@@ -0,0 +1,61 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ *
+ *
+ * Prints the task statistics of a running PLC, compiled with 'iec2c -O task-stats',
+ * whose runtime shares them with __IEC_task_stats_share() (see lib/iec_task_stats.h).
+ *
+ * usage: task_stats_dump [SHARED_MEMORY_NAME] [INTERVAL_S]
+ *   prints the statistics once, or every INTERVAL_S seconds.
+ *
+ * build: gcc -I ../lib -o task_stats_dump task_stats_dump.c -lrt
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define __IEC_TASK_STATS_SHM
+#include "iec_task_stats.h"
+
+/* not used by the reader, but declared by iec_task_stats.h */
+__IEC_task_stats_block_t *__IEC_task_stats = NULL;
+
+int main(int argc, char **argv) {
+  const char *name = (argc > 1)? argv[1] : "/matiec_task_stats";
+  int interval = (argc > 2)? atoi(argv[2]) : 0;
+  const __IEC_task_stats_block_t *block = __IEC_task_stats_attach(name);
+
+  if (block == NULL) {
+    perror(name);
+    return 1;
+  }
+  do {
+    __IEC_task_stats_print(stdout, block);
+    fflush(stdout);
+    if (interval > 0) {
+      sleep(interval);
+      printf("\n");
+    }
+  } while (interval > 0);
+  return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+/*
+ *  Time report. See time_report.hh for a description.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <iterator>
+
+#include "time_report.hh"
+#include "absyntax_utils/absyntax_utils.hh"
+#include "main.hh"
+
+
+typedef struct {
+  const char *name;
+  int         depth;
+  double      wall, cpu;   /* s */
+  long        peak_rss;    /* kB, at the end of the phase */
+} phase_t;
+
+static time_report_format_t format = time_report_none;
+static std::vector<phase_t> phases;
+static std::vector<unsigned int> open_phases;  /* indices in phases[], innermost last */
+
+
+static double wall_time(void) {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+static double cpu_time(void) {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec * 1e-6 + ru.ru_stime.tv_sec + ru.ru_stime.tv_usec * 1e-6;
+}
+
+static long peak_rss(void) {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+  return ru.ru_maxrss / 1024;  /* in bytes */
+#else
+  return ru.ru_maxrss;         /* in kB */
+#endif
+}
+
+
+int time_report_enable(const char *format_name) {
+  if ((NULL == format_name) || (strcmp(format_name, "text") == 0)) {format = time_report_text; return 0;}
+  if (strcmp(format_name, "json") == 0)                            {format = time_report_json; return 0;}
+  return -1;
+}
+
+
+void time_report_begin(const char *phase) {
+  if (time_report_none == format) return;
+  phase_t p = {phase, (int)open_phases.size(), 0, 0, 0};
+  open_phases.push_back(phases.size());
+  /* the phase starts after its record has been allocated */
+  p.wall = wall_time();
+  p.cpu  = cpu_time();
+  phases.push_back(p);
+}
+
+
+void time_report_end(void) {
+  if (time_report_none == format) return;
+  if (open_phases.empty()) ERROR;
+  phase_t &p = phases[open_phases.back()];
+  open_phases.pop_back();
+  p.wall     = wall_time() - p.wall;
+  p.cpu      = cpu_time()  - p.cpu;
+  p.peak_rss = peak_rss();
+}
+
+
+
+template<typename symtable_t>
+static unsigned long symtable_size(symtable_t &symtable) {
+  return std::distance(symtable.begin(), symtable.end());
+}
+
+
+void time_report_print(symbol_c *tree_root) {
+  std::map<std::string, unsigned long> ast_count;
+  std::map<std::string, unsigned long>::iterator i;
+  unsigned long ast_total = 0;
+
+  if (time_report_none == format) return;
+  /* phases left open by an error */
+  while (!open_phases.empty())
+    time_report_end();
+
+  if (NULL != tree_root)
+    debug_c::count_ast(tree_root, ast_count);
+  for (i = ast_count.begin(); i != ast_count.end(); i++)
+    ast_total += i->second;
+
+  struct {const char *name; unsigned long size;} symtables[] = {
+    {"function_symtable",            symtable_size(function_symtable)},
+    {"function_block_type_symtable", symtable_size(function_block_type_symtable)},
+    {"program_type_symtable",        symtable_size(program_type_symtable)},
+    {"type_symtable",                symtable_size(type_symtable)}
+  };
+  const unsigned int symtables_count = sizeof(symtables) / sizeof(symtables[0]);
+
+  if (time_report_json == format) {
+    fprintf(stderr, "{\n  \"phases\": [");
+    for (unsigned int p = 0; p < phases.size(); p++)
+      fprintf(stderr, "%s\n    {\"name\": \"%s\", \"depth\": %d, \"wall_s\": %.6f, \"cpu_s\": %.6f, \"peak_rss_kb\": %ld}",
+              (p > 0)? "," : "", phases[p].name, phases[p].depth, phases[p].wall, phases[p].cpu, phases[p].peak_rss);
+    fprintf(stderr, "\n  ],\n  \"ast\": {\"total\": %lu, \"classes\": {", ast_total);
+    for (i = ast_count.begin(); i != ast_count.end(); i++)
+      fprintf(stderr, "%s\n    \"%s\": %lu", (i != ast_count.begin())? "," : "", i->first.c_str(), i->second);
+    fprintf(stderr, "\n  }},\n  \"symtables\": {");
+    for (unsigned int s = 0; s < symtables_count; s++)
+      fprintf(stderr, "%s\n    \"%s\": %lu", (s > 0)? "," : "", symtables[s].name, symtables[s].size);
+    fprintf(stderr, "\n  }\n}\n");
+    return;
+  }
+
+  fprintf(stderr, "\nTime report\n");
+  fprintf(stderr, "  %-36s %12s %12s %14s\n", "phase", "wall (ms)", "cpu (ms)", "peak rss (kB)");
+  for (unsigned int p = 0; p < phases.size(); p++)
+    fprintf(stderr, "  %*s%-*s %12.3f %12.3f %14ld\n", 2 * phases[p].depth, "", 36 - 2 * phases[p].depth,
+            phases[p].name, phases[p].wall * 1e3, phases[p].cpu * 1e3, phases[p].peak_rss);
+
+  fprintf(stderr, "\n  %-36s %12s\n", "AST symbols", "count");
+  /* the largest counts first */
+  std::multimap<unsigned long, std::string> sorted;
+  for (i = ast_count.begin(); i != ast_count.end(); i++)
+    sorted.insert(std::make_pair(i->second, i->first));
+  for (std::multimap<unsigned long, std::string>::reverse_iterator j = sorted.rbegin(); j != sorted.rend(); j++)
+    fprintf(stderr, "  %-36s %12lu\n", j->second.c_str(), j->first);
+  fprintf(stderr, "  %-36s %12lu\n", "(total)", ast_total);
+
+  fprintf(stderr, "\n  %-36s %12s\n", "symbol table", "entries");
+  for (unsigned int s = 0; s < symtables_count; s++)
+    fprintf(stderr, "  %-36s %12lu\n", symtables[s].name, symtables[s].size);
+  fprintf(stderr, "\n");
+}
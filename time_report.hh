@@ -0,0 +1,76 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2012  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ *  Time report (the --time-report command line option).
+ *
+ *  Measures the wall clock time, the CPU time and the peak memory use (resident
+ *  set size) of each phase of the compiler, i.e. of each stage and of each of the
+ *  passes of stage 3, and prints them on stderr once the compilation is over,
+ *  along with the number of symbols of the abstract syntax tree (by class) and
+ *  the size of the symbol tables.
+ *
+ *  The phases may be nested:
+ *      time_report_begin("stage3");
+ *        time_report_begin("type_safety");
+ *        ...
+ *        time_report_end();
+ *      time_report_end();
+ *  The time of a phase includes the time of the phases nested in it.
+ *  When the report is disabled (the default), these do nothing.
+ */
+
+
+#ifndef _TIME_REPORT_HH
+#define _TIME_REPORT_HH
+
+#include "absyntax/absyntax.hh"
+
+
+typedef enum {
+  time_report_none,   /* no report (default) */
+  time_report_text,   /* a table, for humans */
+  time_report_json    /* a JSON object, for scripts (e.g. to track trends in continuous integration) */
+} time_report_format_t;
+
+/* Returns -1 if the format (NULL, "text" or "json") is not known. */
+int  time_report_enable(const char *format);
+
+void time_report_begin(const char *phase);
+void time_report_end(void);
+
+/* Prints the report, counting the symbols of the AST from tree_root (may be NULL). */
+void time_report_print(symbol_c *tree_root);
+
+
+#endif /* _TIME_REPORT_HH */